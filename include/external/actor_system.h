@@ -21,6 +21,10 @@ namespace eventstream {
 class EventStream;
 }
 
+namespace scheduler {
+class TimerWheel;
+}
+
 /**
  * @brief ActorSystem is the runtime environment that hosts actors and manages their
  * execution, supervision, and system-wide services.
@@ -64,6 +68,18 @@ public:
      */
     std::shared_ptr<Extensions> GetExtensions() const;
     
+    /**
+     * @brief Get the shared timer wheel (used for receive timeouts).
+     * @return Timer wheel
+     */
+    std::shared_ptr<scheduler::TimerWheel> GetTimerWheel() const;
+    
+    /**
+     * @brief Get the configuration the system was created with.
+     * @return Config
+     */
+    std::shared_ptr<Config> GetConfig() const;
+    
     /**
      * @brief Get the system ID.
      * @return System ID
@@ -101,6 +117,7 @@ private:
     std::shared_ptr<Guardians> guardians_;
     std::shared_ptr<DeadLetterProcess> dead_letter_;
     std::shared_ptr<Extensions> extensions_;
+    std::shared_ptr<scheduler::TimerWheel> timer_wheel_;
     std::shared_ptr<Config> config_;
     std::string id_;
     std::atomic<bool> stopped_;
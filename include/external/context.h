@@ -4,6 +4,7 @@
 #include "pid.h"
 #include "actor.h"
 #include "future.h"
+#include "scatter_gather.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -109,6 +110,20 @@ public:
      */
     virtual std::shared_ptr<Future> RequestFuture(std::shared_ptr<PID> pid, std::shared_ptr<void> message, std::chrono::milliseconds timeout) = 0;
     
+    /**
+     * @brief Send one request to a set of PIDs and aggregate the responses in a single Future.
+     * Uses one timer and one correlation table for all targets. The Future resolves with a
+     * ScatterGatherResult (partial on timeout) and error timed_out / no_such_process when the
+     * policy was not met.
+     * @param pids Target PIDs
+     * @param message The message to send
+     * @param timeout Timeout for the whole request
+     * @param mode Completion policy (all / first / quorum)
+     * @param quorum Required responses for GatherMode::Quorum (<= 0 means majority)
+     * @return Aggregate Future
+     */
+    virtual std::shared_ptr<Future> RequestScatterGather(const std::vector<std::shared_ptr<PID>>& pids, std::shared_ptr<void> message, std::chrono::milliseconds timeout, GatherMode mode, int quorum) = 0;
+    
     // Base part
     /**
      * @brief Get the receive timeout duration.
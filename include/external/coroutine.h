@@ -0,0 +1,186 @@
+#ifndef PROTOACTOR_COROUTINE_H
+#define PROTOACTOR_COROUTINE_H
+
+#include "context.h"
+#include "future.h"
+#include "pid.h"
+#include <memory>
+#include <chrono>
+#include <system_error>
+#include <utility>
+
+// The coroutine layer is header-only and optional: it is available to any translation
+// unit compiled as C++20 (the library itself still builds as C++17).
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#include <exception>
+#include <iostream>
+#define PROTOACTOR_HAS_COROUTINES 1
+#else
+#define PROTOACTOR_HAS_COROUTINES 0
+#endif
+
+#if PROTOACTOR_HAS_COROUTINES
+
+namespace protoactor {
+namespace coro {
+
+/**
+ * @brief Result of an awaited future: the resolved value and error code.
+ */
+using Result = std::pair<std::shared_ptr<void>, std::error_code>;
+
+/**
+ * @brief Fire-and-forget coroutine type for actor message handlers.
+ *
+ * A Task starts running immediately when called from Actor::Receive and runs until its
+ * first co_await. Take the Context by value so it stays valid across suspension points.
+ * Exceptions escaping the coroutine are reported like dispatcher task exceptions.
+ */
+class Task {
+public:
+    struct promise_type {
+        Task get_return_object() noexcept { return Task(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {
+            try {
+                std::rethrow_exception(std::current_exception());
+            } catch (const std::exception& e) {
+                std::cerr << "Coroutine task exception: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "Coroutine task unknown exception" << std::endl;
+            }
+        }
+    };
+};
+
+namespace detail {
+
+/**
+ * @brief Shared state between a suspended coroutine and the continuation that resumes it.
+ * If the continuation is dropped without running (e.g. the actor stopped before the
+ * continuation was delivered), the suspended frame is destroyed instead of leaked.
+ */
+struct ResumeState {
+    std::coroutine_handle<> handle;
+    Result result;
+    bool resumed = false;
+
+    ~ResumeState() {
+        if (!resumed && handle) {
+            handle.destroy();
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Awaiter for a Future.
+ *
+ * With a context, resumption goes through Context::ReenterAfter: the coroutine continues on
+ * the actor's own mailbox with the original message restored, and the actor keeps
+ * processing other messages while suspended. Without a context the coroutine resumes on
+ * the thread that resolves the future.
+ */
+class FutureAwaiter {
+public:
+    FutureAwaiter(std::shared_ptr<Context> context, std::shared_ptr<Future> future)
+        : context_(std::move(context)), future_(std::move(future)), state_(nullptr) {}
+
+    bool await_ready() const noexcept {
+        return !future_;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        auto state = std::make_shared<detail::ResumeState>();
+        state->handle = handle;
+        // The continuation owns the state; it is alive for the whole resume call
+        state_ = state.get();
+        auto continuation = [state](std::shared_ptr<void> res, std::error_code err) {
+            state->result = Result(std::move(res), err);
+            state->resumed = true;
+            state->handle.resume();
+        };
+        if (context_) {
+            context_->ReenterAfter(future_, continuation);
+        } else {
+            future_->ContinueWith(continuation);
+        }
+    }
+
+    Result await_resume() {
+        if (!state_) {
+            return Result(nullptr, std::make_error_code(std::errc::invalid_argument));
+        }
+        return std::move(state_->result);
+    }
+
+private:
+    std::shared_ptr<Context> context_;
+    std::shared_ptr<Future> future_;
+    detail::ResumeState* state_;
+};
+
+/**
+ * @brief Awaiter that casts the resolved value to the expected response type.
+ */
+template <typename T>
+class TypedFutureAwaiter : public FutureAwaiter {
+public:
+    using FutureAwaiter::FutureAwaiter;
+
+    std::pair<std::shared_ptr<T>, std::error_code> await_resume() {
+        auto [res, err] = FutureAwaiter::await_resume();
+        return {std::static_pointer_cast<T>(res), err};
+    }
+};
+
+/**
+ * @brief Await a future from inside an actor, reentering on the actor's mailbox.
+ * @param context Actor context (take it by value in the coroutine)
+ * @param future The future to await
+ * @return Awaiter yielding (result, error)
+ */
+inline FutureAwaiter Await(std::shared_ptr<Context> context, std::shared_ptr<Future> future) {
+    return FutureAwaiter(std::move(context), std::move(future));
+}
+
+/**
+ * @brief Send a request and suspend the handler until the response arrives.
+ *
+ * Equivalent to RequestFuture followed by ReenterAfter, without the callback.
+ * @tparam T Expected response type
+ * @param context Actor context
+ * @param pid Target PID
+ * @param message The request message
+ * @param timeout Timeout duration
+ * @return Awaiter yielding (response, error); error is timed_out on timeout
+ */
+template <typename T = void>
+TypedFutureAwaiter<T> RequestAsync(
+    std::shared_ptr<Context> context,
+    std::shared_ptr<PID> pid,
+    std::shared_ptr<void> message,
+    std::chrono::milliseconds timeout) {
+    auto future = context->RequestFuture(std::move(pid), std::move(message), timeout);
+    return TypedFutureAwaiter<T>(std::move(context), std::move(future));
+}
+
+} // namespace coro
+
+/**
+ * @brief Await a future outside of an actor (e.g. from a root-level coroutine).
+ * The coroutine resumes on the thread that resolves the future.
+ */
+inline coro::FutureAwaiter operator co_await(std::shared_ptr<Future> future) {
+    return coro::FutureAwaiter(nullptr, std::move(future));
+}
+
+} // namespace protoactor
+
+#endif // PROTOACTOR_HAS_COROUTINES
+
+#endif // PROTOACTOR_COROUTINE_H
@@ -6,12 +6,26 @@
 #include <functional>
 #include <atomic>
 #include <mutex>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
 
 namespace protoactor {
+
+class Dispatcher;
+
 namespace eventstream {
 
 // Forward declarations
 class Subscription;
+struct AsyncDelivery;
+
+/**
+ * @brief Default queue capacity of an asynchronous subscription.
+ */
+constexpr std::size_t DEFAULT_ASYNC_CAPACITY = 1024;
 
 /**
  * @brief Handler function type for event callbacks.
@@ -25,6 +39,17 @@ using Predicate = std::function<bool(std::shared_ptr<void>)>;
 
 /**
  * @brief EventStream is a threadsafe publish-subscribe message bus.
+ *
+ * Subscribers are kept in an immutable snapshot that is swapped atomically on
+ * subscribe/unsubscribe (copy-on-write). Publish loads a raw pointer to it between two
+ * updates of a reader count, so it takes no lock and does not allocate; replaced snapshots
+ * are freed by a later writer once no publisher is inside one.
+ * Subscribers registered with Subscribe<T> are indexed by event type and only see events
+ * published with that exact static type; untyped subscribers see every event.
+ *
+ * Handlers run on the publisher's thread unless subscribed with SubscribeAsync, in which
+ * case events go through a bounded per-subscriber queue drained on a dispatcher; when the
+ * queue is full the event is dropped for that subscriber and counted (Subscription::Dropped).
  */
 class EventStream {
 public:
@@ -41,6 +66,49 @@ public:
      */
     std::shared_ptr<Subscription> Subscribe(Handler handler);
     
+    /**
+     * @brief Subscribe to events of type T only.
+     * Only Publish calls with a std::shared_ptr<T> reach the handler.
+     * @param handler Typed event handler
+     * @return Subscription
+     */
+    template <typename T>
+    std::shared_ptr<Subscription> Subscribe(std::function<void(std::shared_ptr<T>)> handler) {
+        return SubscribeType(std::type_index(typeid(T)),
+            [handler](std::shared_ptr<void> evt) { handler(std::static_pointer_cast<T>(evt)); },
+            nullptr);
+    }
+    
+    /**
+     * @brief Subscribe with asynchronous delivery.
+     * Publish only enqueues (never blocks); the handler runs on the dispatcher.
+     * @param handler Event handler
+     * @param dispatcher Dispatcher draining the queue (nullptr = default dispatcher)
+     * @param capacity Queue capacity (rounded up to a power of two)
+     * @return Subscription
+     */
+    std::shared_ptr<Subscription> SubscribeAsync(
+        Handler handler,
+        std::shared_ptr<Dispatcher> dispatcher = nullptr,
+        std::size_t capacity = DEFAULT_ASYNC_CAPACITY);
+    
+    /**
+     * @brief Subscribe to events of type T with asynchronous delivery.
+     * @param handler Typed event handler
+     * @param dispatcher Dispatcher draining the queue (nullptr = default dispatcher)
+     * @param capacity Queue capacity (rounded up to a power of two)
+     * @return Subscription
+     */
+    template <typename T>
+    std::shared_ptr<Subscription> SubscribeAsync(
+        std::function<void(std::shared_ptr<T>)> handler,
+        std::shared_ptr<Dispatcher> dispatcher = nullptr,
+        std::size_t capacity = DEFAULT_ASYNC_CAPACITY) {
+        return SubscribeTypeAsync(std::type_index(typeid(T)),
+            [handler](std::shared_ptr<void> evt) { handler(std::static_pointer_cast<T>(evt)); },
+            std::move(dispatcher), capacity);
+    }
+    
     /**
      * @brief Subscribe with a predicate filter.
      * @param handler Event handler
@@ -56,11 +124,20 @@ public:
     void Unsubscribe(std::shared_ptr<Subscription> subscription);
     
     /**
-     * @brief Publish an event to all subscribers.
+     * @brief Publish an event to all untyped subscribers.
      * @param evt The event
      */
     void Publish(std::shared_ptr<void> evt);
     
+    /**
+     * @brief Publish an event to untyped subscribers and to subscribers of type T.
+     * @param evt The event
+     */
+    template <typename T>
+    void Publish(std::shared_ptr<T> evt) {
+        PublishType(&typeid(T), std::static_pointer_cast<void>(std::move(evt)));
+    }
+    
     /**
      * @brief Get the number of subscribers.
      * @return Subscriber count
@@ -68,9 +145,28 @@ public:
     int32_t Length() const;
 
 private:
-    mutable std::mutex mutex_;
-    std::vector<std::shared_ptr<Subscription>> subscriptions_;
-    std::atomic<int32_t> counter_;
+    using SubscriptionList = std::vector<std::shared_ptr<Subscription>>;
+    
+    // Immutable once published; replaced as a whole under mutex_
+    struct Snapshot {
+        SubscriptionList untyped;
+        std::unordered_map<std::type_index, SubscriptionList> typed;
+        int32_t count = 0;
+    };
+    
+    mutable std::mutex mutex_;  // Serializes writers only
+    std::unique_ptr<const Snapshot> current_;               // Owns the published snapshot
+    std::atomic<const Snapshot*> snapshot_;
+    mutable std::atomic<int32_t> readers_;                  // Publishers inside a snapshot
+    std::vector<std::unique_ptr<const Snapshot>> retired_;  // Replaced, possibly still read
+    int32_t next_id_;
+    
+    std::shared_ptr<Subscription> SubscribeType(std::type_index type, Handler handler, Predicate predicate);
+    std::shared_ptr<Subscription> SubscribeTypeAsync(
+        std::type_index type, Handler handler, std::shared_ptr<Dispatcher> dispatcher, std::size_t capacity);
+    std::shared_ptr<Subscription> Add(const std::type_index* type, std::shared_ptr<Subscription> sub);
+    void PublishType(const std::type_info* type, std::shared_ptr<void> evt);
+    void Replace(std::unique_ptr<const Snapshot> next);
     
 public:
     EventStream();
@@ -79,7 +175,7 @@ public:
 /**
  * @brief Subscription represents a registered handler and its state.
  */
-class Subscription {
+class Subscription : public std::enable_shared_from_this<Subscription> {
 public:
     /**
      * @brief Activate the subscription.
@@ -99,6 +195,18 @@ public:
      */
     bool IsActive() const;
     
+    /**
+     * @brief Check if the subscription delivers asynchronously.
+     * @return true if subscribed with SubscribeAsync
+     */
+    bool IsAsync() const;
+    
+    /**
+     * @brief Number of events dropped because the subscriber queue was full.
+     * @return Dropped event count (always 0 for synchronous subscriptions)
+     */
+    uint64_t Dropped() const;
+    
     friend class EventStream;
 
 private:
@@ -106,9 +214,13 @@ private:
     Handler handler_;
     Predicate predicate_;
     mutable std::atomic<uint32_t> active_;
+    std::shared_ptr<AsyncDelivery> async_;  // Set for asynchronous subscriptions
+    
+    void Deliver(const std::shared_ptr<void>& evt) const;
+    void Drain() const;
     
 public:
-    explicit Subscription(Handler handler);
+    explicit Subscription(Handler handler, Predicate predicate = nullptr);
 };
 
 } // namespace eventstream
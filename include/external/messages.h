@@ -163,6 +163,8 @@ struct Failure : public SystemMessage {
 struct Continuation : public SystemMessage {
     std::function<void(std::shared_ptr<void>, std::error_code)> continuation;
     std::shared_ptr<void> message;
+    std::shared_ptr<void> result; // Resolved value of the awaited future
+    std::error_code err;          // Error of the awaited future, if any
     
     Continuation(
         std::function<void(std::shared_ptr<void>, std::error_code)> cont,
@@ -171,6 +173,13 @@ struct Continuation : public SystemMessage {
     }
 };
 
+/**
+ * @brief System message that the receiving actor handles in Receive, ahead of its queued
+ * user messages. Dropped unless the actor is alive.
+ */
+struct PriorityMessage : public SystemMessage {
+};
+
 /**
  * @brief Helper functions for message handling.
  */
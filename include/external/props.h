@@ -92,6 +92,7 @@ public:
     std::shared_ptr<SupervisorStrategy> GetSupervisor() const;
     std::shared_ptr<Mailbox> ProduceMailbox() const;
     ProducerWithActorSystem GetProducer() const;
+    std::vector<ReceiverMiddleware> GetReceiverMiddleware() const;
     
     // Setters (via Configure)
     std::shared_ptr<Props> WithSpawner(SpawnFunc spawner);
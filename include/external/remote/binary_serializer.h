@@ -0,0 +1,373 @@
+#ifndef PROTOACTOR_REMOTE_BINARY_SERIALIZER_H
+#define PROTOACTOR_REMOTE_BINARY_SERIALIZER_H
+
+#include "internal/remote/serializer.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace protoactor {
+namespace remote {
+
+/**
+ * @brief True for structs marked with PROTOACTOR_BINARY_RAW.
+ */
+template <typename T, typename = void>
+struct IsBinaryRaw : std::false_type {};
+
+template <typename T>
+struct IsBinaryRaw<T, std::void_t<typename T::BinaryRawLayout>> : std::true_type {};
+
+/**
+ * @brief Types copied as raw bytes: every byte is part of the value and every byte pattern
+ * a peer sends is a valid value. That holds for arithmetic types other than bool, and is
+ * what PROTOACTOR_BINARY_RAW promises for a struct.
+ */
+template <typename T>
+constexpr bool kBinaryRawCopy = (std::is_arithmetic<T>::value && !std::is_same<T, bool>::value) ||
+                                (IsBinaryRaw<T>::value && std::is_trivially_copyable<T>::value);
+
+/**
+ * @brief Appends binary field encodings to a buffer.
+ *
+ * Numbers and PROTOACTOR_BINARY_RAW structs are copied as raw bytes (native byte order and
+ * layout, so both ends must run the same build); bool is one byte and scoped enums travel as
+ * their underlying type. Strings and vectors are a varint length followed by their elements, with a
+ * single copy for vectors of raw elements. Pointers cannot be fields.
+ */
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::string* out) : out_(out) {}
+
+    void WriteVarint(uint64_t value) {
+        while (value >= 0x80) {
+            out_->push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out_->push_back(static_cast<char>(value));
+    }
+
+    void WriteBytes(const void* data, std::size_t size) {
+        out_->append(static_cast<const char*>(data), size);
+    }
+
+    template <typename T>
+    void Write(const T& value) {
+        if constexpr (std::is_enum<T>::value) {
+            Write(static_cast<std::underlying_type_t<T>>(value));
+        } else {
+            static_assert(kBinaryRawCopy<T>,
+                          "binary fields must be numbers, bool, enums, PROTOACTOR_BINARY_RAW structs, "
+                          "std::string or std::vector");
+            WriteBytes(&value, sizeof(T));
+        }
+    }
+
+    void Write(bool value) {
+        out_->push_back(value ? 1 : 0);
+    }
+
+    void Write(const std::string& value) {
+        WriteVarint(value.size());
+        WriteBytes(value.data(), value.size());
+    }
+
+    template <typename T, typename A>
+    void Write(const std::vector<T, A>& values) {
+        WriteVarint(values.size());
+        if constexpr (kBinaryRawCopy<T>) {
+            WriteBytes(values.data(), values.size() * sizeof(T));
+        } else {
+            for (const auto& value : values) {
+                Write(value);
+            }
+        }
+    }
+
+private:
+    std::string* out_;
+};
+
+/**
+ * @brief Reads what BinaryWriter wrote. Throws std::runtime_error on truncated or invalid input.
+ */
+class BinaryReader {
+public:
+    explicit BinaryReader(std::string_view in) : in_(in), pos_(0) {}
+
+    uint64_t ReadVarint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            Require(1);
+            auto byte = static_cast<uint8_t>(in_[pos_++]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw std::runtime_error("BinaryReader: malformed varint");
+    }
+
+    void ReadBytes(void* data, std::size_t size) {
+        Require(size);
+        std::memcpy(data, in_.data() + pos_, size);
+        pos_ += size;
+    }
+
+    template <typename T>
+    void Read(T& value) {
+        if constexpr (std::is_enum<T>::value) {
+            // Scoped enums have a fixed underlying type, so any value of it is a valid value
+            static_assert(!std::is_convertible<T, std::underlying_type_t<T>>::value,
+                          "binary enum fields must be scoped enums (enum class)");
+            std::underlying_type_t<T> raw;
+            Read(raw);
+            value = static_cast<T>(raw);
+        } else {
+            static_assert(kBinaryRawCopy<T>,
+                          "binary fields must be numbers, bool, enums, PROTOACTOR_BINARY_RAW structs, "
+                          "std::string or std::vector");
+            ReadBytes(&value, sizeof(T));
+        }
+    }
+
+    void Read(bool& value) {
+        Require(1);
+        auto byte = static_cast<uint8_t>(in_[pos_++]);
+        if (byte > 1) {
+            throw std::runtime_error("BinaryReader: invalid bool");
+        }
+        value = byte == 1;
+    }
+
+    void Read(std::string& value) {
+        auto size = ReadLength(1);
+        value.assign(in_.data() + pos_, size);
+        pos_ += size;
+    }
+
+    template <typename T, typename A>
+    void Read(std::vector<T, A>& values) {
+        if constexpr (kBinaryRawCopy<T>) {
+            auto count = ReadLength(sizeof(T));
+            values.resize(count);
+            ReadBytes(values.data(), count * sizeof(T));
+        } else {
+            // Each element takes at least one byte, which bounds the allocation
+            auto count = ReadLength(1);
+            values.clear();
+            values.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                T value{};
+                Read(value);
+                values.push_back(std::move(value));
+            }
+        }
+    }
+
+    bool AtEnd() const { return pos_ == in_.size(); }
+
+private:
+    std::string_view in_;
+    std::size_t pos_;
+
+    void Require(std::size_t size) const {
+        if (in_.size() - pos_ < size) {
+            throw std::runtime_error("BinaryReader: truncated input");
+        }
+    }
+
+    std::size_t ReadLength(std::size_t element_size) {
+        auto count = ReadVarint();
+        if (count > (in_.size() - pos_) / element_size) {
+            throw std::runtime_error("BinaryReader: length exceeds input");
+        }
+        return static_cast<std::size_t>(count);
+    }
+};
+
+/**
+ * @brief Compact binary serializer for message structs.
+ *
+ * A message type is identified by its MAGIC constant, read from the first field like
+ * MessageEnvelope does, so registered types must start with `uint64_t magic = MAGIC`.
+ * Types list their fields with PROTOACTOR_BINARY_FIELDS; structs marked PROTOACTOR_BINARY_RAW
+ * are encoded with a single memcpy instead. Register types with
+ * PROTOACTOR_REGISTER_BINARY_MESSAGE and send them with serializer id
+ * BinarySerializer::SerializerID().
+ *
+ * @code
+ * struct Tick {
+ *     static constexpr uint64_t MAGIC = 0x5449434B00000001ULL;
+ *     uint64_t magic = MAGIC;
+ *     int64_t time;
+ *     double price;
+ *     PROTOACTOR_BINARY_RAW()
+ * };
+ * PROTOACTOR_REGISTER_BINARY_MESSAGE(Tick, "market.Tick")
+ * @endcode
+ */
+class BinarySerializer : public Serializer {
+public:
+    BinarySerializer();
+
+    /**
+     * @brief Process-wide instance.
+     */
+    static std::shared_ptr<BinarySerializer> Instance();
+
+    /**
+     * @brief Serializer id in SerializerRegistry (registers the instance on first use).
+     */
+    static int32_t SerializerID();
+
+    /**
+     * @brief Register a message type.
+     * @param type_name Wire type name
+     */
+    template <typename T>
+    void Register(const std::string& type_name) {
+        static_assert(!std::is_polymorphic<T>::value, "binary messages must not be polymorphic");
+        static_assert(std::is_same<decltype(T::MAGIC), const uint64_t>::value,
+                      "binary messages must declare static constexpr uint64_t MAGIC");
+        Codec codec;
+        codec.magic = T::MAGIC;
+        codec.type_name = type_name;
+        codec.encode = [](const void* message, BinaryWriter& writer) {
+            Encode(*static_cast<const T*>(message), writer);
+        };
+        codec.decode = [](BinaryReader& reader) -> std::shared_ptr<void> {
+            auto message = std::make_shared<T>();
+            Decode(*message, reader);
+            if (message->magic != T::MAGIC) {
+                throw std::runtime_error("BinarySerializer: magic mismatch");
+            }
+            return message;
+        };
+        Add(std::move(codec));
+    }
+
+    std::vector<uint8_t> Serialize(std::shared_ptr<void> message) override;
+    std::shared_ptr<void> Deserialize(const std::string& type_name, const std::vector<uint8_t>& bytes) override;
+    std::size_t SerializeTo(std::shared_ptr<void> message, std::string* out) override;
+    std::shared_ptr<void> DeserializeFrom(const std::string& type_name, std::string_view bytes) override;
+    std::string GetTypeName(std::shared_ptr<void> message) override;
+    const std::string& SerializeNamed(std::shared_ptr<void> message, std::string* out) override;
+    int32_t GetSerializerID() const override;
+    bool DecodesSystemMessages() const override { return false; }
+
+    /**
+     * @brief True if the message's first field matches a registered MAGIC.
+     */
+    bool IsRegistered(const std::shared_ptr<void>& message) const;
+
+private:
+    struct Codec {
+        uint64_t magic = 0;
+        std::string type_name;
+        std::function<void(const void*, BinaryWriter&)> encode;
+        std::function<std::shared_ptr<void>(BinaryReader&)> decode;
+    };
+
+    // Immutable snapshot, replaced on registration. Lookups are one acquire load of the raw
+    // pointer; codecs and every published table live as long as the serializer.
+    struct Table {
+        std::unordered_map<uint64_t, const Codec*> by_magic;
+        std::unordered_map<std::string, const Codec*> by_name;
+    };
+
+    std::atomic<const Table*> table_;
+    std::mutex register_mutex_;  // Serializes registration; guards the two vectors below
+    std::vector<std::unique_ptr<const Codec>> codecs_;
+    std::vector<std::unique_ptr<const Table>> published_;
+    std::atomic<int32_t> id_{-1};
+
+    void Add(Codec codec);
+    const Codec* Find(const std::shared_ptr<void>& message) const;
+
+    template <typename T>
+    struct Reflected {
+        template <typename U>
+        static auto Check(int) -> decltype(std::declval<U&>().VisitBinaryFields(
+            std::declval<void (*)(uint64_t&)>()), std::true_type());
+        template <typename U>
+        static std::false_type Check(...);
+        static constexpr bool value = decltype(Check<T>(0))::value;
+    };
+
+    template <typename T>
+    static void Encode(const T& message, BinaryWriter& writer) {
+        if constexpr (Reflected<T>::value) {
+            writer.Write(message.magic);
+            message.VisitBinaryFields([&writer](const auto&... fields) {
+                (writer.Write(fields), ...);
+            });
+        } else {
+            static_assert(kBinaryRawCopy<T>,
+                          "binary messages must use PROTOACTOR_BINARY_FIELDS, or PROTOACTOR_BINARY_RAW "
+                          "if they are trivially copyable without padding, pointers, bool or enums");
+            writer.WriteBytes(&message, sizeof(T));
+        }
+    }
+
+    template <typename T>
+    static void Decode(T& message, BinaryReader& reader) {
+        if constexpr (Reflected<T>::value) {
+            reader.Read(message.magic);
+            message.VisitBinaryFields([&reader](auto&... fields) {
+                (reader.Read(fields), ...);
+            });
+        } else {
+            reader.ReadBytes(&message, sizeof(T));
+        }
+        if (!reader.AtEnd()) {
+            throw std::runtime_error("BinarySerializer: trailing bytes");
+        }
+    }
+};
+
+} // namespace remote
+} // namespace protoactor
+
+/**
+ * @brief Declare the serialized fields of a message struct (inside the struct body).
+ * The magic field is encoded implicitly and must not be listed.
+ */
+#define PROTOACTOR_BINARY_FIELDS(...) \
+    template <typename Visitor> \
+    void VisitBinaryFields(Visitor&& visitor) { visitor(__VA_ARGS__); } \
+    template <typename Visitor> \
+    void VisitBinaryFields(Visitor&& visitor) const { visitor(__VA_ARGS__); }
+
+/**
+ * @brief Mark a trivially copyable struct as safe to copy as raw bytes (inside the struct
+ * body). Only for structs without padding (it would carry uninitialised memory) and without
+ * pointer, bool or enum members (a peer could set them to any bit pattern).
+ */
+#define PROTOACTOR_BINARY_RAW() \
+    using BinaryRawLayout = void;
+
+#define PROTOACTOR_BINARY_CONCAT_INNER(a, b) a##b
+#define PROTOACTOR_BINARY_CONCAT(a, b) PROTOACTOR_BINARY_CONCAT_INNER(a, b)
+
+/**
+ * @brief Register a message type with the binary serializer during static initialization
+ * (at namespace scope).
+ */
+#define PROTOACTOR_REGISTER_BINARY_MESSAGE(Type, TypeName) \
+    namespace { \
+    const bool PROTOACTOR_BINARY_CONCAT(protoactor_binary_registered_, __LINE__) = \
+        (::protoactor::remote::BinarySerializer::Instance()->Register<Type>(TypeName), true); \
+    }
+
+#endif // PROTOACTOR_REMOTE_BINARY_SERIALIZER_H
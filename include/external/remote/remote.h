@@ -8,6 +8,8 @@
 #include <unordered_map>
 #include <functional>
 #include <chrono>
+#include <cstddef>
+#include <system_error>
 
 namespace protoactor {
 namespace remote {
@@ -17,11 +19,51 @@ class EndpointManager;
 class Serializer;
 class GrpcService;
 class BlockList;
+class Transport;
+class TransportService;
 
 #ifdef ENABLE_GRPC
 #include <grpcpp/grpcpp.h>
 #endif
 
+/**
+ * @brief What happens when an endpoint's outgoing queue is full.
+ *
+ * In both cases the rejected message goes to dead letters and SendMessage returns
+ * std::errc::no_buffer_space. Backpressure additionally publishes EndpointBackpressureEvent
+ * when the queue fills up and again once it has drained to half, so senders can pause.
+ */
+enum class EndpointQueuePolicy {
+    DeadLetter,
+    Backpressure
+};
+
+/**
+ * @brief Byte transport between actor systems.
+ *
+ * Grpc uses the gRPC Remoting service (requires ENABLE_GRPC). Tcp is the built-in
+ * epoll transport: length-prefixed frames carrying RemoteMessage, no extra dependencies.
+ * InProcess connects actor systems of the same process only (tests, benchmarks); frames
+ * still go through the full serialize/deserialize pipeline.
+ */
+enum class TransportKind {
+    Grpc,
+    Tcp,
+    InProcess
+};
+
+/**
+ * @brief Compression of outgoing message batches.
+ *
+ * The codec is negotiated per connection; a peer that does not support it gets
+ * uncompressed batches. Lz4 is the LZ4 block format, fast enough to pay off on
+ * batches of compressible payloads.
+ */
+enum class BatchCompression {
+    None,
+    Lz4
+};
+
 /**
  * @brief Remote configuration.
  */
@@ -30,12 +72,29 @@ public:
     std::string host;
     int port;
     std::string advertised_host;
-    int endpoint_writer_batch_size;
-    int endpoint_writer_queue_size;
+    int endpoint_writer_batch_size;                       // Upper bound of the adaptive batch size
+    std::size_t endpoint_writer_batch_bytes;              // Flush once a batch reaches this many bytes
+    std::chrono::milliseconds endpoint_writer_max_linger; // Longest a queued message waits for a flush
+    int endpoint_writer_queue_size;                       // Per-endpoint bound on queued messages (<= 0: unbounded)
+    EndpointQueuePolicy endpoint_writer_queue_policy;
+    int endpoint_writer_stripes;                          // Connections (writers) per remote address
+    int endpoint_writer_system_batch_size;                // Batch limit of the system-message lane
+    int endpoint_reader_workers;                          // Receive partitions (0: hardware threads)
+    std::size_t endpoint_reader_high_water;               // Pending inbound envelopes that pause reading (0: unbounded)
+    std::size_t endpoint_dictionary_size;                 // Per-connection type name/PID dictionary entries (0: per batch)
+    BatchCompression endpoint_compression;                // Codec offered to peers for outgoing batches
+    std::size_t endpoint_compression_threshold;           // Smaller batches are sent uncompressed
     int endpoint_manager_batch_size;
     int endpoint_manager_queue_size;
     std::unordered_map<std::string, std::shared_ptr<protoactor::Props>> kinds;
-    int max_retry_count;
+    int max_retry_count;                                  // Connection attempts before an endpoint gives up
+    std::chrono::milliseconds endpoint_connect_backoff;   // Delay before the first reconnect, doubled per attempt
+    std::chrono::milliseconds endpoint_connect_backoff_max;
+    TransportKind transport;
+    int transport_io_threads;                             // I/O threads of the Tcp transport
+    bool shared_memory_transport;                         // Use shared-memory rings for peers on this host
+    std::size_t shared_memory_ring_bytes;                 // Ring capacity per direction and connection
+    std::chrono::microseconds shared_memory_spin;         // Receive busy-poll time before sleeping
     
     Config();
     
@@ -105,8 +164,9 @@ public:
      * @param message Message
      * @param sender Sender PID
      * @param serializer_id Serializer ID
+     * @return Error code (no_buffer_space if the endpoint queue is full)
      */
-    void SendMessage(
+    std::error_code SendMessage(
         std::shared_ptr<protoactor::PID> pid,
         std::shared_ptr<ReadonlyMessageHeader> header,
         std::shared_ptr<void> message,
@@ -131,6 +191,18 @@ public:
      */
     std::shared_ptr<BlockList> GetBlockList() const;
     
+    /**
+     * @brief Get the native transport.
+     * @return Transport, or nullptr when gRPC is used
+     */
+    std::shared_ptr<Transport> GetTransport() const;
+    
+    /**
+     * @brief Get the shared-memory transport used for peers on the same host.
+     * @return Transport, or nullptr if disabled or not listening
+     */
+    std::shared_ptr<Transport> GetSharedMemoryTransport() const;
+    
     /**
      * @brief Shutdown the remote subsystem.
      * @param graceful If true, wait for running requests to finish
@@ -143,6 +215,9 @@ private:
     std::shared_ptr<EndpointManager> endpoint_manager_;
     std::shared_ptr<Serializer> serializer_;
     std::shared_ptr<BlockList> blocklist_;
+    std::shared_ptr<Transport> transport_;
+    std::shared_ptr<Transport> shm_transport_;
+    std::shared_ptr<TransportService> transport_service_;
     
 #ifdef ENABLE_GRPC
     std::shared_ptr<grpc::Server> grpc_server_;
@@ -154,6 +229,8 @@ private:
     void Initialize();
     void StartGrpcServer();
     void StopGrpcServer(bool graceful);
+    void StartTransport();
+    void StopTransport();
 };
 
 } // namespace remote
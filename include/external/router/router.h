@@ -4,10 +4,23 @@
 #include "../actor.h"
 #include "../context.h"
 #include "../pid.h"
+#include "../future.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace protoactor {
+
+class Mailbox;
+class ScatterGatherFuture;
+
 namespace router {
 
 // Forward declarations
@@ -16,6 +29,76 @@ class RouterState;
 // SenderContext is a shared_ptr to protoactor::Context
 using SenderContext = std::shared_ptr<protoactor::Context>;
 
+/**
+ * @brief Immutable value published to readers that never lock.
+ *
+ * Same scheme as the EventStream subscriber snapshot: Store swaps a raw pointer under a
+ * writer mutex, a Reader counts itself in for as long as it lives, and replaced values are
+ * freed by the first Store that finds no reader inside. (std::atomic_load on a shared_ptr
+ * would take a lock from libstdc++'s mutex pool on every read.)
+ */
+template <typename T>
+class Published {
+public:
+    /**
+     * @brief Keeps the value it was loaded with alive while in scope.
+     */
+    class Reader {
+    public:
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+        ~Reader() { readers_.fetch_sub(1); }
+        
+        const T& operator*() const { return *value_; }
+        const T* operator->() const { return value_; }
+    
+    private:
+        friend class Published;
+        explicit Reader(const Published& owner) : readers_(owner.readers_) {
+            // Sequentially consistent, paired with Store: a reader counted in after Store
+            // saw no readers is guaranteed to load the new value
+            readers_.fetch_add(1);
+            value_ = owner.value_.load();
+        }
+        
+        std::atomic<int32_t>& readers_;
+        const T* value_;
+    };
+    
+    Published() : current_(std::make_unique<const T>()), value_(current_.get()), readers_(0) {}
+    Published(const Published&) = delete;
+    Published& operator=(const Published&) = delete;
+    
+    Reader Load() const {
+        return Reader(*this);
+    }
+    
+    void Store(T value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        retired_.push_back(std::move(current_));
+        current_ = std::make_unique<const T>(std::move(value));
+        value_.store(current_.get());
+        if (readers_.load() == 0) {
+            retired_.clear();
+        }
+    }
+
+private:
+    std::mutex mutex_;  // Serializes writers only
+    std::unique_ptr<const T> current_;
+    std::atomic<const T*> value_;
+    mutable std::atomic<int32_t> readers_;
+    std::vector<std::unique_ptr<const T>> retired_;  // Replaced, possibly still read
+};
+
+/**
+ * @brief Routee list published as an immutable snapshot.
+ *
+ * SetRoutees builds a new vector and swaps it in; RouteMessage loads the current snapshot
+ * once and routes against it, so updates never race with routing.
+ */
+using RouteeSet = Published<std::vector<std::shared_ptr<PID>>>;
+
 /**
  * @brief Router interface for routing messages to multiple routees.
  */
@@ -59,7 +142,7 @@ public:
     void SetSender(SenderContext sender) override;
 
 protected:
-    std::vector<std::shared_ptr<PID>> routees_;
+    RouteeSet routees_;
     SenderContext sender_;
 };
 
@@ -75,7 +158,7 @@ public:
     void SetSender(SenderContext sender) override;
 
 protected:
-    std::vector<std::shared_ptr<PID>> routees_;
+    RouteeSet routees_;
     SenderContext sender_;
     std::atomic<int> current_index_;
 };
@@ -91,24 +174,212 @@ public:
     void SetSender(SenderContext sender) override;
 
 protected:
-    std::vector<std::shared_ptr<PID>> routees_;
+    RouteeSet routees_;
     SenderContext sender_;
 };
 
 /**
- * @brief Consistent hash router uses consistent hashing.
+ * @brief Base for routers that work on routee mailboxes directly.
+ *
+ * Routee mailboxes are resolved once per SetRoutees/SetSender and kept in the snapshot, so
+ * reading a depth (Mailbox::UserMessageCount) is a single relaxed load. Routees without a
+ * local mailbox (remote or stopped) count as fully loaded.
+ */
+class MailboxRouter : public Router {
+public:
+    void SetRoutees(const std::vector<std::shared_ptr<PID>>& routees) override;
+    std::vector<std::shared_ptr<PID>> GetRoutees() const override;
+    void SetSender(SenderContext sender) override;
+
+protected:
+    struct Routee {
+        std::shared_ptr<PID> pid;
+        std::weak_ptr<Mailbox> mailbox;
+    };
+    using Snapshot = Published<std::vector<Routee>>::Reader;
+    
+    Snapshot Load() const;
+    static int Depth(const Routee& routee);
+    void Send(const Routee& routee, std::shared_ptr<void> message);
+
+private:
+    std::vector<std::shared_ptr<PID>> pending_;  // Last SetRoutees, re-resolved on SetSender
+    Published<std::vector<Routee>> snapshot_;
+    SenderContext sender_;
+    
+    void Publish();
+};
+
+/**
+ * @brief Broadcast router for large local fan-out.
+ *
+ * The one message instance is enqueued directly into every routee mailbox: no envelope per
+ * routee, no registry lookup and no sender middleware. Mailboxes that become runnable are
+ * grouped by dispatcher and submitted in batches of FANOUT_BATCH, one Schedule per batch
+ * instead of one per routee. Routees without a local mailbox go through the sender context.
+ */
+class FanoutBroadcastRouter : public MailboxRouter {
+public:
+    static constexpr std::size_t FANOUT_BATCH = 64;
+    
+    void RouteMessage(std::shared_ptr<void> message) override;
+};
+
+/**
+ * @brief Least-loaded router using power-of-two-choices: samples two random routees and sends
+ * to the one with the shorter mailbox. O(1) per message, and avoids the herding that a
+ * global minimum causes under concurrent senders.
+ */
+class LeastLoadedRouter : public MailboxRouter {
+public:
+    void RouteMessage(std::shared_ptr<void> message) override;
+};
+
+/**
+ * @brief Smallest-mailbox router: scans every routee and sends to the shortest mailbox.
+ * O(n) per message; intended for small pools.
+ */
+class SmallestMailboxRouter : public MailboxRouter {
+public:
+    void RouteMessage(std::shared_ptr<void> message) override;
+};
+
+/**
+ * @brief Scatter-gather-first-completed router for idempotent requests.
+ *
+ * Each request goes to k routees (rotating through the pool) and the first response wins;
+ * it is forwarded to the original sender of the routed envelope. With hedging enabled
+ * the copies are staggered: the next routee gets the request only if no response arrived
+ * within the observed p95 latency. Once a request completes, unsent copies are dropped
+ * and late responses are ignored.
+ */
+class ScatterGatherFirstCompletedRouter : public Router {
+public:
+    /**
+     * @param k Routees per request
+     * @param timeout Timeout of each request
+     * @param hedged Stagger the copies by the p95 latency instead of sending all at once
+     * @param initial_hedge_delay Hedge delay until enough latency samples were observed
+     */
+    explicit ScatterGatherFirstCompletedRouter(
+        int k = 2,
+        std::chrono::milliseconds timeout = std::chrono::milliseconds(5000),
+        bool hedged = false,
+        std::chrono::milliseconds initial_hedge_delay = std::chrono::milliseconds(10));
+    ~ScatterGatherFirstCompletedRouter() override;
+    
+    void RouteMessage(std::shared_ptr<void> message) override;
+    void SetRoutees(const std::vector<std::shared_ptr<PID>>& routees) override;
+    std::vector<std::shared_ptr<PID>> GetRoutees() const override;
+    void SetSender(SenderContext sender) override;
+    
+    /**
+     * @brief Send a request and get a future for the first response.
+     * @param message Request message
+     * @return Future resolving with a ScatterGatherResult (one non-null response)
+     */
+    std::shared_ptr<Future> Request(std::shared_ptr<void> message);
+    
+    /**
+     * @brief Current hedge delay (p95 of observed latency, or the initial delay).
+     */
+    std::chrono::milliseconds HedgeDelay() const;
+    
+    /**
+     * @brief Cancel every outstanding request (they resolve with operation_canceled).
+     * @return Number of requests cancelled
+     */
+    std::size_t CancelOutstanding();
+    
+    /**
+     * @brief Number of requests still waiting for a response.
+     */
+    std::size_t Outstanding() const;
+
+protected:
+    // Log2 histogram of response latency in microseconds
+    struct LatencyHistogram {
+        static constexpr int BUCKETS = 40;
+        static constexpr uint64_t MIN_SAMPLES = 20;
+        static constexpr uint64_t DECAY_AT = 4096;
+        std::atomic<uint64_t> buckets[BUCKETS] = {};
+        std::atomic<uint64_t> count{0};
+        
+        void Record(std::chrono::microseconds latency);
+        // Upper bound of the p95 bucket, or zero until MIN_SAMPLES were recorded
+        std::chrono::microseconds P95() const;
+    };
+    
+    // Written by completion callbacks, which hold it weakly and may outlive the router
+    struct State {
+        LatencyHistogram latency;
+        std::mutex mutex;
+        uint64_t next_request = 0;
+        std::unordered_map<uint64_t, std::weak_ptr<ScatterGatherFuture>> outstanding;
+    };
+    
+    RouteeSet routees_;
+    SenderContext sender_;
+    int k_;
+    std::chrono::milliseconds timeout_;
+    bool hedged_;
+    std::chrono::milliseconds initial_hedge_delay_;
+    std::atomic<uint32_t> next_;
+    std::shared_ptr<State> state_;
+};
+
+/**
+ * @brief Consistent hash router keeps key affinity: messages with the same key go to the same
+ * routee.
+ *
+ * Each routee owns `replicas` virtual nodes on a 64-bit hash ring; a message is routed to the
+ * first virtual node at or after the hash of its key. Adding or removing one routee of n
+ * remaps only about 1/n of the keys. The ring is rebuilt on SetRoutees and published as an
+ * immutable snapshot, so routing is a lock-free load plus a binary search.
  */
 class ConsistentHashRouter : public Router {
 public:
+    /**
+     * @brief Key hash function over a routed message.
+     */
+    using HashFunc = std::function<uint64_t(const std::shared_ptr<void>& message)>;
+    
+    static constexpr int DEFAULT_REPLICAS = 100;
+    
+    /**
+     * @brief Create a consistent hash router.
+     * @param hash Key hash of a message; when null the message address is used (no affinity)
+     * @param replicas Virtual nodes per routee
+     */
+    explicit ConsistentHashRouter(HashFunc hash = nullptr, int replicas = DEFAULT_REPLICAS);
+    
     void RouteMessage(std::shared_ptr<void> message) override;
     void SetRoutees(const std::vector<std::shared_ptr<PID>>& routees) override;
     std::vector<std::shared_ptr<PID>> GetRoutees() const override;
     void SetSender(SenderContext sender) override;
+    
+    /**
+     * @brief Routee that a message maps to (nullptr when there are no routees).
+     * @param message Message to hash
+     * @return Routee PID
+     */
+    std::shared_ptr<PID> RouteeFor(const std::shared_ptr<void>& message) const;
+    
+    /**
+     * @brief Stable 64-bit hash of a string key, for use in HashFunc.
+     */
+    static uint64_t HashKey(const std::string& key);
 
 protected:
-    std::vector<std::shared_ptr<PID>> routees_;
+    struct Ring {
+        std::vector<std::shared_ptr<PID>> routees;
+        std::vector<std::pair<uint64_t, std::size_t>> nodes;  // (point, routee index), sorted
+    };
+    
+    HashFunc hash_;
+    int replicas_;
+    Published<Ring> ring_;
     SenderContext sender_;
-    // Hash ring implementation would go here
 };
 
 } // namespace router
@@ -0,0 +1,35 @@
+#ifndef PROTOACTOR_SCATTER_GATHER_H
+#define PROTOACTOR_SCATTER_GATHER_H
+
+#include "pid.h"
+#include <memory>
+#include <cstddef>
+#include <vector>
+
+namespace protoactor {
+
+/**
+ * @brief Completion policy of a scatter-gather request.
+ */
+enum class GatherMode {
+    All,     // Complete when every target has responded
+    First,   // Complete on the first response
+    Quorum   // Complete once the quorum of targets has responded
+};
+
+/**
+ * @brief Aggregated result of a scatter-gather request.
+ *
+ * This is the value the aggregate future resolves with, also on timeout, so that
+ * partial responses are available to the caller.
+ */
+struct ScatterGatherResult {
+    std::vector<std::shared_ptr<PID>> targets;      // Targets in request order
+    std::vector<std::shared_ptr<void>> responses;   // Aligned with targets; nullptr when missing
+    std::size_t received = 0;                       // Number of responses received
+    std::size_t unreachable = 0;                    // Targets that could not be resolved
+};
+
+} // namespace protoactor
+
+#endif // PROTOACTOR_SCATTER_GATHER_H
@@ -7,11 +7,11 @@
 #include "external/pid.h"
 #include "external/messages.h"
 #include "external/supervision.h"
-#include "internal/scheduler/timer.h" // Include scheduler timer header
 #include <memory>
 #include <vector>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <stack>
 
 namespace protoactor {
@@ -21,6 +21,10 @@ class ActorSystem;
 class RestartStatistics;
 class CapturedContext;
 
+namespace scheduler {
+class TimerWheel;
+}
+
 /**
  * @brief ActorContext is the context implementation for actors.
  */
@@ -50,6 +54,7 @@ public:
     void Request(std::shared_ptr<PID> pid, std::shared_ptr<void> message) override;
     void RequestWithCustomSender(std::shared_ptr<PID> pid, std::shared_ptr<void> message, std::shared_ptr<PID> sender) override;
     std::shared_ptr<Future> RequestFuture(std::shared_ptr<PID> pid, std::shared_ptr<void> message, std::chrono::milliseconds timeout) override;
+    std::shared_ptr<Future> RequestScatterGather(const std::vector<std::shared_ptr<PID>>& pids, std::shared_ptr<void> message, std::chrono::milliseconds timeout, GatherMode mode, int quorum) override;
     std::chrono::milliseconds ReceiveTimeout() override;
     std::vector<std::shared_ptr<PID>> Children() override;
     void Respond(std::shared_ptr<void> response) override;
@@ -94,6 +99,14 @@ private:
     std::shared_ptr<PID> parent_;
     std::shared_ptr<PID> self_;  // Set during spawn
     std::chrono::milliseconds receive_timeout_;
+    // Receive timeout as a deadline on the system timer wheel: each user message only stores
+    // a new deadline; the wheel entry checks it lazily and reschedules if it moved.
+    std::shared_ptr<scheduler::TimerWheel> timer_wheel_;
+    std::uint64_t receive_timeout_ticks_;
+    std::atomic<std::uint64_t> receive_deadline_;  // Wheel tick; 0 = disabled
+    std::atomic<bool> receive_timeout_armed_;      // A wheel entry is pending
+    std::atomic<std::uint64_t> receive_timeout_generation_;  // Entries of older generations drop themselves
+    std::atomic<std::uint64_t> receive_timeout_entry_tick_;  // Tick of the live entry
     std::shared_ptr<void> message_or_envelope_;
     std::atomic<int> state_;
     
@@ -103,7 +116,6 @@ private:
         std::vector<std::shared_ptr<PID>> watchers_;
         std::stack<std::shared_ptr<void>> stash_;
         std::shared_ptr<RestartStatistics> restart_stats_;
-        std::shared_ptr<protoactor::scheduler::CancelFunc> receive_timeout_timer_; // Cancel function for receive timeout timer
     };
     std::unique_ptr<Extras> extras_;
     
@@ -124,7 +136,10 @@ private:
     void HandleRestart();
     void HandleContinuation(std::shared_ptr<Continuation> msg);
     void SendUserMessage(std::shared_ptr<PID> pid, std::shared_ptr<void> message);
-    void ReceiveTimeoutHandler();
+    void ResetReceiveTimeout();
+    void ScheduleReceiveTimeout(std::uint64_t tick);
+    void RescheduleReceiveTimeout(std::uint64_t tick, std::uint64_t generation);
+    static void OnReceiveTimeoutTick(const std::weak_ptr<ActorContext>& weak, std::uint64_t generation);
 };
 
 } // namespace protoactor
@@ -3,13 +3,21 @@
 
 #include "internal/process.h"
 #include "external/pid.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <string>
 
 namespace protoactor {
 
 // Forward declarations
 class ActorSystem;
 
+namespace eventstream {
+class EventStream;
+} // namespace eventstream
+
 /**
  * @brief DeadLetterEvent is published when a message is sent to a nonexistent PID.
  */
@@ -37,8 +45,77 @@ public:
     explicit DeadLetterResponse(std::shared_ptr<PID> t) : target(t) {}
 };
 
+/**
+ * @brief Lock-free throttle and aggregator for dead-letter logging.
+ *
+ * Within one throttle window the first `count` dead letters are sampled (logged
+ * individually); every dead letter is counted per target PID. Flush() closes the window and
+ * returns one summary line for the suppressed events. Record() only touches atomics, so
+ * senders never serialize on it.
+ */
+class DeadLetterThrottle {
+public:
+    /**
+     * @param count Dead letters sampled per window (Config::dead_letter_throttle_count)
+     */
+    explicit DeadLetterThrottle(int count);
+    
+    DeadLetterThrottle(const DeadLetterThrottle&) = delete;
+    DeadLetterThrottle& operator=(const DeadLetterThrottle&) = delete;
+    
+    /**
+     * @brief Count one dead letter.
+     * @param target Target PID (may be null)
+     * @param first_in_window Set when this event opened a new window
+     * @return true if the event is sampled and should be logged individually
+     */
+    bool Record(const std::shared_ptr<PID>& target, bool& first_in_window);
+    
+    /**
+     * @brief Close the current window.
+     * @param interval Window length, used in the summary text
+     * @return Summary of the suppressed dead letters, empty if none were suppressed
+     */
+    std::string Flush(std::chrono::milliseconds interval);
+    
+    /** @brief Dead letters seen since creation. */
+    uint64_t Total() const { return total_.load(std::memory_order_relaxed); }
+    /** @brief Dead letters sampled since creation. */
+    uint64_t Sampled() const { return sampled_.load(std::memory_order_relaxed); }
+    /** @brief Dead letters suppressed since creation. */
+    uint64_t Suppressed() const { return suppressed_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t SLOTS = 256;
+    static constexpr std::size_t PROBES = 8;
+    
+    // Open-addressed per-target counter; a slot is claimed once and reused by later windows
+    struct Slot {
+        std::atomic<uint64_t> hash{0};
+        std::atomic<bool> ready{false};
+        std::string target;
+        std::atomic<uint64_t> count{0};
+    };
+    
+    uint64_t count_;
+    std::atomic<uint64_t> window_{0};
+    std::atomic<uint64_t> total_{0};
+    std::atomic<uint64_t> sampled_{0};
+    std::atomic<uint64_t> suppressed_{0};
+    std::atomic<uint64_t> overflow_{0};   // Targets that found no free slot
+    Slot slots_[SLOTS];
+    
+    void CountTarget(const std::shared_ptr<PID>& target);
+};
+
 /**
  * @brief DeadLetterProcess handles messages sent to non-existent actors.
+ *
+ * Dead letters are logged through a DeadLetterThrottle configured from
+ * Config::dead_letter_throttle_count / dead_letter_throttle_interval; the window is closed
+ * by a timer on the system timer wheel, armed only while dead letters are arriving.
+ * Counting happens on the publisher's thread; the sampled lines and window summaries are
+ * handed to an asynchronous subscription, so neither the publisher nor the wheel writes.
  */
 class DeadLetterProcess : public Process, public std::enable_shared_from_this<DeadLetterProcess> {
 public:
@@ -52,9 +129,22 @@ public:
     void SendUserMessage(std::shared_ptr<PID> pid, std::shared_ptr<void> message) override;
     void SendSystemMessage(std::shared_ptr<PID> pid, std::shared_ptr<void> message) override;
     void Stop(std::shared_ptr<PID> pid) override;
+    
+    /**
+     * @brief Dead-letter counters (total / sampled / suppressed).
+     */
+    const DeadLetterThrottle& Throttle() const { return *throttle_; }
 
 private:
     std::shared_ptr<ActorSystem> actor_system_;
+    std::unique_ptr<DeadLetterThrottle> throttle_;
+    std::chrono::milliseconds throttle_interval_;
+    bool request_logging_;
+    std::shared_ptr<eventstream::EventStream> log_;   // Async writer for sampled lines and summaries
+    
+    void OnDeadLetter(const std::shared_ptr<DeadLetterEvent>& dead_letter);
+    void ArmThrottleTimer();
+    void ReportThrottled();
     
 public:
     explicit DeadLetterProcess(std::shared_ptr<ActorSystem> actor_system);
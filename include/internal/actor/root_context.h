@@ -27,6 +27,7 @@ public:
     void Request(std::shared_ptr<PID> pid, std::shared_ptr<void> message) override;
     void RequestWithCustomSender(std::shared_ptr<PID> pid, std::shared_ptr<void> message, std::shared_ptr<PID> sender) override;
     std::shared_ptr<Future> RequestFuture(std::shared_ptr<PID> pid, std::shared_ptr<void> message, std::chrono::milliseconds timeout) override;
+    std::shared_ptr<Future> RequestScatterGather(const std::vector<std::shared_ptr<PID>>& pids, std::shared_ptr<void> message, std::chrono::milliseconds timeout, GatherMode mode, int quorum) override;
     std::chrono::milliseconds ReceiveTimeout() override;
     std::vector<std::shared_ptr<PID>> Children() override;
     void Respond(std::shared_ptr<void> response) override;
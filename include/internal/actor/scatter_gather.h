@@ -0,0 +1,133 @@
+#ifndef PROTOACTOR_INTERNAL_SCATTER_GATHER_H
+#define PROTOACTOR_INTERNAL_SCATTER_GATHER_H
+
+#include "external/future.h"
+#include "external/scatter_gather.h"
+#include "external/messages.h"
+#include "internal/process.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace protoactor {
+
+class ActorSystem;
+
+/**
+ * @brief Aggregate future backing Context::RequestScatterGather.
+ *
+ * A single process is registered for the whole request. Each target gets a sender PID
+ * sharing the process id, with request_id = index + 1, so responses are correlated to
+ * their target without a future per target. One timeout, on the system timer wheel,
+ * covers the whole request. Targets are sent to all at once (Scatter) or one at a time
+ * with a delay between them (Hedge).
+ *
+ * The future resolves with a ScatterGatherResult. The error is empty when the policy
+ * was met, timed_out on timeout, and no_such_process when enough targets were
+ * unreachable that the policy can no longer be met.
+ */
+class ScatterGatherFuture : public Future, public Process, public std::enable_shared_from_this<ScatterGatherFuture> {
+public:
+    using SendFunc = std::function<void(std::shared_ptr<PID>, std::shared_ptr<MessageEnvelope>)>;
+
+    /**
+     * @brief Create and register a scatter-gather future.
+     * @param actor_system The actor system
+     * @param targets Target PIDs
+     * @param mode Completion policy
+     * @param quorum Required responses for GatherMode::Quorum (<= 0 means majority)
+     * @param timeout Timeout for the whole request
+     * @return The future
+     */
+    static std::shared_ptr<ScatterGatherFuture> New(
+        std::shared_ptr<ActorSystem> actor_system,
+        const std::vector<std::shared_ptr<PID>>& targets,
+        GatherMode mode,
+        int quorum,
+        std::chrono::milliseconds timeout);
+
+    ScatterGatherFuture(
+        std::shared_ptr<ActorSystem> actor_system,
+        const std::vector<std::shared_ptr<PID>>& targets,
+        GatherMode mode,
+        int quorum,
+        std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Send the request to every target, then arm the timeout.
+     * Unresolvable targets are counted as unreachable instead of going to dead letters.
+     * @param message The request message
+     * @param send Sends an envelope to a target (lets contexts apply sender middleware)
+     */
+    void Scatter(std::shared_ptr<void> message, const SendFunc& send);
+
+    /**
+     * @brief Hedged send: the first target gets the request now, each further target only if
+     * no response arrived within `delay` of the previous send. Stops once the policy is met.
+     * @param message The request message
+     * @param send Sends an envelope to a target
+     * @param delay Hedge delay (rounded up to the system timer wheel tick)
+     */
+    void Hedge(std::shared_ptr<void> message, SendFunc send, std::chrono::milliseconds delay);
+
+    /**
+     * @brief Cancel the request: resolves with operation_canceled, unsent hedges are dropped
+     * and late responses are ignored.
+     */
+    void Cancel();
+
+    // Future interface
+    std::shared_ptr<PID> GetPID() override;
+    void PipeTo(const std::vector<std::shared_ptr<PID>>& pids) override;
+    std::pair<std::shared_ptr<void>, std::error_code> Result() override;
+    std::error_code Wait() override;
+    void ContinueWith(std::function<void(std::shared_ptr<void>, std::error_code)> continuation) override;
+
+    // Process interface
+    void SendUserMessage(std::shared_ptr<PID> pid, std::shared_ptr<void> message) override;
+    void SendSystemMessage(std::shared_ptr<PID> pid, std::shared_ptr<void> message) override;
+    void Stop(std::shared_ptr<PID> pid) override;
+
+private:
+    std::shared_ptr<ActorSystem> actor_system_;
+    std::shared_ptr<PID> pid_;
+    std::vector<std::shared_ptr<PID>> targets_;
+    std::vector<std::shared_ptr<void>> responses_;
+    std::size_t required_;
+    std::size_t received_;
+    std::size_t unreachable_;
+    std::size_t next_target_;   // Next target to send to (hedged mode)
+    std::chrono::milliseconds timeout_;
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool done_;
+    std::shared_ptr<void> result_;
+    std::error_code err_;
+    std::vector<std::shared_ptr<PID>> pipes_;
+    std::vector<std::function<void(std::shared_ptr<void>, std::error_code)>> completions_;
+
+    void Register();
+    void ArmTimeout();
+    // Sends to one target; returns false (and counts it) if the target is unreachable
+    bool SendTo(std::size_t index, const std::shared_ptr<void>& message, const SendFunc& send);
+    void SendNextHedge(std::shared_ptr<void> message, SendFunc send, std::chrono::milliseconds delay);
+    // Resolves if the policy is decided; returns true if this call finished the future
+    bool ResolveIfDecided();
+    void OnResponse(std::uint32_t request_id, std::shared_ptr<void> message);
+    // Requires mutex_ held; returns true if the policy is met or can no longer be met
+    bool Decided(std::error_code& err) const;
+    // Requires mutex_ held; marks the future done and snapshots the result
+    void Resolve(std::error_code err);
+    // Runs after Resolve outside the lock
+    void Finish();
+    void SendToPipes();
+};
+
+} // namespace protoactor
+
+#endif // PROTOACTOR_INTERNAL_SCATTER_GATHER_H
@@ -51,6 +51,30 @@ public:
      * @return Message count
      */
     virtual int UserMessageCount() const = 0;
+    
+    /**
+     * @brief Enqueue a user message without scheduling the mailbox, so that a caller posting
+     * to many mailboxes can schedule them in batches.
+     * @param message The message to post
+     * @return true if the mailbox went from idle to running and the caller must call Run()
+     * on the mailbox's dispatcher; false if it is already scheduled (or was scheduled here)
+     */
+    virtual bool EnqueueUserMessage(std::shared_ptr<void> message) {
+        PostUserMessage(message);
+        return false;
+    }
+    
+    /**
+     * @brief Process pending messages. Only valid after EnqueueUserMessage returned true.
+     */
+    virtual void Run() {}
+    
+    /**
+     * @brief Dispatcher the mailbox is scheduled on (nullptr if not registered).
+     */
+    virtual std::shared_ptr<Dispatcher> GetDispatcher() const {
+        return nullptr;
+    }
 };
 
 /**
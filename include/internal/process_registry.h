@@ -84,6 +84,12 @@ public:
      * @return Address string
      */
     std::string Address() const;
+    
+    /**
+     * @brief Set the address of this registry (called by remote once it listens).
+     * @param address Address string, e.g. "host:port"
+     */
+    void SetAddress(const std::string& address);
 
 private:
     std::atomic<uint64_t> sequence_id_;
@@ -0,0 +1,128 @@
+#ifndef PROTOACTOR_REMOTE_CONNECTION_DICTIONARY_H
+#define PROTOACTOR_REMOTE_CONNECTION_DICTIONARY_H
+
+#include "external/pid.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace protoactor {
+namespace remote {
+
+/**
+ * @brief Sending half of the per-connection type name and PID dictionaries.
+ *
+ * Type names, target ids and sender PIDs are assigned ids once per connection; a batch
+ * carries only the entries first used in it and envelopes reference the ids. Senders are
+ * keyed by value (address and id), so equal PIDs held in different objects share an id.
+ * Target ids are 0-based and sender ids 1-based (0 means no sender), as in a batch.
+ *
+ * The dictionary is soft-bounded: once it holds max_entries entries the next batch starts
+ * with a reset, so short-lived PIDs (futures) do not grow it without limit.
+ */
+class ConnectionDictionaryEncoder {
+public:
+    /**
+     * @param max_entries Entries (all three tables) before the dictionary is reset
+     */
+    explicit ConnectionDictionaryEncoder(std::size_t max_entries);
+    
+    /**
+     * @brief Call before encoding a batch.
+     * @return True if the dictionary was reset; the batch must tell the peer to reset too
+     */
+    bool BeginBatch();
+    
+    /**
+     * @brief Id of a type name.
+     * @param added Set to true if the entry is new and must be sent with this batch
+     */
+    int32_t TypeName(const std::string& type_name, bool* added);
+    
+    /**
+     * @brief Id of a target PID id.
+     */
+    int32_t Target(const std::string& id, bool* added);
+    
+    /**
+     * @brief 1-based id of a sender PID (request_id is sent per envelope, not interned).
+     */
+    int32_t Sender(const PID& sender, bool* added);
+    
+    /**
+     * @brief Forget all entries (on reconnect both ends start empty).
+     */
+    void Reset();
+    
+    std::size_t Size() const;
+
+private:
+    std::size_t max_entries_;
+    std::unordered_map<std::string, int32_t> type_names_;
+    std::unordered_map<std::string, int32_t> targets_;
+    std::unordered_map<std::string, int32_t> senders_;
+};
+
+/**
+ * @brief Receiving half: applies the entries carried by each batch and resolves ids.
+ *
+ * PIDs are created once per entry and shared by every envelope that references them, so the
+ * cached process pointer stays warm; envelopes with a request id get their own copy.
+ *
+ * The peer's encoder resets before its dictionary reaches its own max_entries, so a batch
+ * that extends a dictionary already holding twice this side's max_entries (slack for a peer
+ * configured larger), or that adds more entries than its envelopes can use, is not admitted.
+ */
+class ConnectionDictionaryDecoder {
+public:
+    /**
+     * @param local_address Address of this node, used for target PIDs
+     * @param max_entries This node's endpoint_dictionary_size (0 for no bound)
+     */
+    ConnectionDictionaryDecoder(std::string local_address, std::size_t max_entries);
+    
+    /**
+     * @brief Call after any reset a batch requests, before applying its entries.
+     * @param added Entries (all three tables) the batch carries
+     * @param envelopes Envelopes in the batch
+     * @return False if the batch exceeds the bound; the connection should be closed
+     */
+    bool Admit(std::size_t added, std::size_t envelopes) const;
+    
+    void Reset();
+    void AddTypeName(const std::string& type_name);
+    void AddTarget(const std::string& id);
+    void AddSender(const std::string& address, const std::string& id);
+    
+    /**
+     * @return Type name, or nullptr if the id is unknown
+     */
+    const std::string* TypeName(int32_t id) const;
+    
+    /**
+     * @return Target PID, or nullptr if the id is unknown
+     */
+    std::shared_ptr<PID> Target(int32_t id, uint32_t request_id) const;
+    
+    /**
+     * @return Sender PID, or nullptr for 0 and unknown ids
+     */
+    std::shared_ptr<PID> Sender(int32_t id, uint32_t request_id) const;
+    
+    std::size_t Size() const;
+
+private:
+    std::string local_address_;
+    std::size_t max_entries_;
+    std::vector<std::string> type_names_;
+    std::vector<std::shared_ptr<PID>> targets_;
+    std::vector<std::shared_ptr<PID>> senders_;
+};
+
+} // namespace remote
+} // namespace protoactor
+
+#endif // PROTOACTOR_REMOTE_CONNECTION_DICTIONARY_H
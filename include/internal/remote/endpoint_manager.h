@@ -6,26 +6,92 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <mutex>
 #include <atomic>
 #include <any>
+#include <cstdint>
+#include <functional>
+#include <system_error>
 
 namespace protoactor {
+
+namespace metrics {
+class Gauge;
+}
+
 namespace remote {
 
 // Forward declarations
 class Remote;
 class EndpointWriter;
 class EndpointWatcher;
+class Transport;
+
+/**
+ * @brief Bounded slot counter for the messages queued towards one endpoint.
+ *
+ * A slot is taken when a message is handed to the endpoint writer and released when the
+ * writer has sent or dropped it, so the depth covers both the writer's mailbox and its
+ * batch queue. The depth is also exported as the "remote_endpoint_queue_depth" gauge.
+ */
+class EndpointQueue {
+public:
+    /**
+     * @param address Endpoint address (gauge label)
+     * @param capacity Maximum depth; <= 0 means unbounded
+     */
+    EndpointQueue(const std::string& address, int capacity);
+    
+    /**
+     * @brief Take a slot.
+     * @return false if the queue is full (the caller must not enqueue)
+     */
+    bool TryAcquire();
+    
+    /**
+     * @brief Release slots of messages that left the queue.
+     */
+    void Release(int count = 1);
+    
+    int Depth() const { return depth_.load(std::memory_order_relaxed); }
+    int Capacity() const { return capacity_; }
+    uint64_t Rejected() const { return rejected_.load(std::memory_order_relaxed); }
+    bool Backpressured() const { return backpressured_.load(std::memory_order_acquire); }
+    
+    /**
+     * @brief Called with true when the queue becomes full and with false once it has
+     * drained to half its capacity.
+     */
+    void OnBackpressure(std::function<void(bool active, int depth)> callback);
+
+private:
+    int capacity_;
+    std::atomic<int> depth_;
+    std::atomic<uint64_t> rejected_;
+    std::atomic<bool> backpressured_;
+    std::function<void(bool, int)> on_backpressure_;
+    std::shared_ptr<metrics::Gauge> gauge_;
+};
 
 /**
  * @brief Endpoint represents a connection to a remote address.
+ *
+ * With Config::endpoint_writer_stripes > 1 the endpoint has several writers, each with its
+ * own connection. A message goes to the writer chosen by the hash of its target's id, so
+ * messages to one target keep their order while different targets are written in parallel.
  */
 struct Endpoint {
-    std::shared_ptr<PID> writer;
+    std::vector<std::shared_ptr<PID>> writers;  // One per stripe
     std::shared_ptr<PID> watcher;
+    std::shared_ptr<EndpointQueue> queue;
     
     std::string Address() const;
+    
+    /**
+     * @brief Writer of the stripe that carries messages to the target (nullptr if none).
+     */
+    std::shared_ptr<PID> WriterFor(const PID& target) const;
 };
 
 /**
@@ -59,16 +125,40 @@ public:
      */
     void RemoveEndpoint(const std::string& address);
     
+    /**
+     * @brief Remove an endpoint if the writer is one of its stripes; a writer of an endpoint
+     * that was already replaced leaves the new one alone.
+     * @param address Remote address
+     * @param writer Writer PID
+     */
+    void RemoveEndpoint(const std::string& address, const std::shared_ptr<PID>& writer);
+    
     /**
      * @brief Handle remote message delivery.
      * @param target Target PID
      * @param message Message to deliver
      * @param sender Sender PID
+     * @param serializer_id Serializer ID (< 0: default serializer)
+     * @return Error code: no_buffer_space if the endpoint queue is full, not_connected if
+     * there is no writer; the message goes to dead letters in both cases
      */
-    void RemoteDeliver(
+    std::error_code RemoteDeliver(
         std::shared_ptr<PID> target,
         std::shared_ptr<void> message,
-        std::shared_ptr<PID> sender);
+        std::shared_ptr<PID> sender,
+        int32_t serializer_id = -1);
+    
+    /**
+     * @brief Deliver a system message (Stop, Terminated, ...) on the endpoint's priority
+     * lane: it is sent before user messages already queued towards the endpoint and is not
+     * subject to the endpoint queue bound.
+     * @param target Target PID
+     * @param message System message
+     * @return not_connected if there is no writer (the message goes to dead letters)
+     */
+    std::error_code RemoteDeliverSystem(
+        std::shared_ptr<PID> target,
+        std::shared_ptr<void> message);
     
     /**
      * @brief Handle remote watch.
@@ -96,6 +186,19 @@ public:
     void RemoteTerminate(
         std::shared_ptr<PID> watcher,
         std::shared_ptr<PID> watchee);
+    
+    /**
+     * @brief Number of messages queued towards an endpoint (0 if unknown).
+     * @param address Remote address
+     */
+    int QueueDepth(const std::string& address);
+    
+    /**
+     * @brief Transports to try for an address, in order: shared memory for peers on this
+     * host, then the network transport. Empty when gRPC is used.
+     * @param address Remote address
+     */
+    std::vector<std::shared_ptr<Transport>> TransportsFor(const std::string& address) const;
 
 private:
     std::shared_ptr<Remote> remote_;
@@ -111,6 +214,8 @@ private:
     void StartSupervisor();
     void StopSupervisor();
     void HandleEndpointEvent(std::shared_ptr<void> event);
+    void StopEndpoint(const std::shared_ptr<Endpoint>& endpoint);
+    void DeadLetter(std::shared_ptr<PID> target, std::shared_ptr<void> message, std::shared_ptr<PID> sender);
 };
 
 } // namespace remote
@@ -6,29 +6,106 @@
 #include "external/pid.h"
 #include <memory>
 #include <string>
+#include <string_view>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
 
 namespace protoactor {
+
+class Dispatcher;
+
 namespace remote {
 
 // Forward declarations
 class Remote;
 
+/**
+ * @brief One received message, decoded from the wire batch but not yet deserialized.
+ */
+struct InboundEnvelope {
+    std::string_view data;        // Serialized payload, owned by InboundBatch::owner
+    std::string type_name;
+    int32_t serializer_id = -1;
+    std::shared_ptr<PID> target;
+    std::shared_ptr<PID> sender;
+};
+
+/**
+ * @brief Messages received in one wire batch.
+ */
+struct InboundBatch {
+    std::shared_ptr<const void> owner;  // Keeps the received bytes alive (e.g. the protobuf batch)
+    std::vector<InboundEnvelope> envelopes;
+};
+
 /**
  * @brief EndpointReader receives messages from remote endpoints via gRPC.
  * 
- * This class implements the gRPC Remoting service Receive method.
- * It will be fully implemented when gRPC is integrated.
+ * Received envelopes are deserialized and delivered on a dispatcher rather than on the
+ * stream thread. Envelopes are partitioned by target id; each partition is drained by at
+ * most one worker at a time (like a mailbox), so messages to the same target keep their
+ * order while different targets are processed in parallel. Delivery goes straight to the
+ * target's process, bypassing the root context.
+ *
+ * Pending envelopes are bounded by endpoint_reader_high_water: once they reach it the
+ * reader reports itself paused so the inbound side stops reading from its connections,
+ * and resumes below half of it. Batches that arrive while paused are still queued.
+ *
+ * Must be owned by a shared_ptr: scheduled drains keep the reader alive.
  */
-class EndpointReader {
+class EndpointReader : public std::enable_shared_from_this<EndpointReader> {
 public:
-    explicit EndpointReader(std::shared_ptr<Remote> remote);
+    /**
+     * @param remote Remote instance
+     * @param partitions Number of partitions (0: endpoint_reader_workers from the config,
+     * or the number of hardware threads)
+     * @param dispatcher Dispatcher that drains the partitions (nullptr: default dispatcher)
+     */
+    explicit EndpointReader(
+        std::shared_ptr<Remote> remote,
+        int partitions = 0,
+        std::shared_ptr<Dispatcher> dispatcher = nullptr);
     
     /**
-     * @brief Handle incoming message batch.
+     * @brief Handle incoming message batch: queue each envelope on its target's partition.
      * @param batch Message batch
      */
-    void OnMessageBatch(std::shared_ptr<void> batch); // Will use protobuf MessageBatch when gRPC is integrated
+    void OnMessageBatch(std::shared_ptr<InboundBatch> batch);
+    
+    /**
+     * @brief Number of envelopes queued but not yet delivered.
+     */
+    std::size_t Pending() const;
+    
+    /**
+     * @brief Whether pending envelopes reached the high-water mark and not yet drained
+     * below the low-water mark.
+     */
+    bool Paused() const { return paused_.load(std::memory_order_acquire); }
+    
+    /**
+     * @brief Install the flow-control callback: called with true when the reader pauses and
+     * with false when it resumes. Calls are serialized and always end with the current
+     * state; they run on the thread that crossed the mark.
+     */
+    void SetFlowControl(std::function<void(bool paused)> handler);
+    
+    /**
+     * @brief Block while paused, for inbound loops that read synchronously.
+     * @return true if the reader resumed, false on timeout
+     */
+    bool WaitWhilePaused(std::chrono::milliseconds timeout);
+    
+    /**
+     * @brief Number of partitions.
+     */
+    std::size_t Partitions() const { return partitions_.size(); }
     
     /**
      * @brief Handle connect request.
@@ -44,12 +121,38 @@ public:
     void Suspend(bool suspend);
 
 private:
+    struct Work {
+        std::shared_ptr<InboundBatch> batch;  // Shared by all envelopes of the batch
+        std::size_t index;
+    };
+    
+    struct Partition {
+        std::mutex mutex;
+        std::deque<Work> queue;
+        std::atomic<bool> scheduled{false};
+    };
+    
     std::shared_ptr<Remote> remote_;
     std::atomic<bool> suspended_;
+    std::shared_ptr<Dispatcher> dispatcher_;
+    std::vector<std::unique_ptr<Partition>> partitions_;
+    std::atomic<std::size_t> pending_;
+    std::size_t high_water_;   // 0: unbounded
+    std::size_t low_water_;
+    std::atomic<bool> paused_;
+    
+    std::mutex flow_mutex_;
+    std::condition_variable flow_cv_;
+    std::function<void(bool)> flow_handler_;
+    bool flow_reported_ = false;  // Last state passed to flow_handler_
+    
+    void UpdateFlow();
+    void Schedule(Partition* partition);
+    void Drain(Partition* partition);
     
     void HandleServerConnection(std::shared_ptr<void> connection);
     void DeserializeAndDeliver(
-        const std::vector<uint8_t>& data,
+        std::string_view data,
         const std::string& type_name,
         int32_t serializer_id,
         std::shared_ptr<PID> target,
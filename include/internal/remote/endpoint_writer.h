@@ -6,12 +6,16 @@
 #include "external/pid.h"
 #include "external/messages.h"
 #include "internal/remote/messages.h" // For RemoteDeliver
+#include "internal/remote/connection_dictionary.h"
 #include <memory>
 #include <string>
 #include <vector>
 #include <queue>
 #include <mutex>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <thread>
 
 #ifdef ENABLE_GRPC
@@ -20,21 +24,121 @@
 #endif
 
 namespace protoactor {
+
+class Mailbox;
+
 namespace remote {
 
 // Forward declarations
 class Remote;
 class Config;
+class EndpointQueue;
+class Transport;
+class TransportConnection;
+
+/**
+ * @brief Decides when the endpoint writer flushes its queue and how large batches are.
+ *
+ * A flush happens when the writer's mailbox drains (so light traffic is sent immediately),
+ * when the queue reaches the current batch limit, or when the estimated batch size in bytes
+ * reaches the byte threshold; the writer also arms a max-linger timer as a fallback. The
+ * batch limit adapts to throughput: it doubles while flushes leave a backlog behind and
+ * halves while batches stay well below it, within [min_batch_size, max_batch_size].
+ */
+class AdaptiveFlushPolicy {
+public:
+    enum class Reason {
+        None,
+        Drained,
+        BatchFull,
+        Bytes
+    };
+    
+    AdaptiveFlushPolicy(std::size_t max_batch_size, std::size_t max_batch_bytes, std::size_t min_batch_size = 16);
+    
+    /**
+     * @brief Decide whether to flush after a message was queued.
+     * @param queued Number of queued messages
+     * @param mailbox_empty True if no more messages are waiting in the writer's mailbox
+     * @return Reason to flush, or Reason::None
+     */
+    Reason OnEnqueue(std::size_t queued, bool mailbox_empty) const;
+    
+    /**
+     * @brief Record a flushed batch and adapt the batch limit.
+     * @param messages Messages in the batch
+     * @param bytes Serialized payload bytes in the batch
+     * @param backlog True if messages were still queued after the batch was taken
+     */
+    void OnFlushed(std::size_t messages, std::size_t bytes, bool backlog);
+    
+    /**
+     * @brief Current batch limit (messages per batch).
+     */
+    std::size_t BatchLimit() const { return limit_; }
+    
+    /**
+     * @brief Byte threshold per batch.
+     */
+    std::size_t MaxBatchBytes() const { return max_bytes_; }
+    
+    /**
+     * @brief Average serialized message size observed so far (0 before the first flush).
+     */
+    std::size_t AverageMessageBytes() const { return avg_bytes_; }
+
+private:
+    std::size_t min_limit_;
+    std::size_t max_limit_;
+    std::size_t max_bytes_;
+    std::size_t limit_;
+    std::size_t avg_bytes_;
+};
+
+/**
+ * @brief Delay before the writer's next connection attempt.
+ *
+ * The delay doubles with every failed attempt, from the initial delay up to the maximum.
+ * The upper half of it is random ("equal jitter"), so writers that lost the same peer do
+ * not reconnect in lockstep.
+ */
+class ReconnectBackoff {
+public:
+    ReconnectBackoff(std::chrono::milliseconds initial, std::chrono::milliseconds max);
+    
+    /**
+     * @param retry Number of failed attempts so far (1 for the first retry)
+     * @param jitter Random value in [0, 1)
+     */
+    std::chrono::milliseconds Delay(int retry, double jitter) const;
+
+private:
+    std::chrono::milliseconds initial_;
+    std::chrono::milliseconds max_;
+};
 
 /**
  * @brief EndpointWriter sends messages to a remote endpoint.
+ *
+ * Connecting never blocks the actor: each attempt sends ConnectRequest and returns, the
+ * ConnectResponse (or a handshake timeout) arrives as a message, and failed attempts are
+ * retried from the timer wheel with ReconnectBackoff. Messages queue up meanwhile, bounded
+ * by the endpoint queue; when the writer gives up after max_retry_count attempts it
+ * publishes EndpointTerminatedEvent and sends the queued messages to dead letters.
  */
 class EndpointWriter : public Actor {
 public:
+    /**
+     * @param queue Slot counter of the endpoint; the writer releases a slot for every
+     * message it sends or drops (optional)
+     * @param transports Native transports to try in order (empty: gRPC)
+     */
     EndpointWriter(
         std::shared_ptr<Remote> remote,
         const std::string& address,
-        std::shared_ptr<Config> config);
+        std::shared_ptr<Config> config,
+        std::shared_ptr<EndpointQueue> queue = nullptr,
+        std::vector<std::shared_ptr<Transport>> transports = {});
     
     void Receive(std::shared_ptr<Context> context) override;
 
@@ -42,6 +146,7 @@ private:
     std::shared_ptr<Remote> remote_;
     std::string address_;
     std::shared_ptr<Config> config_;
+    std::shared_ptr<EndpointQueue> queue_;
     
 #ifdef ENABLE_GRPC
     std::shared_ptr<grpc::ClientContext> client_context_;
@@ -50,17 +155,52 @@ private:
     std::unique_ptr<grpc::ClientReaderWriter<RemoteMessage, RemoteMessage>> stream_;
     std::thread receive_thread_;
     std::atomic<bool> receive_thread_running_;
+    RemoteMessage batch_message_;  // Reused across batches (writer runs one batch at a time)
 #endif
     
+    // Native transports (see EndpointManager::TransportsFor)
+    struct Handshake;
+    std::vector<std::shared_ptr<Transport>> transports_;
+    std::shared_ptr<TransportConnection> connection_;
+    std::shared_ptr<Handshake> connection_handshake_;  // Handshake that established connection_
+    std::shared_ptr<PID> self_;
+    
+    // Connection attempts
+    ReconnectBackoff backoff_;
+    int retry_count_;                     // Failed attempts since the last connection
+    std::size_t transport_index_;         // Transport tried by the current attempt
+    std::shared_ptr<Handshake> handshake_;  // Pending handshake, if any
+    std::shared_ptr<TransportConnection> pending_connection_;  // Its connection
+    uint64_t handshakes_;                 // Identifies the pending handshake in its events
+    
     std::atomic<bool> connected_;
     std::queue<std::shared_ptr<RemoteDeliver>> message_queue_;
+    std::queue<std::shared_ptr<RemoteDeliver>> system_queue_;  // Priority lane, flushed first
     std::mutex queue_mutex_;
     
+    AdaptiveFlushPolicy flush_policy_;
+    ConnectionDictionaryEncoder dictionary_;
+    bool use_dictionary_;  // Negotiated with the peer; otherwise ids are per stream message
+    uint32_t compression_; // Negotiated batch codec (wire::kCompression*)
+    std::weak_ptr<Mailbox> mailbox_;  // Own mailbox, to flush when it drains
+    bool linger_armed_;
+    
     void Initialize(std::shared_ptr<Context> context);
+    void Connect(std::shared_ptr<Context> context);
     bool InitializeInternal();
-    void SendMessageBatch(const std::vector<std::shared_ptr<RemoteDeliver>>& batch);
+    bool ConnectTransport(const std::shared_ptr<Transport>& transport);
+    void OnHandshake(std::shared_ptr<Context> context, uint64_t id, bool timeout);
+    void OnConnected(std::shared_ptr<Context> context);
+    void OnConnectFailed(std::shared_ptr<Context> context);
+    void CancelHandshake();
+    std::size_t SendMessageBatch(const std::vector<std::shared_ptr<RemoteDeliver>>& batch);
+    std::size_t SendTransportBatch(const std::vector<std::shared_ptr<RemoteDeliver>>& batch);
     void HandleDisconnect();
-    void SendBatch(std::shared_ptr<Context> context);
+    void OnConnectionLost();
+    void Flush(std::shared_ptr<Context> context, bool all);
+    void FlushSystem();
+    void ArmLingerTimer(std::shared_ptr<Context> context);
+    bool MailboxEmpty() const;
     void ReceiveLoop();
     void CloseClientConn();
 };
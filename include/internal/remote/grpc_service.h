@@ -11,6 +11,9 @@
 namespace protoactor {
 namespace remote {
 
+class EndpointReader;
+class ConnectionDictionaryDecoder;
+
 /**
  * @brief gRPC service implementation for remote communication.
  */
@@ -54,9 +57,12 @@ public:
 
 private:
     std::shared_ptr<Remote> remote_;
+    std::shared_ptr<EndpointReader> endpoint_reader_;  // Shared by all inbound streams
 #ifdef ENABLE_GRPC
-    void HandleMessageBatch(const MessageBatch& batch);
+    bool HandleMessageBatch(std::shared_ptr<const RemoteMessage> message, ConnectionDictionaryDecoder& dictionary);  // False if the dictionary bound is exceeded
     void HandleConnectRequest(const ConnectRequest& request, ConnectResponse* response);
+
+    bool DecompressBatch(RemoteMessage* message);  // Replaces a compressed batch by the batch it holds
 #endif
 };
 
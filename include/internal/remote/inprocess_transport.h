@@ -0,0 +1,83 @@
+#ifndef PROTOACTOR_REMOTE_INPROCESS_TRANSPORT_H
+#define PROTOACTOR_REMOTE_INPROCESS_TRANSPORT_H
+
+#include "internal/remote/transport.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+namespace protoactor {
+namespace remote {
+
+/**
+ * @brief Loopback transport between actor systems in the same process.
+ *
+ * Listeners register their address in a process-wide table; Connect looks it up and links a
+ * pair of connections. A sent frame is moved, not copied, onto the receiving transport's
+ * delivery thread, so two systems exchange messages through the complete EndpointWriter ->
+ * serializer -> EndpointReader pipeline without sockets or kernel buffers. Meant for tests
+ * and for measuring the remoting pipeline itself.
+ */
+class InProcessTransport : public Transport, public std::enable_shared_from_this<InProcessTransport> {
+public:
+    InProcessTransport();
+    ~InProcessTransport() override;
+
+    InProcessTransport(const InProcessTransport&) = delete;
+    InProcessTransport& operator=(const InProcessTransport&) = delete;
+
+    /**
+     * @param address "host:port"; port 0 picks a port not used by another in-process listener
+     * @return address_in_use if another in-process listener has the address
+     */
+    std::error_code Listen(const std::string& address, TransportHandler handler) override;
+    std::string ListenAddress() const override;
+
+    /**
+     * @return connection_refused if no in-process listener has the address
+     */
+    std::pair<std::shared_ptr<TransportConnection>, std::error_code> Connect(
+        const std::string& address,
+        TransportHandler handler) override;
+    void Stop() override;
+
+    /**
+     * @brief Number of open connections (accepted and connected).
+     */
+    std::size_t Connections() const;
+
+private:
+    class Connection;
+
+    std::atomic<bool> stopped_;
+
+    mutable std::mutex listen_mutex_;
+    std::string listen_address_;
+    TransportHandler accept_handler_;
+
+    mutable std::mutex connections_mutex_;
+    std::unordered_set<std::shared_ptr<Connection>> connections_;
+
+    std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;
+    std::deque<std::function<void()>> queue_;
+    bool queue_closed_;
+    std::thread thread_;
+
+    void Post(std::function<void()> task);
+    void Run();
+    void Track(const std::shared_ptr<Connection>& connection);
+    void Untrack(const std::shared_ptr<Connection>& connection);
+};
+
+} // namespace remote
+} // namespace protoactor
+
+#endif // PROTOACTOR_REMOTE_INPROCESS_TRANSPORT_H
@@ -0,0 +1,34 @@
+#ifndef PROTOACTOR_REMOTE_LZ4_H
+#define PROTOACTOR_REMOTE_LZ4_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace protoactor {
+namespace remote {
+namespace lz4 {
+
+/**
+ * @brief Compress into the LZ4 block format (no frame header or checksum).
+ *
+ * Greedy single-pass matcher with a 64 KiB window, in the spirit of LZ4's fast mode: it
+ * trades ratio for speed and skips ahead quickly over incompressible input. The output
+ * decodes with any LZ4 block decoder; the uncompressed size must travel separately.
+ *
+ * @param out Compressed bytes are appended
+ */
+void Compress(std::string_view in, std::string* out);
+
+/**
+ * @brief Decompress an LZ4 block that holds exactly size bytes.
+ * @param out Decompressed bytes are appended; left unchanged on failure
+ * @return false if the block is malformed or does not decode to size bytes
+ */
+bool Decompress(std::string_view in, std::size_t size, std::string* out);
+
+} // namespace lz4
+} // namespace remote
+} // namespace protoactor
+
+#endif // PROTOACTOR_REMOTE_LZ4_H
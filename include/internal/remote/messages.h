@@ -14,6 +14,7 @@ namespace remote {
  */
 struct EndpointTerminatedEvent : public SystemMessage {
     std::string Address;
+    std::shared_ptr<PID> Writer;  // Writer whose connection was lost or never came up
 };
 
 /**
@@ -23,6 +24,16 @@ struct EndpointConnectedEvent : public SystemMessage {
     std::string Address;
 };
 
+/**
+ * @brief Event published under EndpointQueuePolicy::Backpressure when an endpoint's queue
+ * fills up (active = true) and when it has drained to half its capacity (active = false).
+ */
+struct EndpointBackpressureEvent : public SystemMessage {
+    std::string Address;
+    bool Active = false;
+    int Depth = 0;
+};
+
 /**
  * @brief Internal message for remote watch.
  */
@@ -42,12 +53,13 @@ struct RemoteUnwatch : public SystemMessage {
 /**
  * @brief Internal message for remote message delivery.
  */
-struct RemoteDeliver : public SystemMessage {
+struct RemoteDeliver : public PriorityMessage {
     std::shared_ptr<ReadonlyMessageHeader> header;
     std::shared_ptr<void> message;
     std::shared_ptr<PID> target;
     std::shared_ptr<PID> sender;
     int32_t serializer_id;
+    bool system = false;  // Arrives via the writer's system mailbox; sent on its priority lane
 };
 
 /**
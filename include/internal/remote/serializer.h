@@ -3,8 +3,8 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <mutex>
 #include <any>
 #include <cstdint>
 
@@ -13,6 +13,12 @@ namespace remote {
 
 /**
  * @brief Serializer interface for encoding and decoding messages.
+ *
+ * SerializeTo and DeserializeFrom are the zero-copy paths used by the endpoint writer and
+ * reader: SerializeTo appends into a caller-owned buffer (for example the message_data
+ * field of a protobuf envelope, which is then reused across batches), and DeserializeFrom
+ * reads straight from the received bytes. Their default implementations fall back to the
+ * vector-based Serialize/Deserialize, so existing serializers keep working unchanged.
  */
 class Serializer {
 public:
@@ -33,6 +39,35 @@ public:
      */
     virtual std::shared_ptr<void> Deserialize(const std::string& type_name, const std::vector<uint8_t>& bytes) = 0;
     
+    /**
+     * @brief Serialize a message by appending to a caller-provided buffer.
+     * @param message The message to serialize
+     * @param out Buffer to append to; existing contents are kept
+     * @return Number of bytes appended
+     */
+    virtual std::size_t SerializeTo(std::shared_ptr<void> message, std::string* out);
+    
+    /**
+     * @brief Deserialize a message from a view of the received bytes.
+     * @param type_name The type name of the message
+     * @param bytes The serialized bytes (only read during the call)
+     * @return Deserialized message
+     */
+    virtual std::shared_ptr<void> DeserializeFrom(const std::string& type_name, std::string_view bytes);
+    
+    /**
+     * @brief SerializeTo and GetTypeName in one call.
+     *
+     * Serializers that resolve a message's type once (e.g. from a per-type table) override
+     * this to skip the second lookup and the type name copy per message. The default calls
+     * SerializeTo and GetTypeName.
+     * @param message The message to serialize
+     * @param out Buffer to append to
+     * @return Type name; valid while the serializer is registered, or (default
+     * implementation) until the next call on the same thread
+     */
+    virtual const std::string& SerializeNamed(std::shared_ptr<void> message, std::string* out);
+    
     /**
      * @brief Get the type name of a message.
      * @param message The message
@@ -45,10 +80,23 @@ public:
      * @return Serializer ID
      */
     virtual int32_t GetSerializerID() const = 0;
+    
+    /**
+     * @brief Whether decoded messages may be system messages (Terminated, Watch, ...).
+     * Serializers of plain, non-polymorphic types return false so the reader delivers
+     * them as user messages without probing their type.
+     * @return True by default
+     */
+    virtual bool DecodesSystemMessages() const { return true; }
 };
 
 /**
  * @brief Serializer registry for managing serializers.
+ *
+ * Registration copies the current table, appends, and publishes the new table with a
+ * release store; lookups are a single acquire load and an index, with no lock and no
+ * reference count traffic. Serializers are never unregistered and published tables are
+ * kept alive, so a table or serializer pointer loaded once stays valid.
  */
 class SerializerRegistry {
 public:
@@ -76,6 +124,30 @@ public:
         std::shared_ptr<void> message, 
         int32_t serializer_id = -1);
     
+    /**
+     * @brief Serialize a message by appending to a caller-provided buffer.
+     * @param message The message to serialize
+     * @param out Buffer to append to
+     * @param serializer_id Serializer ID (use default if < 0)
+     * @return Type name
+     */
+    static std::string SerializeTo(
+        std::shared_ptr<void> message,
+        std::string* out,
+        int32_t serializer_id = -1);
+    
+    /**
+     * @brief Like SerializeTo, without copying the type name (see Serializer::SerializeNamed).
+     * @param message The message to serialize
+     * @param out Buffer to append to
+     * @param serializer_id Serializer ID (use default if < 0)
+     * @return Type name
+     */
+    static const std::string& SerializeNamed(
+        std::shared_ptr<void> message,
+        std::string* out,
+        int32_t serializer_id = -1);
+    
     /**
      * @brief Deserialize bytes to a message.
      * @param bytes Serialized bytes
@@ -87,11 +159,24 @@ public:
         const std::vector<uint8_t>& bytes,
         const std::string& type_name,
         int32_t serializer_id);
+    
+    /**
+     * @brief Deserialize a message from a view of the received bytes.
+     * @param bytes Serialized bytes
+     * @param type_name Type name
+     * @param serializer_id Serializer ID
+     * @return Deserialized message
+     */
+    static std::shared_ptr<void> DeserializeFrom(
+        std::string_view bytes,
+        const std::string& type_name,
+        int32_t serializer_id);
 
 private:
-    static std::vector<std::shared_ptr<Serializer>> serializers_;
-    static std::mutex mutex_;
-    static int32_t default_serializer_id_;
+    struct Table;
+    
+    static const Table* CurrentTable();
+    static Serializer* Find(int32_t serializer_id);
 };
 
 } // namespace remote
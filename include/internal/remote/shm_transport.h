@@ -0,0 +1,90 @@
+#ifndef PROTOACTOR_REMOTE_SHM_TRANSPORT_H
+#define PROTOACTOR_REMOTE_SHM_TRANSPORT_H
+
+#include "internal/remote/transport.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace protoactor {
+namespace remote {
+
+/**
+ * @brief Shared-memory transport for peers on the same host.
+ *
+ * A connection is one memfd holding two single-producer/single-consumer byte rings (one per
+ * direction). The connecting side creates it and passes it, together with four eventfds, over
+ * an abstract Unix socket named after the listener's port; the socket then only signals that
+ * the peer went away. Frames are copied into the ring and published with a release store, so
+ * a busy connection costs no syscalls: the consumer thread busy-polls for a short spin period
+ * before sleeping, and an eventfd is only written when the other side has announced that it
+ * is about to sleep. Frames larger than a quarter of the ring are split into fragments.
+ */
+class ShmTransport : public Transport, public std::enable_shared_from_this<ShmTransport> {
+public:
+    /**
+     * @param ring_bytes Capacity of each direction's ring (rounded up to 4 KiB)
+     * @param spin How long the receive thread polls idle rings before sleeping
+     * @param max_frame_size Larger inbound frames close the connection
+     */
+    explicit ShmTransport(
+        std::size_t ring_bytes = 4 * 1024 * 1024,
+        std::chrono::microseconds spin = std::chrono::microseconds(50),
+        std::size_t max_frame_size = 64 * 1024 * 1024);
+    ~ShmTransport() override;
+
+    ShmTransport(const ShmTransport&) = delete;
+    ShmTransport& operator=(const ShmTransport&) = delete;
+
+    /**
+     * @param address "host:port" of the process's network listener; the port (non-zero)
+     * names the rendezvous socket
+     */
+    std::error_code Listen(const std::string& address, TransportHandler handler) override;
+    std::string ListenAddress() const override;
+
+    /**
+     * @return host_unreachable if the address is not on this host, connection_refused if no
+     * process listens on its port
+     */
+    std::pair<std::shared_ptr<TransportConnection>, std::error_code> Connect(
+        const std::string& address,
+        TransportHandler handler) override;
+    void Stop() override;
+
+    /**
+     * @brief Number of open connections (accepted and connected).
+     */
+    std::size_t Connections() const;
+
+    /**
+     * @brief Whether the host of "host:port" names this machine (loopback, the host name,
+     * or an address of a local interface).
+     */
+    static bool IsLocalAddress(const std::string& address);
+
+private:
+    class IoThread;
+    class Connection;
+
+    std::size_t ring_bytes_;
+    std::size_t max_frame_size_;
+    std::unique_ptr<IoThread> io_;
+    std::atomic<bool> stopped_;
+
+    mutable std::mutex listen_mutex_;
+    int listen_fd_;
+    std::string listen_address_;
+    TransportHandler accept_handler_;
+
+    void Accept();
+    bool FinishAccept(int fd);  // False while the accepted socket's hello has not arrived
+};
+
+} // namespace remote
+} // namespace protoactor
+
+#endif // PROTOACTOR_REMOTE_SHM_TRANSPORT_H
@@ -0,0 +1,73 @@
+#ifndef PROTOACTOR_REMOTE_TCP_TRANSPORT_H
+#define PROTOACTOR_REMOTE_TCP_TRANSPORT_H
+
+#include "internal/remote/transport.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace protoactor {
+namespace remote {
+
+/**
+ * @brief TCP transport on epoll.
+ *
+ * Each frame is a 4-byte big-endian length followed by the payload. A few I/O threads each
+ * run an epoll loop; connections are spread over them round-robin and the listener lives on
+ * the first. Send writes inline from the caller's thread with writev (queued frames go out in
+ * one call) and only hands off to the I/O thread when the socket buffer is full, so an idle
+ * connection costs no thread switch per batch. Connect does not wait for the TCP handshake:
+ * the I/O thread completes it, frames sent meanwhile are queued, and a connect that fails
+ * or times out closes the connection (on_close).
+ */
+class TcpTransport : public Transport, public std::enable_shared_from_this<TcpTransport> {
+public:
+    /**
+     * @param io_threads Number of epoll threads (at least one)
+     * @param max_frame_size Larger inbound frames close the connection
+     * @param connect_timeout Time allowed for the TCP handshake, enforced on the I/O thread
+     */
+    explicit TcpTransport(
+        int io_threads = 2,
+        std::size_t max_frame_size = 64 * 1024 * 1024,
+        std::chrono::milliseconds connect_timeout = std::chrono::seconds(5));
+    ~TcpTransport() override;
+
+    TcpTransport(const TcpTransport&) = delete;
+    TcpTransport& operator=(const TcpTransport&) = delete;
+
+    std::error_code Listen(const std::string& address, TransportHandler handler) override;
+    std::string ListenAddress() const override;
+    std::pair<std::shared_ptr<TransportConnection>, std::error_code> Connect(
+        const std::string& address,
+        TransportHandler handler) override;
+    void Stop() override;
+
+private:
+    class IoThread;
+    class Connection;
+
+    std::size_t max_frame_size_;
+    std::chrono::milliseconds connect_timeout_;
+    std::vector<std::unique_ptr<IoThread>> threads_;
+    std::atomic<std::size_t> next_thread_;
+    std::atomic<bool> stopped_;
+
+    mutable std::mutex listen_mutex_;
+    int listen_fd_;
+    std::string listen_address_;
+    TransportHandler accept_handler_;
+
+    IoThread* NextThread();
+    void Accept();
+    void Register(int fd, TransportHandler handler, bool connecting, std::shared_ptr<Connection>* out);
+};
+
+} // namespace remote
+} // namespace protoactor
+
+#endif // PROTOACTOR_REMOTE_TCP_TRANSPORT_H
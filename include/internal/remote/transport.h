@@ -0,0 +1,94 @@
+#ifndef PROTOACTOR_REMOTE_TRANSPORT_H
+#define PROTOACTOR_REMOTE_TRANSPORT_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace protoactor {
+namespace remote {
+
+class TransportConnection;
+
+/**
+ * @brief Callbacks of a transport connection. Both run on a transport thread; frames of one
+ * connection are delivered in order, one at a time.
+ */
+struct TransportHandler {
+    // A complete frame; the handler may keep the buffer (e.g. as InboundBatch::owner)
+    std::function<void(const std::shared_ptr<TransportConnection>&, std::shared_ptr<std::string>)> on_frame;
+    // The connection closed (by either side); called once
+    std::function<void(const std::shared_ptr<TransportConnection>&)> on_close;
+};
+
+/**
+ * @brief One bidirectional, message-framed connection.
+ */
+class TransportConnection {
+public:
+    virtual ~TransportConnection() = default;
+
+    /**
+     * @brief Queue a frame. Frames are sent in order; thread-safe.
+     * @return not_connected once the connection is closed
+     */
+    virtual std::error_code Send(std::string frame) = 0;
+
+    /**
+     * @brief Close the connection; queued frames may be dropped.
+     */
+    virtual void Close() = 0;
+
+    virtual bool Closed() const = 0;
+
+    /**
+     * @brief Stop or resume reading inbound frames; thread-safe. Frames the transport has
+     * already read may still be delivered. While paused the peer's data backs up in the
+     * transport (socket buffer or ring), which eventually slows the sender.
+     */
+    virtual void PauseReading(bool paused) = 0;
+};
+
+/**
+ * @brief Byte transport underneath EndpointWriter (outbound) and the inbound service.
+ *
+ * Frames carry encoded RemoteMessages (see wire.h); the transport only moves them.
+ */
+class Transport {
+public:
+    virtual ~Transport() = default;
+
+    /**
+     * @brief Accept inbound connections.
+     * @param address "host:port"; port 0 picks a free port (see ListenAddress)
+     * @param handler Callbacks for every accepted connection
+     */
+    virtual std::error_code Listen(const std::string& address, TransportHandler handler) = 0;
+
+    /**
+     * @brief Address actually listened on, or empty if not listening.
+     */
+    virtual std::string ListenAddress() const = 0;
+
+    /**
+     * @brief Open a connection to a listening peer without blocking on the network.
+     *
+     * The connection may still be establishing when returned; frames sent meanwhile are
+     * queued, and if it cannot be established it is closed (on_close is called).
+     */
+    virtual std::pair<std::shared_ptr<TransportConnection>, std::error_code> Connect(
+        const std::string& address,
+        TransportHandler handler) = 0;
+
+    /**
+     * @brief Stop listening and close all connections.
+     */
+    virtual void Stop() = 0;
+};
+
+} // namespace remote
+} // namespace protoactor
+
+#endif // PROTOACTOR_REMOTE_TRANSPORT_H
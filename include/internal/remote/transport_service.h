@@ -0,0 +1,62 @@
+#ifndef PROTOACTOR_REMOTE_TRANSPORT_SERVICE_H
+#define PROTOACTOR_REMOTE_TRANSPORT_SERVICE_H
+
+#include "internal/remote/transport.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace protoactor {
+namespace remote {
+
+class Remote;
+class EndpointReader;
+class ConnectionDictionaryDecoder;
+
+namespace wire {
+struct ConnectRequest;
+struct MessageBatch;
+} // namespace wire
+
+/**
+ * @brief Inbound side of the native transports (the counterpart of GrpcService).
+ *
+ * Answers ConnectRequests and hands received batches to the shared EndpointReader. Each
+ * connection keeps its own dictionary; batches received before a successful handshake
+ * are dropped. While the reader is above its high-water mark every connection stops
+ * reading, so senders back up in the transport instead of in the reader's queues.
+ */
+class TransportService : public std::enable_shared_from_this<TransportService> {
+public:
+    explicit TransportService(std::shared_ptr<Remote> remote);
+    
+    /**
+     * @brief Callbacks to pass to Transport::Listen.
+     */
+    TransportHandler Handler();
+    
+    std::shared_ptr<EndpointReader> GetEndpointReader() const { return endpoint_reader_; }
+
+private:
+    struct Peer;
+    
+    std::shared_ptr<Remote> remote_;
+    std::shared_ptr<EndpointReader> endpoint_reader_;
+    std::mutex mutex_;
+    std::unordered_map<TransportConnection*, std::shared_ptr<Peer>> peers_;
+    
+    void OnFrame(const std::shared_ptr<TransportConnection>& connection, std::shared_ptr<std::string> frame);
+    void OnClose(const std::shared_ptr<TransportConnection>& connection);
+    void PauseReading(bool paused);
+    void HandleConnectRequest(
+        const std::shared_ptr<TransportConnection>& connection,
+        Peer& peer,
+        const wire::ConnectRequest& request);
+    bool HandleMessageBatch(Peer& peer, std::shared_ptr<std::string> frame, const wire::MessageBatch& batch);  // False if the dictionary bound is exceeded
+};
+
+} // namespace remote
+} // namespace protoactor
+
+#endif // PROTOACTOR_REMOTE_TRANSPORT_SERVICE_H
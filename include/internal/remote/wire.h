@@ -0,0 +1,234 @@
+#ifndef PROTOACTOR_REMOTE_WIRE_H
+#define PROTOACTOR_REMOTE_WIRE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace protoactor {
+namespace remote {
+namespace wire {
+
+/**
+ * @brief Minimal encoder for the protobuf wire format.
+ *
+ * Lets the native transports put RemoteMessage (proto/remote.proto) on the wire without
+ * linking libprotobuf; the output parses with the generated classes. Nested messages are
+ * written in place: Begin reserves a padded length and End patches it, so payloads are
+ * serialized straight into the frame.
+ */
+class ProtoWriter {
+public:
+    explicit ProtoWriter(std::string* out) : out_(out) {}
+
+    void Varint(uint32_t field, uint64_t value);
+    void Int32(uint32_t field, int32_t value);
+    void Bool(uint32_t field, bool value);
+    void Bytes(uint32_t field, std::string_view value);
+
+    /**
+     * @brief Start a length-delimited field whose contents are appended next.
+     * @return Mark to pass to End
+     */
+    std::size_t Begin(uint32_t field);
+
+    /**
+     * @brief Finish a field started with Begin. Small contents are moved back so the length
+     * takes its shortest form; large ones keep the padded length.
+     * @return Length of the contents
+     */
+    std::size_t End(std::size_t mark);
+
+    std::string* Buffer() const { return out_; }
+
+private:
+    std::string* out_;
+
+    void RawVarint(uint64_t value);
+};
+
+/**
+ * @brief Reader for the protobuf wire format. Views point into the input.
+ */
+class ProtoReader {
+public:
+    explicit ProtoReader(std::string_view in) : in_(in), pos_(0) {}
+
+    /**
+     * @brief Read the next field tag.
+     * @return false at the end of the input or on malformed input (see Ok)
+     */
+    bool Next(uint32_t* field, uint32_t* wire_type);
+    bool ReadVarint(uint64_t* value);
+    bool ReadBytes(std::string_view* value);
+    bool Skip(uint32_t wire_type);
+    bool Ok() const { return ok_; }
+
+private:
+    std::string_view in_;
+    std::size_t pos_;
+    bool ok_ = true;
+};
+
+/**
+ * @brief Decoded PID (proto/actor.proto).
+ */
+struct PID {
+    std::string_view address;
+    std::string_view id;
+    uint32_t request_id = 0;
+};
+
+/**
+ * @brief Decoded MessageEnvelope; message headers are not carried yet.
+ */
+struct Envelope {
+    int32_t type_id = 0;
+    std::string_view message_data;
+    int32_t target = 0;
+    int32_t sender = 0;
+    int32_t serializer_id = 0;
+    uint32_t target_request_id = 0;
+    uint32_t sender_request_id = 0;
+};
+
+/**
+ * @brief Batch compression codecs (CompressionCodec in proto/remote.proto).
+ */
+constexpr uint32_t kCompressionNone = 0;
+constexpr uint32_t kCompressionLz4 = 1;
+
+/**
+ * @brief Codec to answer a peer that asked for codec: the same one if it is known,
+ * otherwise none.
+ */
+uint32_t NegotiateCompression(uint32_t codec);
+
+/**
+ * @brief Decoded MessageBatch. A compressed batch only sets compression,
+ * uncompressed_size and compressed; see DecompressBatch.
+ */
+struct MessageBatch {
+    std::vector<std::string_view> type_names;
+    std::vector<std::string_view> targets;
+    std::vector<Envelope> envelopes;
+    std::vector<PID> senders;
+    bool dictionary_reset = false;
+    uint32_t compression = kCompressionNone;
+    uint64_t uncompressed_size = 0;
+    std::string_view compressed;
+};
+
+struct ConnectRequest {
+    bool server_connection = true;  // ServerConnection, otherwise ClientConnection
+    std::string member_id;
+    std::string address;
+    std::vector<std::string> block_list;
+    bool connection_dictionary = false;
+    uint32_t compression = kCompressionNone;  // Codec the sender would like to use
+};
+
+struct ConnectResponse {
+    std::string member_id;
+    bool blocked = false;
+    bool connection_dictionary = false;
+    uint32_t compression = kCompressionNone;  // Codec the sender may use; none otherwise
+};
+
+/**
+ * @brief Decoded RemoteMessage; only the member named by type is set.
+ */
+struct RemoteMessage {
+    enum class Type {
+        None,
+        MessageBatch,
+        ConnectRequest,
+        ConnectResponse,
+        DisconnectRequest
+    };
+
+    Type type = Type::None;
+    MessageBatch message_batch;
+    ConnectRequest connect_request;
+    ConnectResponse connect_response;
+};
+
+/**
+ * @brief Decode a RemoteMessage. Batch strings are views into frame.
+ * @return false if the frame is malformed
+ */
+bool Decode(std::string_view frame, RemoteMessage* message);
+
+void EncodeConnectRequest(const ConnectRequest& request, std::string* out);
+void EncodeConnectResponse(const ConnectResponse& response, std::string* out);
+void EncodeDisconnectRequest(std::string* out);
+
+/**
+ * @brief Compress the MessageBatch of a frame written by BatchEncoder.
+ * @param out Receives the compressed RemoteMessage; left unchanged if false is returned
+ * @return false if the codec is unknown, the frame holds no batch, or compressing would
+ * not make the frame smaller (the frame is then sent as it is)
+ */
+bool CompressBatch(std::string_view frame, uint32_t codec, std::string* out);
+
+/**
+ * @brief Decompress and decode a batch received with compression set.
+ * @param body Receives the decompressed batch; strings of decoded are views into it
+ * @return false on an unknown codec, a size above the limit, or a malformed payload
+ */
+bool DecompressBatch(const MessageBatch& batch, std::string* body, MessageBatch* decoded);
+
+/**
+ * @brief Writes a RemoteMessage holding a MessageBatch straight into a frame buffer.
+ *
+ * Dictionary entries can be added between envelopes (repeated fields keep their order
+ * wherever they appear). Payloads are serialized directly into the buffer returned by
+ * BeginEnvelope; AbortEnvelope drops a partially written envelope.
+ */
+class BatchEncoder {
+public:
+    explicit BatchEncoder(std::string* out);
+
+    void DictionaryReset();
+    void TypeName(std::string_view type_name);
+    void Target(std::string_view id);
+    void Sender(std::string_view address, std::string_view id);
+
+    /**
+     * @brief Start an envelope.
+     * @return Buffer to append the serialized payload to
+     */
+    std::string* BeginEnvelope();
+
+    /**
+     * @brief Finish the envelope started last.
+     * @param fields Envelope fields (message_data is ignored)
+     * @return Payload size
+     */
+    std::size_t EndEnvelope(const Envelope& fields);
+
+    void AbortEnvelope();
+
+    /**
+     * @brief Patch the batch length; the buffer then holds one complete RemoteMessage.
+     */
+    void Finish();
+
+    std::size_t Envelopes() const { return envelopes_; }
+
+private:
+    ProtoWriter writer_;
+    std::size_t message_mark_;
+    std::size_t envelope_start_;
+    std::size_t envelope_mark_;
+    std::size_t data_mark_;
+    std::size_t envelopes_;
+};
+
+} // namespace wire
+} // namespace remote
+} // namespace protoactor
+
+#endif // PROTOACTOR_REMOTE_WIRE_H
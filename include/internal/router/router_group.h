@@ -4,13 +4,23 @@
 #include "external/pid.h"
 #include "external/props.h"
 #include "external/context.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 
 namespace protoactor {
+
+class Dispatcher;
+class Mailbox;
+
 namespace router {
 
+class Router;
+
 /**
  * @brief RouterActorGroup manages a group of routee actors.
  */
@@ -95,6 +105,135 @@ public:
     RouterActorPool(std::shared_ptr<Context> context);
 };
 
+/**
+ * @brief Scaling policy of an ElasticRouterActorPool.
+ *
+ * The pool grows when the average mailbox depth per routee reaches scale_up_depth, or the
+ * mean processing time per message reaches scale_up_latency; it shrinks when both are
+ * below the scale-down thresholds. The gap between the thresholds, the stable_checks
+ * consecutive observations and the cooldown after a resize provide hysteresis.
+ */
+class ElasticPoolConfig {
+public:
+    int min_routees;
+    int max_routees;
+    double scale_up_depth;                        // Average depth per routee; <= 0 disables
+    double scale_down_depth;
+    std::chrono::microseconds scale_up_latency;   // Mean processing time; 0 disables
+    std::chrono::microseconds scale_down_latency;
+    int stable_checks;                            // Consecutive checks before resizing
+    int cooldown_checks;                          // Checks skipped after a resize
+    double grow_ratio;                            // Growth step as a fraction of the pool (at least 1)
+    std::chrono::milliseconds check_interval;     // 0 disables the periodic check
+    
+    ElasticPoolConfig();
+};
+
+/**
+ * @brief Routee pool that resizes between min and max routees on backlog or latency.
+ *
+ * The pool samples its routees on the system timer wheel every check_interval. The wheel
+ * only takes the scaling decision; the resize itself is posted to the owning actor (as a
+ * system message, so it runs on the owner's mailbox) or, for a root context, to a
+ * dispatcher, so spawning and poisoning never run on the wheel thread. Routees
+ * are spawned from routee_props with an extra receiver middleware that measures processing
+ * time. On every resize the attached routers get the new routee list (routers publish it as
+ * an immutable snapshot); removed routees are poisoned after they were taken out of
+ * routing, so messages already queued are still processed.
+ */
+class ElasticRouterActorPool : public std::enable_shared_from_this<ElasticRouterActorPool> {
+public:
+    /**
+     * @brief Create an elastic pool with min_routees routees and start periodic checks.
+     * @param context Context used to spawn and stop routees
+     * @param routee_props Props for routee actors
+     * @param config Scaling policy
+     * @return Elastic pool
+     */
+    static std::shared_ptr<ElasticRouterActorPool> New(
+        std::shared_ptr<Context> context,
+        std::shared_ptr<Props> routee_props,
+        const ElasticPoolConfig& config = ElasticPoolConfig());
+    
+    /**
+     * @brief Get all routee PIDs.
+     */
+    std::vector<std::shared_ptr<PID>> GetRoutees() const;
+    
+    /**
+     * @brief Keep a router's routees in sync with the pool (set immediately and on resize).
+     */
+    void AttachRouter(std::shared_ptr<Router> router);
+    
+    /**
+     * @brief Run one scaling check and apply it on the calling thread.
+     * Call from the owner's thread when the pool is owned by an actor.
+     * @return New routee count
+     */
+    int Evaluate();
+    
+    /**
+     * @brief Average user mailbox depth per routee.
+     */
+    double AverageDepth() const;
+    
+    /**
+     * @brief Mean processing time per message since the previous check.
+     */
+    std::chrono::microseconds MeanLatency() const;
+    
+    /**
+     * @brief Stop the periodic checks and all routees.
+     */
+    void Stop();
+
+private:
+    struct Routee {
+        std::shared_ptr<PID> pid;
+        std::weak_ptr<Mailbox> mailbox;
+    };
+    
+    // Shared with the timing middleware, which may outlive the pool
+    struct LatencyStats {
+        std::atomic<uint64_t> total_us{0};
+        std::atomic<uint64_t> messages{0};
+    };
+    
+    std::shared_ptr<Context> context_;
+    std::shared_ptr<Props> props_;
+    ElasticPoolConfig config_;
+    std::shared_ptr<LatencyStats> latency_;
+    std::shared_ptr<Dispatcher> dispatcher_;      // Runs resizes when there is no owner actor
+    
+    mutable std::mutex mutex_;
+    std::vector<Routee> routees_;
+    std::vector<std::weak_ptr<Router>> routers_;
+    int up_streak_ = 0;
+    int down_streak_ = 0;
+    int cooldown_ = 0;
+    std::chrono::microseconds last_latency_{0};
+    bool stopped_ = false;
+    
+    // Scaling decision from the current sample: routees to add (> 0) or remove (< 0)
+    int Decide();
+    // Apply a decision; spawns and poisons without holding mutex_
+    int Resize(int delta);
+    std::vector<Routee> SpawnRoutees(int count);
+    void PostResize(int delta);
+    void ScheduleCheck();
+    
+    // Requires mutex_ held
+    std::vector<std::shared_ptr<PID>> Shrink(int count);
+    std::vector<std::shared_ptr<PID>> Pids() const;
+    void PublishToRouters(const std::vector<std::shared_ptr<PID>>& pids);
+    
+public:
+    ElasticRouterActorPool(
+        std::shared_ptr<Context> context,
+        std::shared_ptr<Props> routee_props,
+        const ElasticPoolConfig& config);
+};
+
 } // namespace router
 } // namespace protoactor
 
@@ -0,0 +1,104 @@
+#ifndef PROTOACTOR_SCHEDULER_TIMER_WHEEL_H
+#define PROTOACTOR_SCHEDULER_TIMER_WHEEL_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace protoactor {
+namespace scheduler {
+
+/**
+ * @brief Hashed timer wheel shared by many timers on a single thread.
+ *
+ * Time is measured in ticks. CurrentTick() is a coarse clock that costs one atomic load,
+ * so callers can maintain deadlines without reading the system clock. Callbacks run on
+ * the wheel thread and must be short; a callback may reschedule itself (this is how lazy
+ * deadlines are implemented: the entry checks the deadline when it fires and reschedules
+ * if the deadline moved).
+ *
+ * Must be owned by a shared_ptr: the wheel thread keeps the wheel alive until Stop().
+ */
+class TimerWheel : public std::enable_shared_from_this<TimerWheel> {
+public:
+    using Callback = std::function<void()>;
+
+    /**
+     * @brief Create a timer wheel. The wheel thread starts on the first ScheduleAt.
+     * @param tick Tick duration (timer resolution)
+     * @param slots Number of slots; deadlines beyond one revolution wrap around
+     */
+    explicit TimerWheel(
+        std::chrono::milliseconds tick = std::chrono::milliseconds(10),
+        std::size_t slots = 512);
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * @brief Current tick (coarse clock).
+     */
+    std::uint64_t CurrentTick() const {
+        return current_tick_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Number of ticks covering a duration (rounded up, at least one).
+     */
+    std::uint64_t TicksFor(std::chrono::milliseconds duration) const;
+
+    /**
+     * @brief Run a callback at the given tick (or on the next tick if it already passed).
+     * @param tick Target tick
+     * @param callback Callback to run on the wheel thread
+     */
+    void ScheduleAt(std::uint64_t tick, Callback callback);
+
+    /**
+     * @brief Number of scheduled callbacks that have not run yet.
+     */
+    std::size_t Pending() const {
+        return pending_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Stop the wheel thread. Pending callbacks are dropped.
+     * Called by ActorSystem::Shutdown for the system wheel.
+     */
+    void Stop();
+
+private:
+    struct Entry {
+        std::uint64_t tick;
+        Callback callback;
+    };
+
+    struct Slot {
+        std::mutex mutex;
+        std::vector<Entry> entries;
+    };
+
+    std::chrono::milliseconds tick_;
+    std::vector<Slot> slots_;
+    std::atomic<std::uint64_t> current_tick_;
+    std::atomic<std::size_t> pending_;
+    std::atomic<bool> running_;
+    std::atomic<bool> stopped_;
+    std::once_flag start_once_;
+    std::thread thread_;
+
+    void EnsureStarted();
+    void Run();
+    void Advance(std::uint64_t tick);
+};
+
+} // namespace scheduler
+} // namespace protoactor
+
+#endif // PROTOACTOR_SCHEDULER_TIMER_WHEEL_H
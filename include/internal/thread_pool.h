@@ -15,7 +15,7 @@ namespace protoactor {
  * - Thread-safe unbounded task queue.
  * - Exception isolation: task exceptions do not terminate workers.
  * - Graceful shutdown: drains pending tasks then joins workers.
- * - Process exit: default pool (DefaultThreadPool()) is shut down via atexit.
+ * - Process exit: default pool (DefaultThreadPool()) is never destroyed; its workers end with the process.
  * - Unbounded queue: Submit() never blocks; consider backpressure at application level if needed.
  * - Non-copyable, non-movable.
  */
@@ -6,13 +6,24 @@
 #include "external/supervision.h"
 #include "internal/actor/captured_context.h"
 #include "internal/actor/new_pid.h"
-#include "internal/scheduler/timer.h"
+#include "internal/actor/scatter_gather.h"
+#include "internal/scheduler/timer_wheel.h"
 #include "internal/actor/deadletter.h" // Include DeadLetterProcess header
 #include <stdexcept>
 #include <algorithm>
 
 namespace protoactor {
 
+namespace {
+
+// Single shared instance so the wheel-sent timeout can be recognised by pointer
+const std::shared_ptr<void>& ReceiveTimeoutMessage() {
+    static const std::shared_ptr<void> message = std::make_shared<protoactor::ReceiveTimeout>();
+    return message;
+}
+
+} // namespace
+
 ActorContext::ActorContext(
     std::shared_ptr<ActorSystem> actor_system,
     std::shared_ptr<Props> props,
@@ -21,6 +32,11 @@ ActorContext::ActorContext(
       props_(props),
       parent_(parent),
       receive_timeout_(std::chrono::milliseconds(0)),
+      receive_timeout_ticks_(0),
+      receive_deadline_(0),
+      receive_timeout_armed_(false),
+      receive_timeout_generation_(0),
+      receive_timeout_entry_tick_(0),
       state_(STATE_ALIVE) {
     IncarnateActor();
 }
@@ -85,10 +101,8 @@ void ActorContext::SendUserMessage(std::shared_ptr<PID> pid, std::shared_ptr<voi
         return;
     }
     
-    // Wrap message in envelope if needed
-    // Since message is void*, we can't use dynamic_cast
-    // For now, always create a new envelope
-    std::shared_ptr<MessageEnvelope> envelope = std::make_shared<MessageEnvelope>(nullptr, message, nullptr);
+    // Wrap message in envelope if needed (Request/RequestFuture already built one carrying the sender)
+    std::shared_ptr<MessageEnvelope> envelope = WrapEnvelope(message);
     
     // Use sender middleware chain if available
     if (props_ && props_->sender_middleware_chain_) {
@@ -121,6 +135,20 @@ std::shared_ptr<Future> ActorContext::RequestFuture(
     return future;
 }
 
+std::shared_ptr<Future> ActorContext::RequestScatterGather(
+    const std::vector<std::shared_ptr<PID>>& pids,
+    std::shared_ptr<void> message,
+    std::chrono::milliseconds timeout,
+    GatherMode mode,
+    int quorum) {
+    auto gather = ScatterGatherFuture::New(actor_system_, pids, mode, quorum, timeout);
+    auto self = shared_from_this();
+    gather->Scatter(message, [self](std::shared_ptr<PID> pid, std::shared_ptr<MessageEnvelope> env) {
+        self->SendUserMessage(pid, env);
+    });
+    return gather;
+}
+
 std::chrono::milliseconds ActorContext::ReceiveTimeout() {
     return receive_timeout_;
 }
@@ -189,42 +217,96 @@ void ActorContext::SetReceiveTimeout(std::chrono::milliseconds timeout) {
         return;
     }
     
-    receive_timeout_ = timeout;
-    auto extras = EnsureExtras();
+    if (timeout.count() == 0) {
+        CancelReceiveTimeout();
+        return;
+    }
     
-    // Cancel existing timer if any
-    if (extras->receive_timeout_timer_) {
-        auto& cancel_func = *extras->receive_timeout_timer_;
-        if (cancel_func) {
-            cancel_func();
-        }
-        extras->receive_timeout_timer_.reset();
+    if (!timer_wheel_) {
+        timer_wheel_ = actor_system_->GetTimerWheel();
     }
+    receive_timeout_ = timeout;
+    receive_timeout_ticks_ = timer_wheel_->TicksFor(timeout);
     
-    // Setup new timer if timeout > 0
-    if (timeout.count() > 0) {
-        auto ctx = std::static_pointer_cast<protoactor::Context>(shared_from_this());
-        auto timer_scheduler = protoactor::scheduler::TimerScheduler::New(ctx);
-        auto timeout_msg = std::make_shared<protoactor::ReceiveTimeout>();
-        auto cancel = timer_scheduler->SendOnce(timeout, self_, timeout_msg);
-        extras->receive_timeout_timer_ = std::make_shared<protoactor::scheduler::CancelFunc>(std::move(cancel));
+    // A pending entry follows the deadline when it fires, so it only has to be replaced
+    // when the new deadline comes before it
+    auto deadline = timer_wheel_->CurrentTick() + receive_timeout_ticks_;
+    receive_deadline_.store(deadline);
+    if (!receive_timeout_armed_.exchange(true) || deadline < receive_timeout_entry_tick_.load()) {
+        ScheduleReceiveTimeout(deadline);
     }
 }
 
 void ActorContext::CancelReceiveTimeout() {
-    if (!extras_) {
+    // A pending wheel entry sees the cleared deadline and drops itself
+    receive_timeout_ = std::chrono::milliseconds(0);
+    receive_timeout_ticks_ = 0;
+    receive_deadline_.store(0);
+}
+
+void ActorContext::ResetReceiveTimeout() {
+    // Hot path: one store; the wheel is only touched if no entry is pending
+    auto deadline = timer_wheel_->CurrentTick() + receive_timeout_ticks_;
+    receive_deadline_.store(deadline);
+    if (!receive_timeout_armed_.load() && !receive_timeout_armed_.exchange(true)) {
+        ScheduleReceiveTimeout(deadline);
+    }
+}
+
+void ActorContext::ScheduleReceiveTimeout(std::uint64_t tick) {
+    // A new entry supersedes every pending one
+    RescheduleReceiveTimeout(tick, receive_timeout_generation_.fetch_add(1) + 1);
+}
+
+void ActorContext::RescheduleReceiveTimeout(std::uint64_t tick, std::uint64_t generation) {
+    receive_timeout_entry_tick_.store(tick);
+    std::weak_ptr<ActorContext> weak = shared_from_this();
+    timer_wheel_->ScheduleAt(tick, [weak, generation]() {
+        OnReceiveTimeoutTick(weak, generation);
+    });
+}
+
+void ActorContext::OnReceiveTimeoutTick(const std::weak_ptr<ActorContext>& weak, std::uint64_t generation) {
+    auto ctx = weak.lock();
+    if (!ctx || ctx->receive_timeout_generation_.load() != generation) {
+        // Gone, or superseded by an entry for an earlier deadline
         return;
     }
     
-    if (extras_->receive_timeout_timer_) {
-        auto& cancel_func = *extras_->receive_timeout_timer_;
-        if (cancel_func) {
-            cancel_func();
+    auto deadline = ctx->receive_deadline_.load();
+    if (deadline == 0) {
+        // Disabled: disarm, unless it was re-enabled meanwhile and we win the re-arm
+        ctx->receive_timeout_armed_.store(false);
+        deadline = ctx->receive_deadline_.load();
+        if (deadline == 0 || ctx->receive_timeout_armed_.exchange(true)) {
+            return;
         }
-        extras_->receive_timeout_timer_.reset();
     }
     
-    receive_timeout_ = std::chrono::milliseconds(0);
+    if (deadline > ctx->timer_wheel_->CurrentTick()) {
+        // Messages arrived since this entry was scheduled: follow the deadline
+        ctx->RescheduleReceiveTimeout(deadline, generation);
+        return;
+    }
+    
+    if (!ctx->receive_deadline_.compare_exchange_strong(deadline, 0)) {
+        // Refreshed or cancelled concurrently; look again on the next tick
+        ctx->RescheduleReceiveTimeout(ctx->timer_wheel_->CurrentTick() + 1, generation);
+        return;
+    }
+    
+    // Expired. Disarm; the next user message re-arms. Recheck for a message that stored
+    // a deadline while we were still armed.
+    ctx->receive_timeout_armed_.store(false);
+    auto next = ctx->receive_deadline_.load();
+    if (next != 0 && !ctx->receive_timeout_armed_.exchange(true)) {
+        ctx->ScheduleReceiveTimeout(next);
+    }
+    
+    if (ctx->state_.load(std::memory_order_acquire) >= STATE_STOPPING || !ctx->self_) {
+        return;
+    }
+    ctx->self_->SendUserMessage(ctx->actor_system_, ReceiveTimeoutMessage());
 }
 
 void ActorContext::Forward(std::shared_ptr<PID> pid) {
@@ -239,16 +321,22 @@ void ActorContext::Forward(std::shared_ptr<PID> pid) {
 void ActorContext::ReenterAfter(
     std::shared_ptr<Future> future,
     std::function<void(std::shared_ptr<void>, std::error_code)> continuation) {
+    if (!future) {
+        return;
+    }
+    
     // Store current message
     auto msg = message_or_envelope_;
+    auto self = self_;
+    auto actor_system = actor_system_;
     
-    // Create continuation message
-    auto cont_msg = std::make_shared<Continuation>(continuation, msg);
-    
-    // Set up future continuation to send continuation message to self
-    future->ContinueWith([this, cont_msg](std::shared_ptr<void> res, std::error_code err) {
-        // Send continuation message to self
-        self_->SendSystemMessage(actor_system_, cont_msg);
+    // Set up future continuation to send continuation message to self, carrying the
+    // future's result so the continuation runs on this actor's mailbox
+    future->ContinueWith([self, actor_system, continuation, msg](std::shared_ptr<void> res, std::error_code err) {
+        auto cont_msg = std::make_shared<Continuation>(continuation, msg);
+        cont_msg->result = res;
+        cont_msg->err = err;
+        self->SendSystemMessage(actor_system, cont_msg);
     });
 }
 
@@ -329,8 +417,12 @@ void ActorContext::InvokeUserMessage(std::shared_ptr<void> message) {
         return;
     }
     
-    // Simplified - would handle receive timeout in real implementation
     ProcessMessage(message);
+    
+    // Any message except the timeout itself pushes the receive timeout deadline out
+    if (receive_timeout_ticks_ > 0 && message.get() != ReceiveTimeoutMessage().get()) {
+        ResetReceiveTimeout();
+    }
 }
 
 void ActorContext::ProcessMessage(std::shared_ptr<void> message) {
@@ -437,6 +529,13 @@ void ActorContext::InvokeSystemMessage(std::shared_ptr<void> message) {
         HandleContinuation(continuation);
         return;
     }
+
+    // Try PriorityMessage
+    auto priority = std::dynamic_pointer_cast<protoactor::PriorityMessage>(sys_msg);
+    if (priority && state_.load(std::memory_order_acquire) == STATE_ALIVE) {
+        ProcessMessage(message);
+        return;
+    }
 }
 
 void ActorContext::HandleWatch(std::shared_ptr<protoactor::Watch> msg) {
@@ -461,6 +560,7 @@ void ActorContext::HandleUnwatch(std::shared_ptr<protoactor::Unwatch> msg) {
 
 void ActorContext::HandleStop() {
     state_.store(STATE_STOPPING, std::memory_order_release);
+    CancelReceiveTimeout();
     // Send Stopping message
     // Stop children
     // Send Stopped message
@@ -517,13 +617,7 @@ void ActorContext::HandleContinuation(std::shared_ptr<Continuation> msg) {
     // Restore message context
     message_or_envelope_ = msg->message;
     
-    // Get future result (would be passed in continuation message in full implementation)
-    // For now, call continuation with empty result
-    std::shared_ptr<void> result = nullptr;
-    std::error_code err;
-    
-    // In full implementation, the continuation message would contain the future result
-    msg->continuation(result, err);
+    msg->continuation(msg->result, msg->err);
     
     // Clear message context
     message_or_envelope_ = nullptr;
@@ -540,12 +634,4 @@ void ActorContext::SetSelf(std::shared_ptr<PID> self) {
     self_ = self;
 }
 
-void ActorContext::ReceiveTimeoutHandler() {
-    if (receive_timeout_.count() > 0) {
-        CancelReceiveTimeout();
-        auto timeout_msg = std::make_shared<protoactor::ReceiveTimeout>();
-        Send(self_, timeout_msg);
-    }
-}
-
 } // namespace protoactor
@@ -7,6 +7,7 @@
 #include "internal/actor/guardian.h"
 #include "external/extensions.h"
 #include "external/config.h"
+#include "internal/scheduler/timer_wheel.h"
 #include <sstream>
 #include <random>
 #include <iomanip>
@@ -47,6 +48,7 @@ void ActorSystem::Initialize(std::shared_ptr<Config> config) {
     guardians_ = Guardians::New(shared_from_this());
     dead_letter_ = DeadLetterProcess::New(shared_from_this());
     extensions_ = Extensions::New();
+    timer_wheel_ = std::make_shared<scheduler::TimerWheel>();
     
     // Register event stream process
     // This would be done in a real implementation
@@ -72,6 +74,14 @@ std::shared_ptr<Extensions> ActorSystem::GetExtensions() const {
     return extensions_;
 }
 
+std::shared_ptr<scheduler::TimerWheel> ActorSystem::GetTimerWheel() const {
+    return timer_wheel_;
+}
+
+std::shared_ptr<Config> ActorSystem::GetConfig() const {
+    return config_;
+}
+
 std::string ActorSystem::GetID() const {
     return id_;
 }
@@ -87,6 +97,10 @@ std::shared_ptr<PID> ActorSystem::NewLocalPID(const std::string& id) {
 void ActorSystem::Shutdown() {
     stopped_.store(true);
 
+    if (timer_wheel_) {
+        timer_wheel_->Stop();
+    }
+
     // Clear process registry
     if (process_registry_) {
         process_registry_->Clear();
@@ -4,12 +4,119 @@
 #include "external/eventstream.h"
 #include "external/messages.h"
 #include "external/pid.h"
+#include "external/config.h"
+#include "internal/scheduler/timer_wheel.h"
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <sstream>
+#include <utility>
+#include <vector>
 
 namespace protoactor {
 
+namespace {
+
+constexpr std::size_t SUMMARY_TOP_TARGETS = 5;
+
+uint64_t TargetHash(const std::shared_ptr<PID>& target) {
+    if (!target) {
+        return 1;
+    }
+    std::hash<std::string> hasher;
+    uint64_t h = hasher(target->address) * 1000003ULL ^ hasher(target->id);
+    return h == 0 ? 1 : h;
+}
+
+std::string TargetName(const std::shared_ptr<PID>& target) {
+    if (!target) {
+        return "null";
+    }
+    return target->address.empty() ? target->id : target->address + "/" + target->id;
+}
+
+} // namespace
+
+DeadLetterThrottle::DeadLetterThrottle(int count)
+    : count_(count > 0 ? static_cast<uint64_t>(count) : 0) {
+}
+
+bool DeadLetterThrottle::Record(const std::shared_ptr<PID>& target, bool& first_in_window) {
+    total_.fetch_add(1, std::memory_order_relaxed);
+    CountTarget(target);
+    
+    uint64_t n = window_.fetch_add(1, std::memory_order_acq_rel);
+    first_in_window = n == 0;
+    if (n < count_) {
+        sampled_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    suppressed_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void DeadLetterThrottle::CountTarget(const std::shared_ptr<PID>& target) {
+    uint64_t h = TargetHash(target);
+    for (std::size_t i = 0; i < PROBES; ++i) {
+        Slot& slot = slots_[(h + i) % SLOTS];
+        uint64_t current = slot.hash.load(std::memory_order_acquire);
+        if (current == 0 && slot.hash.compare_exchange_strong(current, h, std::memory_order_acq_rel)) {
+            // Claimed: publish the name once, later windows reuse the slot
+            slot.target = TargetName(target);
+            slot.ready.store(true, std::memory_order_release);
+            slot.count.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (current == h) {
+            slot.count.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    overflow_.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string DeadLetterThrottle::Flush(std::chrono::milliseconds interval) {
+    uint64_t window = window_.exchange(0, std::memory_order_acq_rel);
+    
+    std::vector<std::pair<uint64_t, const std::string*>> targets;
+    for (auto& slot : slots_) {
+        if (!slot.ready.load(std::memory_order_acquire)) {
+            continue;
+        }
+        uint64_t n = slot.count.exchange(0, std::memory_order_relaxed);
+        if (n > 0) {
+            targets.emplace_back(n, &slot.target);
+        }
+    }
+    uint64_t other = overflow_.exchange(0, std::memory_order_relaxed);
+    
+    if (window <= count_) {
+        return std::string();
+    }
+    
+    std::sort(targets.begin(), targets.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    std::ostringstream out;
+    out << "[DeadLetter] throttled " << (window - count_) << " of " << window
+        << " dead letters in " << interval.count() << "ms; top targets:";
+    for (std::size_t i = 0; i < targets.size() && i < SUMMARY_TOP_TARGETS; ++i) {
+        out << " " << *targets[i].second << "=" << targets[i].first;
+    }
+    if (other > 0) {
+        out << " (other)=" << other;
+    }
+    out << "\n";
+    return out.str();
+}
+
 DeadLetterProcess::DeadLetterProcess(std::shared_ptr<ActorSystem> actor_system)
     : actor_system_(actor_system) {
+    auto config = actor_system_->GetConfig();
+    if (!config) {
+        config = Config::Default();
+    }
+    throttle_.reset(new DeadLetterThrottle(config->dead_letter_throttle_count));
+    throttle_interval_ = std::max(config->dead_letter_throttle_interval, std::chrono::milliseconds(1));
+    request_logging_ = config->dead_letter_request_logging;
 }
 
 std::shared_ptr<DeadLetterProcess> DeadLetterProcess::New(std::shared_ptr<ActorSystem> actor_system) {
@@ -23,45 +130,65 @@ void DeadLetterProcess::Initialize() {
     auto self = std::static_pointer_cast<DeadLetterProcess>(shared_from_this());
     actor_system_->GetProcessRegistry()->Add(self, "deadletter");
     
-    // Subscribe to dead letter events
+    // Output goes through a private stream drained on the default dispatcher: a burst of
+    // dead letters only enqueues lines (or drops them when the writer falls behind)
+    log_ = eventstream::EventStream::New();
+    log_->SubscribeAsync<std::string>([](std::shared_ptr<std::string> line) {
+        std::cout << *line << std::flush;
+    });
+    
+    // Subscribe to dead letter events (typed: other events never reach this handler)
     auto event_stream = actor_system_->GetEventStream();
-    event_stream->Subscribe([this](std::shared_ptr<void> msg) {
-        // Cast to DeadLetterEvent (assuming msg is DeadLetterEvent*)
-        auto dead_letter = std::static_pointer_cast<DeadLetterEvent>(msg);
-        if (dead_letter) {
-            // Send back a response instead of timeout
-            if (dead_letter->sender) {
-                auto response = std::make_shared<DeadLetterResponse>(dead_letter->pid);
-                actor_system_->GetRoot()->Send(dead_letter->sender, response);
-            }
-            
-            // Log dead letter (simplified - no throttling for now)
-            std::cout << "[DeadLetter] pid=" << (dead_letter->pid ? dead_letter->pid->id : "null")
-                      << " message=" << dead_letter->message.get()
-                      << " sender=" << (dead_letter->sender ? dead_letter->sender->id : "null")
-                      << std::endl;
-        }
+    event_stream->Subscribe<DeadLetterEvent>([this](std::shared_ptr<DeadLetterEvent> dead_letter) {
+        OnDeadLetter(dead_letter);
     });
+}
+
+void DeadLetterProcess::OnDeadLetter(const std::shared_ptr<DeadLetterEvent>& dead_letter) {
+    // Send back a response instead of timeout
+    if (dead_letter->sender) {
+        auto response = std::make_shared<DeadLetterResponse>(dead_letter->pid);
+        actor_system_->GetRoot()->Send(dead_letter->sender, response);
+    }
+    
+    bool first_in_window = false;
+    bool sampled = throttle_->Record(dead_letter->pid, first_in_window);
+    if (first_in_window) {
+        ArmThrottleTimer();
+    }
+    if (!sampled || (dead_letter->sender && !request_logging_)) {
+        return;
+    }
     
-    // Handle Watch messages for stopped actors
-    event_stream->Subscribe([this](std::shared_ptr<void> msg) {
-        auto dead_letter = std::static_pointer_cast<DeadLetterEvent>(msg);
-        if (dead_letter && dead_letter->message) {
-            // Try to cast message to Watch
-            // Note: This is unsafe but necessary for now
-            // In a full implementation, we would use type information
-            auto watch_msg = std::static_pointer_cast<Watch>(dead_letter->message);
-            if (watch_msg && watch_msg->watcher) {
-                // Send Terminated message back
-                auto terminated = std::make_shared<Terminated>(
-                    dead_letter->pid,
-                    Terminated::Reason::Stopped);
-                watch_msg->watcher->SendSystemMessage(actor_system_, terminated);
-            }
+    // One line per sampled event; suppressed ones show up in the window summary
+    std::ostringstream out;
+    out << "[DeadLetter] pid=" << (dead_letter->pid ? dead_letter->pid->id : "null")
+        << " message=" << dead_letter->message.get()
+        << " sender=" << (dead_letter->sender ? dead_letter->sender->id : "null")
+        << "\n";
+    log_->Publish(std::make_shared<std::string>(out.str()));
+}
+
+void DeadLetterProcess::ArmThrottleTimer() {
+    auto wheel = actor_system_->GetTimerWheel();
+    if (!wheel) {
+        return;
+    }
+    std::weak_ptr<DeadLetterProcess> weak_self = shared_from_this();
+    wheel->ScheduleAt(wheel->CurrentTick() + wheel->TicksFor(throttle_interval_), [weak_self]() {
+        if (auto self = weak_self.lock()) {
+            self->ReportThrottled();
         }
     });
 }
 
+void DeadLetterProcess::ReportThrottled() {
+    auto summary = throttle_->Flush(throttle_interval_);
+    if (!summary.empty()) {
+        log_->Publish(std::make_shared<std::string>(std::move(summary)));
+    }
+}
+
 void DeadLetterProcess::SendUserMessage(std::shared_ptr<PID> pid, std::shared_ptr<void> message) {
     auto [header, msg, sender] = UnwrapEnvelope(message);
     
@@ -70,6 +197,16 @@ void DeadLetterProcess::SendUserMessage(std::shared_ptr<PID> pid, std::shared_pt
 }
 
 void DeadLetterProcess::SendSystemMessage(std::shared_ptr<PID> pid, std::shared_ptr<void> message) {
+    // Watching a stopped actor: reply Terminated right away. Only system messages can be a
+    // Watch, so the cast is checked here rather than on every dead letter.
+    if (message) {
+        auto watch_msg = std::dynamic_pointer_cast<Watch>(std::static_pointer_cast<SystemMessage>(message));
+        if (watch_msg && watch_msg->watcher) {
+            auto terminated = std::make_shared<Terminated>(pid, Terminated::Reason::Stopped);
+            watch_msg->watcher->SendSystemMessage(actor_system_, terminated);
+        }
+    }
+    
     auto event = std::make_shared<DeadLetterEvent>(pid, message, nullptr);
     actor_system_->GetEventStream()->Publish(event);
 }
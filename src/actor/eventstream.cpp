@@ -1,11 +1,109 @@
 #include "external/eventstream.h"
+#include "external/dispatcher.h"
 #include <algorithm>
+#include <exception>
+#include <iostream>
 
 namespace protoactor {
 namespace eventstream {
 
-Subscription::Subscription(Handler handler)
-    : id_(0), handler_(handler), active_(1) {
+namespace {
+
+constexpr int DEFAULT_DRAIN_THROUGHPUT = 300;
+
+/**
+ * Bounded lock-free multi-producer queue (Vyukov). Push fails instead of blocking when full.
+ */
+class BoundedEventQueue {
+public:
+    explicit BoundedEventQueue(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask_ = size - 1;
+        cells_.reset(new Cell[size]);
+        for (std::size_t i = 0; i < size; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        enqueue_pos_.store(0, std::memory_order_relaxed);
+        dequeue_pos_.store(0, std::memory_order_relaxed);
+    }
+
+    bool TryPush(const std::shared_ptr<void>& evt) {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells_[pos & mask_];
+            std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.data = evt;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool TryPop(std::shared_ptr<void>& evt) {
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells_[pos & mask_];
+            std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    evt = std::move(cell.data);
+                    cell.data.reset();
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Empty
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool Empty() const {
+        return enqueue_pos_.load(std::memory_order_acquire) == dequeue_pos_.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        std::shared_ptr<void> data;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_;
+    alignas(64) std::atomic<std::size_t> enqueue_pos_;
+    alignas(64) std::atomic<std::size_t> dequeue_pos_;
+};
+
+} // namespace
+
+/**
+ * Per-subscriber state of an asynchronous subscription.
+ */
+struct AsyncDelivery {
+    AsyncDelivery(std::shared_ptr<Dispatcher> d, std::size_t capacity)
+        : queue(capacity), dispatcher(std::move(d)), scheduled(false), dropped(0) {}
+
+    BoundedEventQueue queue;
+    std::shared_ptr<Dispatcher> dispatcher;
+    std::atomic<bool> scheduled;   // A drain is queued on the dispatcher
+    std::atomic<uint64_t> dropped;
+};
+
+Subscription::Subscription(Handler handler, Predicate predicate)
+    : id_(0), handler_(std::move(handler)), predicate_(std::move(predicate)), active_(1) {
 }
 
 bool Subscription::Activate() {
@@ -22,8 +120,80 @@ bool Subscription::IsActive() const {
     return active_.load() == 1;
 }
 
+bool Subscription::IsAsync() const {
+    return async_ != nullptr;
+}
+
+uint64_t Subscription::Dropped() const {
+    return async_ ? async_->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+void Subscription::Deliver(const std::shared_ptr<void>& evt) const {
+    // A subscription removed after the snapshot was taken is skipped
+    if (!IsActive()) {
+        return;
+    }
+    if (predicate_ && !predicate_(evt)) {
+        return;
+    }
+    if (!async_) {
+        handler_(evt);
+        return;
+    }
+    
+    // Asynchronous: enqueue or drop, never block the publisher
+    if (!async_->queue.TryPush(evt)) {
+        async_->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (!async_->scheduled.exchange(true, std::memory_order_acq_rel)) {
+        auto self = shared_from_this();
+        async_->dispatcher->Schedule([self]() { self->Drain(); });
+    }
+}
+
+void Subscription::Drain() const {
+    int throughput = async_->dispatcher->Throughput();
+    int budget = throughput > 0 ? throughput : DEFAULT_DRAIN_THROUGHPUT;
+    std::shared_ptr<void> evt;
+    while (budget-- > 0 && async_->queue.TryPop(evt)) {
+        if (!IsActive()) {
+            continue;
+        }
+        try {
+            handler_(evt);
+        } catch (const std::exception& e) {
+            std::cerr << "EventStream subscriber exception: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "EventStream subscriber unknown exception" << std::endl;
+        }
+    }
+    
+    // Same handoff as the mailbox: release, then reschedule if events arrived meanwhile
+    async_->scheduled.store(false, std::memory_order_release);
+    if (!async_->queue.Empty() && !async_->scheduled.exchange(true, std::memory_order_acq_rel)) {
+        auto self = shared_from_this();
+        async_->dispatcher->Schedule([self]() { self->Drain(); });
+    }
+}
+
 EventStream::EventStream()
-    : counter_(0) {
+    : current_(std::make_unique<const Snapshot>()),
+      snapshot_(current_.get()),
+      readers_(0),
+      next_id_(0) {
+}
+
+void EventStream::Replace(std::unique_ptr<const Snapshot> next) {
+    // Called under mutex_. Sequentially consistent store and load: a publisher that
+    // registers after readers_ reads 0 is guaranteed to load the new snapshot, so every
+    // retired one is unreachable at that point.
+    retired_.push_back(std::move(current_));
+    current_ = std::move(next);
+    snapshot_.store(current_.get());
+    if (readers_.load() == 0) {
+        retired_.clear();
+    }
 }
 
 std::shared_ptr<EventStream> EventStream::New() {
@@ -31,19 +201,56 @@ std::shared_ptr<EventStream> EventStream::New() {
 }
 
 std::shared_ptr<Subscription> EventStream::Subscribe(Handler handler) {
-    auto sub = std::make_shared<Subscription>(handler);
-    
-    std::lock_guard<std::mutex> lock(mutex_);
-    sub->id_ = counter_.load();
-    counter_.fetch_add(1);
-    subscriptions_.push_back(sub);
-    
-    return sub;
+    return Add(nullptr, std::make_shared<Subscription>(std::move(handler)));
+}
+
+std::shared_ptr<Subscription> EventStream::SubscribeAsync(
+    Handler handler,
+    std::shared_ptr<Dispatcher> dispatcher,
+    std::size_t capacity) {
+    auto sub = std::make_shared<Subscription>(std::move(handler));
+    if (!dispatcher) {
+        dispatcher = NewDefaultDispatcher(DEFAULT_DRAIN_THROUGHPUT);
+    }
+    sub->async_ = std::make_shared<AsyncDelivery>(std::move(dispatcher), capacity);
+    return Add(nullptr, sub);
 }
 
 std::shared_ptr<Subscription> EventStream::SubscribeWithPredicate(Handler handler, Predicate predicate) {
-    auto sub = Subscribe(handler);
-    sub->predicate_ = predicate;
+    return Add(nullptr, std::make_shared<Subscription>(std::move(handler), std::move(predicate)));
+}
+
+std::shared_ptr<Subscription> EventStream::SubscribeType(std::type_index type, Handler handler, Predicate predicate) {
+    return Add(&type, std::make_shared<Subscription>(std::move(handler), std::move(predicate)));
+}
+
+std::shared_ptr<Subscription> EventStream::SubscribeTypeAsync(
+    std::type_index type,
+    Handler handler,
+    std::shared_ptr<Dispatcher> dispatcher,
+    std::size_t capacity) {
+    auto sub = std::make_shared<Subscription>(std::move(handler));
+    if (!dispatcher) {
+        dispatcher = NewDefaultDispatcher(DEFAULT_DRAIN_THROUGHPUT);
+    }
+    sub->async_ = std::make_shared<AsyncDelivery>(std::move(dispatcher), capacity);
+    return Add(&type, sub);
+}
+
+std::shared_ptr<Subscription> EventStream::Add(const std::type_index* type, std::shared_ptr<Subscription> sub) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sub->id_ = next_id_++;
+    
+    // Copy-on-write: readers keep using the old snapshot until they finish
+    auto next = std::make_unique<Snapshot>(*current_);
+    if (type) {
+        next->typed[*type].push_back(sub);
+    } else {
+        next->untyped.push_back(sub);
+    }
+    next->count++;
+    Replace(std::move(next));
+    
     return sub;
 }
 
@@ -52,50 +259,64 @@ void EventStream::Unsubscribe(std::shared_ptr<Subscription> subscription) {
         return;
     }
     
-    if (subscription->IsActive()) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        if (subscription->Deactivate()) {
-            auto it = std::find_if(subscriptions_.begin(), subscriptions_.end(),
-                [subscription](const std::shared_ptr<Subscription>& sub) {
-                    return sub->id_ == subscription->id_;
-                });
-            
-            if (it != subscriptions_.end()) {
-                subscriptions_.erase(it);
-                counter_.fetch_sub(1);
-            }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!subscription->Deactivate()) {
+        return;
+    }
+    
+    auto next = std::make_unique<Snapshot>(*current_);
+    auto remove = [&subscription](SubscriptionList& list) {
+        auto it = std::find(list.begin(), list.end(), subscription);
+        if (it == list.end()) {
+            return false;
+        }
+        list.erase(it);
+        return true;
+    };
+    bool removed = remove(next->untyped);
+    for (auto it = next->typed.begin(); !removed && it != next->typed.end(); ++it) {
+        removed = remove(it->second);
+        if (removed && it->second.empty()) {
+            next->typed.erase(it);
+            break;
         }
     }
+    if (removed) {
+        next->count--;
+        Replace(std::move(next));
+    }
 }
 
 void EventStream::Publish(std::shared_ptr<void> evt) {
-    std::vector<std::shared_ptr<Subscription>> subs;
+    PublishType(nullptr, std::move(evt));
+}
+
+void EventStream::PublishType(const std::type_info* type, std::shared_ptr<void> evt) {
+    // Lock-free for publishers: announce the read, then walk the current snapshot
+    struct ReadGuard {
+        std::atomic<int32_t>& readers;
+        explicit ReadGuard(std::atomic<int32_t>& count) : readers(count) { readers.fetch_add(1); }
+        ~ReadGuard() { readers.fetch_sub(1); }
+    } guard(readers_);
+    const Snapshot* snapshot = snapshot_.load();
     
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        subs.reserve(subscriptions_.size());
-        for (auto& sub : subscriptions_) {
-            if (sub->IsActive()) {
-                subs.push_back(sub);
-            }
-        }
+    for (auto& sub : snapshot->untyped) {
+        sub->Deliver(evt);
     }
     
-    for (auto& sub : subs) {
-        // Check predicate if present
-        if (sub->predicate_ && !sub->predicate_(evt)) {
-            continue;
+    if (type && !snapshot->typed.empty()) {
+        auto it = snapshot->typed.find(std::type_index(*type));
+        if (it != snapshot->typed.end()) {
+            for (auto& sub : it->second) {
+                sub->Deliver(evt);
+            }
         }
-        
-        // Execute handler
-        sub->handler_(evt);
     }
 }
 
 int32_t EventStream::Length() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return counter_.load();
+    return current_->count;
 }
 
 } // namespace eventstream
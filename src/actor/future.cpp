@@ -20,112 +20,84 @@ public:
         : actor_system_(actor_system),
           done_(false),
           timeout_(timeout) {
-        // Register as process
+    }
+
+    /**
+     * @brief Register with the process registry and arm the timeout.
+     * Must be called once the future is owned by a shared_ptr.
+     */
+    void Start() {
         auto id = actor_system_->GetProcessRegistry()->NextID();
-        pid_ = NewPID(actor_system_->GetProcessRegistry()->Address(), "future" + id);
-        auto self = std::static_pointer_cast<FutureImpl>(shared_from_this());
-        actor_system_->GetProcessRegistry()->Add(self, "future" + id);
-        
-        // Start timeout timer if needed
-        if (timeout.count() > 0) {
-            timeout_thread_ = std::thread([this, timeout]() {
-                std::this_thread::sleep_for(timeout);
-                std::lock_guard<std::mutex> lock(mutex_);
-                if (!done_) {
-                    err_ = std::make_error_code(std::errc::timed_out);
-                    done_ = true;
-                    Stop(pid_);
-                    cond_.notify_all();
+        auto self = shared_from_this();
+        auto [pid, added] = actor_system_->GetProcessRegistry()->Add(self, "future" + id);
+        pid_ = pid;
+
+        // Start timeout timer if needed. The timer thread holds the future alive until
+        // it either completes (which wakes the wait early) or times out.
+        if (timeout_.count() > 0) {
+            std::thread([self]() {
+                {
+                    std::unique_lock<std::mutex> lock(self->mutex_);
+                    if (self->cond_.wait_for(lock, self->timeout_, [&self] { return self->done_; })) {
+                        return;
+                    }
                 }
-            });
+                self->Complete(nullptr, std::make_error_code(std::errc::timed_out));
+            }).detach();
         }
     }
-    
-    ~FutureImpl() {
-        if (timeout_thread_.joinable()) {
-            timeout_thread_.join();
-        }
-    }
-    
+
     std::shared_ptr<PID> GetPID() override {
         return pid_;
     }
-    
+
     void PipeTo(const std::vector<std::shared_ptr<PID>>& pids) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        pipes_.insert(pipes_.end(), pids.begin(), pids.end());
-        if (done_) {
-            SendToPipes();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pipes_.insert(pipes_.end(), pids.begin(), pids.end());
+            if (!done_) {
+                return;
+            }
         }
+        SendToPipes();
     }
-    
+
     std::pair<std::shared_ptr<void>, std::error_code> Result() override {
         std::unique_lock<std::mutex> lock(mutex_);
         cond_.wait(lock, [this] { return done_; });
         return {result_, err_};
     }
-    
+
     std::error_code Wait() override {
         std::unique_lock<std::mutex> lock(mutex_);
         cond_.wait(lock, [this] { return done_; });
         return err_;
     }
-    
+
     void ContinueWith(std::function<void(std::shared_ptr<void>, std::error_code)> continuation) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (done_) {
-            continuation(result_, err_);
-        } else {
-            completions_.push_back(continuation);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!done_) {
+                completions_.push_back(std::move(continuation));
+                return;
+            }
         }
+        // Already resolved: run outside the lock so the continuation may touch the future
+        continuation(result_, err_);
     }
-    
+
     // Process interface
-    void SendUserMessage(std::shared_ptr<PID> pid, std::shared_ptr<void> message) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (done_) {
-            return;
-        }
-        
+    void SendUserMessage(std::shared_ptr<PID>, std::shared_ptr<void> message) override {
         auto [header, msg, sender] = UnwrapEnvelope(message);
-        
-        // Check for dead letter response (would need proper type checking)
-        // For now, just use the message as result
-        if (msg) {
-            result_ = nullptr;
-            err_ = std::make_error_code(std::errc::host_unreachable);
-        } else {
-            result_ = msg;
-            err_ = std::error_code(); // Success
-        }
-        
-        Stop(pid);
+        Complete(msg, std::error_code());
     }
-    
-    void SendSystemMessage(std::shared_ptr<PID> pid, std::shared_ptr<void> message) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (done_) {
-            return;
-        }
-        
-        result_ = message;
-        err_ = std::error_code(); // Success
-        Stop(pid);
+
+    void SendSystemMessage(std::shared_ptr<PID>, std::shared_ptr<void> message) override {
+        Complete(message, std::error_code());
     }
-    
-    void Stop(std::shared_ptr<PID> pid) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (done_) {
-            return;
-        }
-        
-        done_ = true;
-        actor_system_->GetProcessRegistry()->Remove(pid);
-        
-        SendToPipes();
-        RunCompletions();
-        
-        cond_.notify_all();
+
+    void Stop(std::shared_ptr<PID>) override {
+        Complete(nullptr, std::error_code());
     }
 
 private:
@@ -137,41 +109,66 @@ private:
     std::shared_ptr<void> result_;
     std::error_code err_;
     std::chrono::milliseconds timeout_;
-    std::thread timeout_thread_;
     std::vector<std::shared_ptr<PID>> pipes_;
     std::vector<std::function<void(std::shared_ptr<void>, std::error_code)>> completions_;
-    
+
+    /**
+     * @brief Resolve the future exactly once; pipes and continuations run outside the lock.
+     */
+    void Complete(std::shared_ptr<void> result, std::error_code err) {
+        std::vector<std::function<void(std::shared_ptr<void>, std::error_code)>> completions;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (done_) {
+                return;
+            }
+            done_ = true;
+            result_ = std::move(result);
+            err_ = err;
+            completions.swap(completions_);
+        }
+        cond_.notify_all();
+
+        auto registry = actor_system_->GetProcessRegistry();
+        if (registry && pid_) {
+            registry->Remove(pid_);
+        }
+
+        SendToPipes();
+        for (auto& completion : completions) {
+            completion(result_, err_);
+        }
+    }
+
     void SendToPipes() {
-        if (pipes_.empty()) {
+        std::vector<std::shared_ptr<PID>> pipes;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pipes.swap(pipes_);
+        }
+        if (pipes.empty()) {
             return;
         }
-        
+
         std::shared_ptr<void> msg;
         if (err_) {
             msg = std::make_shared<std::error_code>(err_);
         } else {
             msg = result_;
         }
-        
-        for (auto& pid : pipes_) {
+
+        for (auto& pid : pipes) {
             pid->SendUserMessage(actor_system_, msg);
         }
-        
-        pipes_.clear();
-    }
-    
-    void RunCompletions() {
-        for (auto& completion : completions_) {
-            completion(result_, err_);
-        }
-        completions_.clear();
     }
 };
 
 std::shared_ptr<Future> NewFuture(
     std::shared_ptr<ActorSystem> actor_system,
     std::chrono::milliseconds timeout) {
-    return std::make_shared<FutureImpl>(actor_system, timeout);
+    auto future = std::make_shared<FutureImpl>(actor_system, timeout);
+    future->Start();
+    return future;
 }
 
 } // namespace protoactor
@@ -12,7 +12,7 @@ namespace protoactor {
 class MessageInvoker;
 
 // Default mailbox implementation
-class DefaultMailbox : public Mailbox {
+class DefaultMailbox : public Mailbox, public std::enable_shared_from_this<DefaultMailbox> {
 public:
     DefaultMailbox()
         : scheduler_status_(IDLE),
@@ -52,6 +52,22 @@ public:
     int UserMessageCount() const override {
         return user_messages_.load(std::memory_order_relaxed);
     }
+    
+    bool EnqueueUserMessage(std::shared_ptr<void> message) override {
+        user_mailbox_->Push(message);
+        user_messages_.fetch_add(1, std::memory_order_relaxed);
+        // Same handoff as Schedule(), but the caller submits the run
+        int expected = IDLE;
+        return scheduler_status_.compare_exchange_strong(expected, RUNNING);
+    }
+    
+    void Run() override {
+        ProcessMessages();
+    }
+    
+    std::shared_ptr<Dispatcher> GetDispatcher() const override {
+        return dispatcher_;
+    }
 
 private:
     enum {
@@ -72,9 +88,11 @@ private:
         // Try to set status to RUNNING
         int expected = IDLE;
         if (scheduler_status_.compare_exchange_strong(expected, RUNNING)) {
-            // Successfully acquired lock, schedule processing
-            dispatcher_->Schedule([this]() {
-                ProcessMessages();
+            // Successfully acquired lock, schedule processing. The task keeps the mailbox
+            // alive in case the owning process is removed before the task runs.
+            auto self = shared_from_this();
+            dispatcher_->Schedule([self]() {
+                self->ProcessMessages();
             });
         }
         // If already RUNNING, don't schedule again
@@ -134,4 +134,8 @@ std::string ProcessRegistry::Address() const {
     return address_;
 }
 
+void ProcessRegistry::SetAddress(const std::string& address) {
+    address_ = address;
+}
+
 } // namespace protoactor
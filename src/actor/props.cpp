@@ -131,6 +131,10 @@ ProducerWithActorSystem Props::GetProducer() const {
     return producer_;
 }
 
+std::vector<ReceiverMiddleware> Props::GetReceiverMiddleware() const {
+    return receiver_middleware_;
+}
+
 std::shared_ptr<Props> Props::WithSpawner(SpawnFunc spawner) {
     spawner_ = spawner;
     return shared_from_this();
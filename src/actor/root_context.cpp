@@ -6,6 +6,7 @@
 #include "external/pid.h"
 #include "external/props.h"
 #include "internal/actor/new_pid.h"
+#include "internal/actor/scatter_gather.h"
 #include <stdexcept>
 
 // Forward declaration
@@ -82,6 +83,20 @@ std::shared_ptr<Future> RootContext::RequestFuture(
     return future;
 }
 
+std::shared_ptr<Future> RootContext::RequestScatterGather(
+    const std::vector<std::shared_ptr<PID>>& pids,
+    std::shared_ptr<void> message,
+    std::chrono::milliseconds timeout,
+    GatherMode mode,
+    int quorum) {
+    auto gather = ScatterGatherFuture::New(actor_system_, pids, mode, quorum, timeout);
+    auto system = actor_system_;
+    gather->Scatter(message, [system](std::shared_ptr<PID> pid, std::shared_ptr<MessageEnvelope> env) {
+        pid->SendUserMessage(system, env);
+    });
+    return gather;
+}
+
 std::chrono::milliseconds RootContext::ReceiveTimeout() {
     return std::chrono::milliseconds(0);
 }
@@ -135,7 +150,11 @@ void RootContext::Forward(std::shared_ptr<PID> pid) {
 void RootContext::ReenterAfter(
     std::shared_ptr<Future> future,
     std::function<void(std::shared_ptr<void>, std::error_code)> continuation) {
-    // Not applicable for root context
+    // Root context has no mailbox to reenter, so the continuation runs on the
+    // thread that resolves the future
+    if (future) {
+        future->ContinueWith(continuation);
+    }
 }
 
 std::shared_ptr<CapturedContext> RootContext::Capture() {
@@ -0,0 +1,296 @@
+#include "internal/actor/scatter_gather.h"
+#include "external/actor_system.h"
+#include "external/pid.h"
+#include "internal/process_registry.h"
+#include "internal/scheduler/timer_wheel.h"
+#include <algorithm>
+
+namespace protoactor {
+
+std::shared_ptr<ScatterGatherFuture> ScatterGatherFuture::New(
+    std::shared_ptr<ActorSystem> actor_system,
+    const std::vector<std::shared_ptr<PID>>& targets,
+    GatherMode mode,
+    int quorum,
+    std::chrono::milliseconds timeout) {
+    auto future = std::make_shared<ScatterGatherFuture>(actor_system, targets, mode, quorum, timeout);
+    future->Register();
+    return future;
+}
+
+ScatterGatherFuture::ScatterGatherFuture(
+    std::shared_ptr<ActorSystem> actor_system,
+    const std::vector<std::shared_ptr<PID>>& targets,
+    GatherMode mode,
+    int quorum,
+    std::chrono::milliseconds timeout)
+    : actor_system_(actor_system),
+      targets_(targets),
+      responses_(targets.size()),
+      required_(targets.size()),
+      received_(0),
+      unreachable_(0),
+      next_target_(0),
+      timeout_(timeout),
+      done_(false) {
+    if (mode == GatherMode::First) {
+        required_ = targets.empty() ? 0 : 1;
+    } else if (mode == GatherMode::Quorum) {
+        std::size_t q = quorum > 0 ? static_cast<std::size_t>(quorum) : targets.size() / 2 + 1;
+        required_ = std::min(q, targets.size());
+    }
+}
+
+void ScatterGatherFuture::Register() {
+    auto registry = actor_system_->GetProcessRegistry();
+    auto [pid, added] = registry->Add(shared_from_this(), "gather" + registry->NextID());
+    pid_ = pid;
+}
+
+bool ScatterGatherFuture::SendTo(std::size_t index, const std::shared_ptr<void>& message, const SendFunc& send) {
+    auto& target = targets_[index];
+    bool reachable = false;
+    if (target) {
+        auto [process, exists] = actor_system_->GetProcessRegistry()->Get(target);
+        reachable = exists && process;
+    }
+    if (!reachable) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++unreachable_;
+        return false;
+    }
+
+    // Sender PID shares the gather process id; request_id carries the target index
+    auto sender = NewPID(pid_->address, pid_->id);
+    sender->request_id = static_cast<std::uint32_t>(index + 1);
+    send(target, std::make_shared<MessageEnvelope>(nullptr, message, sender));
+    return true;
+}
+
+bool ScatterGatherFuture::ResolveIfDecided() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::error_code err;
+        if (done_ || !Decided(err)) {
+            return false;
+        }
+        Resolve(err);
+    }
+    Finish();
+    return true;
+}
+
+void ScatterGatherFuture::Scatter(std::shared_ptr<void> message, const SendFunc& send) {
+    for (std::size_t i = 0; i < targets_.size(); ++i) {
+        SendTo(i, message, send);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        next_target_ = targets_.size();
+    }
+    if (!ResolveIfDecided()) {
+        ArmTimeout();
+    }
+}
+
+void ScatterGatherFuture::Hedge(std::shared_ptr<void> message, SendFunc send, std::chrono::milliseconds delay) {
+    ArmTimeout();
+    SendNextHedge(std::move(message), std::move(send), delay);
+}
+
+void ScatterGatherFuture::SendNextHedge(std::shared_ptr<void> message, SendFunc send, std::chrono::milliseconds delay) {
+    while (true) {
+        std::size_t index;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (done_ || next_target_ >= targets_.size()) {
+                return;
+            }
+            index = next_target_++;
+        }
+        if (SendTo(index, message, send)) {
+            break;
+        }
+        // Unreachable: it may have made the policy impossible, otherwise try the next target now
+        if (ResolveIfDecided()) {
+            return;
+        }
+    }
+
+    bool more;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        more = !done_ && next_target_ < targets_.size();
+    }
+    auto wheel = actor_system_->GetTimerWheel();
+    if (!more || !wheel) {
+        return;
+    }
+    std::weak_ptr<ScatterGatherFuture> weak_self = shared_from_this();
+    wheel->ScheduleAt(wheel->CurrentTick() + wheel->TicksFor(delay), [weak_self, message, send, delay]() {
+        if (auto self = weak_self.lock()) {
+            self->SendNextHedge(message, send, delay);
+        }
+    });
+}
+
+void ScatterGatherFuture::Cancel() {
+    Stop(pid_);
+}
+
+void ScatterGatherFuture::ArmTimeout() {
+    auto wheel = actor_system_->GetTimerWheel();
+    if (timeout_.count() <= 0 || !wheel) {
+        return;
+    }
+    // One timer for the whole request; the registry keeps the future alive until it resolves
+    std::weak_ptr<ScatterGatherFuture> weak_self = shared_from_this();
+    wheel->ScheduleAt(wheel->CurrentTick() + wheel->TicksFor(timeout_), [weak_self]() {
+        auto self = weak_self.lock();
+        if (!self) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(self->mutex_);
+            if (self->done_) {
+                return;
+            }
+            self->Resolve(std::make_error_code(std::errc::timed_out));
+        }
+        self->Finish();
+    });
+}
+
+std::shared_ptr<PID> ScatterGatherFuture::GetPID() {
+    return pid_;
+}
+
+void ScatterGatherFuture::PipeTo(const std::vector<std::shared_ptr<PID>>& pids) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pipes_.insert(pipes_.end(), pids.begin(), pids.end());
+        if (!done_) {
+            return;
+        }
+    }
+    SendToPipes();
+}
+
+std::pair<std::shared_ptr<void>, std::error_code> ScatterGatherFuture::Result() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return done_; });
+    return {result_, err_};
+}
+
+std::error_code ScatterGatherFuture::Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return done_; });
+    return err_;
+}
+
+void ScatterGatherFuture::ContinueWith(std::function<void(std::shared_ptr<void>, std::error_code)> continuation) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!done_) {
+            completions_.push_back(std::move(continuation));
+            return;
+        }
+    }
+    continuation(result_, err_);
+}
+
+void ScatterGatherFuture::SendUserMessage(std::shared_ptr<PID> pid, std::shared_ptr<void> message) {
+    auto [header, msg, sender] = UnwrapEnvelope(message);
+    OnResponse(pid ? pid->request_id : 0, msg);
+}
+
+void ScatterGatherFuture::SendSystemMessage(std::shared_ptr<PID>, std::shared_ptr<void>) {
+    // System messages are not responses
+}
+
+void ScatterGatherFuture::Stop(std::shared_ptr<PID>) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (done_) {
+            return;
+        }
+        Resolve(std::make_error_code(std::errc::operation_canceled));
+    }
+    Finish();
+}
+
+void ScatterGatherFuture::OnResponse(std::uint32_t request_id, std::shared_ptr<void> message) {
+    if (request_id == 0 || request_id > responses_.size() || !message) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& slot = responses_[request_id - 1];
+        if (done_ || slot) {
+            return;
+        }
+        slot = std::move(message);
+        ++received_;
+        std::error_code err;
+        if (!Decided(err)) {
+            return;
+        }
+        Resolve(err);
+    }
+    Finish();
+}
+
+bool ScatterGatherFuture::Decided(std::error_code& err) const {
+    if (received_ >= required_) {
+        err = std::error_code();
+        return true;
+    }
+    if (targets_.size() - unreachable_ < required_) {
+        err = std::make_error_code(std::errc::no_such_process);
+        return true;
+    }
+    return false;
+}
+
+void ScatterGatherFuture::Resolve(std::error_code err) {
+    auto result = std::make_shared<ScatterGatherResult>();
+    result->targets = targets_;
+    result->responses = responses_;
+    result->received = received_;
+    result->unreachable = unreachable_;
+    result_ = result;
+    err_ = err;
+    done_ = true;
+}
+
+void ScatterGatherFuture::Finish() {
+    std::vector<std::function<void(std::shared_ptr<void>, std::error_code)>> completions;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        completions.swap(completions_);
+    }
+    cond_.notify_all();
+
+    auto registry = actor_system_->GetProcessRegistry();
+    if (registry && pid_) {
+        registry->Remove(pid_);
+    }
+
+    SendToPipes();
+    for (auto& completion : completions) {
+        completion(result_, err_);
+    }
+}
+
+void ScatterGatherFuture::SendToPipes() {
+    std::vector<std::shared_ptr<PID>> pipes;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pipes.swap(pipes_);
+    }
+    for (auto& pid : pipes) {
+        pid->SendUserMessage(actor_system_, result_);
+    }
+}
+
+} // namespace protoactor
@@ -159,8 +159,10 @@ bool ThreadPool::IsShutdown() const {
 }
 
 std::shared_ptr<ThreadPool> DefaultThreadPool() {
-    static std::shared_ptr<ThreadPool> pool = std::make_shared<ThreadPool>(0);
-    return pool;
+    // Intentionally never destroyed: workers may still be parked on the pool's condition
+    // variable during static destruction, and freeing it under them is a use-after-free.
+    static std::shared_ptr<ThreadPool>* pool = new std::shared_ptr<ThreadPool>(std::make_shared<ThreadPool>(0));
+    return *pool;
 }
 
 std::shared_ptr<ThreadPool> NewThreadPool(std::size_t num_threads) {
@@ -73,23 +73,16 @@ void Cluster::Initialize() {
 void Cluster::SubscribeToTopologyEvents() {
     // Subscribe to ClusterTopology events
     auto event_stream = actor_system_->GetEventStream();
-    topology_sub_ = event_stream->SubscribeWithPredicate(
-        [this](std::shared_ptr<void> evt) {
-            if (auto topology = std::dynamic_pointer_cast<ClusterTopology>(
-                    std::static_pointer_cast<SystemMessage>(evt))) {
-                // Remove left members from PID cache
-                auto cache = GetPidCache();
-                if (cache) {
-                    for (const auto& member : topology->left) {
-                        // Clear cache for left members
-                        // In full implementation, would remove all PIDs for that member
-                    }
+    topology_sub_ = event_stream->Subscribe<ClusterTopology>(
+        [this](std::shared_ptr<ClusterTopology> topology) {
+            // Remove left members from PID cache
+            auto cache = GetPidCache();
+            if (cache) {
+                for (const auto& member : topology->left) {
+                    // Clear cache for left members
+                    // In full implementation, would remove all PIDs for that member
                 }
             }
-        },
-        [](std::shared_ptr<void> evt) {
-            return std::dynamic_pointer_cast<ClusterTopology>(
-                std::static_pointer_cast<SystemMessage>(evt)) != nullptr;
         }
     );
 }
@@ -18,13 +18,9 @@ MemberList::MemberList(std::shared_ptr<Cluster> cluster)
     
     // Subscribe to gossip updates
     auto event_stream = cluster_->GetActorSystem()->GetEventStream();
-    gossip_sub_ = event_stream->SubscribeWithPredicate(
-        [this](std::shared_ptr<void> evt) {
-            HandleGossipUpdate(evt);
-        },
-        [](std::shared_ptr<void> evt) {
-            return std::dynamic_pointer_cast<GossipUpdate>(
-                std::static_pointer_cast<SystemMessage>(evt)) != nullptr;
+    gossip_sub_ = event_stream->Subscribe<GossipUpdate>(
+        [this](std::shared_ptr<GossipUpdate> update) {
+            HandleGossipUpdate(update);
         }
     );
 }
@@ -70,7 +66,7 @@ void MemberList::UpdateTopology(std::shared_ptr<ClusterTopology> topology) {
     
     // Publish topology event
     auto event_stream = cluster_->GetActorSystem()->GetEventStream();
-    event_stream->Publish(std::static_pointer_cast<void>(topology));
+    event_stream->Publish(topology);
     
     // Logger not available, skip logging for now
     // cluster_->GetActorSystem()->Logger()->Info("Updated ClusterTopology",
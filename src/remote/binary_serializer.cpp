@@ -0,0 +1,120 @@
+#include "external/remote/binary_serializer.h"
+
+namespace protoactor {
+namespace remote {
+
+BinarySerializer::BinarySerializer() {
+    published_.push_back(std::make_unique<const Table>());
+    table_.store(published_.back().get(), std::memory_order_release);
+}
+
+std::shared_ptr<BinarySerializer> BinarySerializer::Instance() {
+    static auto instance = std::make_shared<BinarySerializer>();
+    return instance;
+}
+
+int32_t BinarySerializer::SerializerID() {
+    // Registered lazily so static registration of message types never claims the
+    // default serializer slot (id 0) ahead of ProtoSerializer
+    static int32_t id = [] {
+        auto instance = Instance();
+        int32_t assigned = SerializerRegistry::RegisterSerializer(instance);
+        instance->id_.store(assigned, std::memory_order_release);
+        return assigned;
+    }();
+    return id;
+}
+
+void BinarySerializer::Add(Codec codec) {
+    std::lock_guard<std::mutex> lock(register_mutex_);
+    auto current = table_.load(std::memory_order_relaxed);
+    auto by_magic = current->by_magic.find(codec.magic);
+    if (by_magic != current->by_magic.end()) {
+        if (by_magic->second->type_name != codec.type_name) {
+            throw std::runtime_error("BinarySerializer: MAGIC already registered for " + by_magic->second->type_name);
+        }
+        // Registered again (e.g. from another translation unit): keep the codec, whose
+        // type name SerializeNamed hands out
+        return;
+    }
+    codecs_.push_back(std::make_unique<const Codec>(std::move(codec)));
+    const Codec* entry = codecs_.back().get();
+    auto table = std::make_unique<Table>(*current);
+    table->by_magic[entry->magic] = entry;
+    table->by_name[entry->type_name] = entry;
+    // Readers may still hold the previous table, so it is kept rather than freed
+    published_.push_back(std::move(table));
+    table_.store(published_.back().get(), std::memory_order_release);
+}
+
+const BinarySerializer::Codec* BinarySerializer::Find(const std::shared_ptr<void>& message) const {
+    if (!message) {
+        return nullptr;
+    }
+    // Same convention as MessageEnvelope::IsEnvelope: the first field is the magic
+    auto magic = *static_cast<const uint64_t*>(message.get());
+    auto table = table_.load(std::memory_order_acquire);
+    auto it = table->by_magic.find(magic);
+    return it == table->by_magic.end() ? nullptr : it->second;
+}
+
+bool BinarySerializer::IsRegistered(const std::shared_ptr<void>& message) const {
+    return Find(message) != nullptr;
+}
+
+std::size_t BinarySerializer::SerializeTo(std::shared_ptr<void> message, std::string* out) {
+    auto codec = Find(message);
+    if (!codec) {
+        throw std::runtime_error("BinarySerializer: unregistered message type");
+    }
+    auto start = out->size();
+    BinaryWriter writer(out);
+    codec->encode(message.get(), writer);
+    return out->size() - start;
+}
+
+const std::string& BinarySerializer::SerializeNamed(std::shared_ptr<void> message, std::string* out) {
+    // One lookup for both; codecs are never removed, so the name outlives the call
+    auto codec = Find(message);
+    if (!codec) {
+        throw std::runtime_error("BinarySerializer: unregistered message type");
+    }
+    BinaryWriter writer(out);
+    codec->encode(message.get(), writer);
+    return codec->type_name;
+}
+
+std::shared_ptr<void> BinarySerializer::DeserializeFrom(const std::string& type_name, std::string_view bytes) {
+    auto table = table_.load(std::memory_order_acquire);
+    auto it = table->by_name.find(type_name);
+    if (it == table->by_name.end()) {
+        throw std::runtime_error("BinarySerializer: unknown type " + type_name);
+    }
+    BinaryReader reader(bytes);
+    return it->second->decode(reader);
+}
+
+std::vector<uint8_t> BinarySerializer::Serialize(std::shared_ptr<void> message) {
+    std::string bytes;
+    SerializeTo(std::move(message), &bytes);
+    return std::vector<uint8_t>(bytes.begin(), bytes.end());
+}
+
+std::shared_ptr<void> BinarySerializer::Deserialize(const std::string& type_name, const std::vector<uint8_t>& bytes) {
+    return DeserializeFrom(type_name, std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+}
+
+std::string BinarySerializer::GetTypeName(std::shared_ptr<void> message) {
+    auto codec = Find(message);
+    if (!codec) {
+        throw std::runtime_error("BinarySerializer: unregistered message type");
+    }
+    return codec->type_name;
+}
+
+int32_t BinarySerializer::GetSerializerID() const {
+    return id_.load(std::memory_order_acquire);
+}
+
+} // namespace remote
+} // namespace protoactor
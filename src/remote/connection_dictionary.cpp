@@ -0,0 +1,126 @@
+#include "internal/remote/connection_dictionary.h"
+
+namespace protoactor {
+namespace remote {
+
+namespace {
+
+int32_t Intern(std::unordered_map<std::string, int32_t>& table, const std::string& key, int32_t base, bool* added) {
+    auto it = table.find(key);
+    if (it != table.end()) {
+        *added = false;
+        return it->second;
+    }
+    auto id = static_cast<int32_t>(table.size()) + base;
+    table.emplace(key, id);
+    *added = true;
+    return id;
+}
+
+std::shared_ptr<PID> WithRequestId(const std::shared_ptr<PID>& pid, uint32_t request_id) {
+    if (!pid || request_id == 0) {
+        return pid;
+    }
+    auto copy = NewPID(pid->address, pid->id);
+    copy->request_id = request_id;
+    return copy;
+}
+
+} // namespace
+
+ConnectionDictionaryEncoder::ConnectionDictionaryEncoder(std::size_t max_entries)
+    : max_entries_(max_entries) {
+}
+
+bool ConnectionDictionaryEncoder::BeginBatch() {
+    if (max_entries_ == 0 || Size() < max_entries_) {
+        return false;
+    }
+    Reset();
+    return true;
+}
+
+int32_t ConnectionDictionaryEncoder::TypeName(const std::string& type_name, bool* added) {
+    return Intern(type_names_, type_name, 0, added);
+}
+
+int32_t ConnectionDictionaryEncoder::Target(const std::string& id, bool* added) {
+    return Intern(targets_, id, 0, added);
+}
+
+int32_t ConnectionDictionaryEncoder::Sender(const PID& sender, bool* added) {
+    // '\0' cannot appear in an address, so the key is unambiguous
+    std::string key;
+    key.reserve(sender.address.size() + 1 + sender.id.size());
+    key.append(sender.address).push_back('\0');
+    key.append(sender.id);
+    return Intern(senders_, key, 1, added);
+}
+
+void ConnectionDictionaryEncoder::Reset() {
+    type_names_.clear();
+    targets_.clear();
+    senders_.clear();
+}
+
+std::size_t ConnectionDictionaryEncoder::Size() const {
+    return type_names_.size() + targets_.size() + senders_.size();
+}
+
+ConnectionDictionaryDecoder::ConnectionDictionaryDecoder(std::string local_address, std::size_t max_entries)
+    : local_address_(std::move(local_address)), max_entries_(max_entries) {
+}
+
+bool ConnectionDictionaryDecoder::Admit(std::size_t added, std::size_t envelopes) const {
+    // Each envelope references at most one type name, one target and one sender
+    if (added > 3 * envelopes) {
+        return false;
+    }
+    return max_entries_ == 0 || Size() < 2 * max_entries_;
+}
+
+void ConnectionDictionaryDecoder::Reset() {
+    type_names_.clear();
+    targets_.clear();
+    senders_.clear();
+}
+
+void ConnectionDictionaryDecoder::AddTypeName(const std::string& type_name) {
+    type_names_.push_back(type_name);
+}
+
+void ConnectionDictionaryDecoder::AddTarget(const std::string& id) {
+    targets_.push_back(NewPID(local_address_, id));
+}
+
+void ConnectionDictionaryDecoder::AddSender(const std::string& address, const std::string& id) {
+    senders_.push_back(NewPID(address, id));
+}
+
+const std::string* ConnectionDictionaryDecoder::TypeName(int32_t id) const {
+    if (id < 0 || id >= static_cast<int32_t>(type_names_.size())) {
+        return nullptr;
+    }
+    return &type_names_[id];
+}
+
+std::shared_ptr<PID> ConnectionDictionaryDecoder::Target(int32_t id, uint32_t request_id) const {
+    if (id < 0 || id >= static_cast<int32_t>(targets_.size())) {
+        return nullptr;
+    }
+    return WithRequestId(targets_[id], request_id);
+}
+
+std::shared_ptr<PID> ConnectionDictionaryDecoder::Sender(int32_t id, uint32_t request_id) const {
+    if (id <= 0 || id > static_cast<int32_t>(senders_.size())) {
+        return nullptr;
+    }
+    return WithRequestId(senders_[id - 1], request_id);
+}
+
+std::size_t ConnectionDictionaryDecoder::Size() const {
+    return type_names_.size() + targets_.size() + senders_.size();
+}
+
+} // namespace remote
+} // namespace protoactor
@@ -4,15 +4,19 @@
 #include "internal/remote/endpoint_watcher.h"
 #include "internal/remote/activator_actor.h"
 #include "internal/remote/messages.h"
+#include "internal/remote/shm_transport.h"
 #include "external/actor_system.h"
 #include "external/props.h"
 #include "external/supervision.h"
 #include "external/messages.h"
 #include "external/eventstream.h"
 #include "internal/actor/deadletter.h"
+#include "internal/metrics/metrics.h"
 #include "external/future.h"
+#include <algorithm>
 #include <thread>
 #include <chrono>
+#include <functional>
 
 namespace protoactor {
 namespace remote {
@@ -22,6 +26,47 @@ class ActivatorActor;
 class EndpointSupervisorActor;
 class EndpointWatcherActor;
 
+// EndpointQueue implementation
+EndpointQueue::EndpointQueue(const std::string& address, int capacity)
+    : capacity_(capacity),
+      depth_(0),
+      rejected_(0),
+      backpressured_(false),
+      gauge_(metrics::Metrics::NewGauge("remote_endpoint_queue_depth:" + address,
+                                        "Messages queued towards a remote endpoint")) {
+}
+
+bool EndpointQueue::TryAcquire() {
+    int depth = depth_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (capacity_ > 0 && depth > capacity_) {
+        depth_.fetch_sub(1, std::memory_order_relaxed);
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        if (!backpressured_.exchange(true, std::memory_order_acq_rel) && on_backpressure_) {
+            on_backpressure_(true, capacity_);
+        }
+        return false;
+    }
+    gauge_->Increment();
+    return true;
+}
+
+void EndpointQueue::Release(int count) {
+    if (count <= 0) {
+        return;
+    }
+    int depth = depth_.fetch_sub(count, std::memory_order_relaxed) - count;
+    gauge_->Decrement(count);
+    // Hysteresis: stay backpressured until half the queue has drained
+    if (depth <= capacity_ / 2 && backpressured_.load(std::memory_order_acquire) &&
+        backpressured_.exchange(false, std::memory_order_acq_rel) && on_backpressure_) {
+        on_backpressure_(false, depth);
+    }
+}
+
+void EndpointQueue::OnBackpressure(std::function<void(bool active, int depth)> callback) {
+    on_backpressure_ = std::move(callback);
+}
+
 // Endpoint implementation
 std::string Endpoint::Address() const {
     if (watcher) {
@@ -30,6 +75,16 @@ std::string Endpoint::Address() const {
     return "";
 }
 
+std::shared_ptr<PID> Endpoint::WriterFor(const PID& target) const {
+    if (writers.empty()) {
+        return nullptr;
+    }
+    if (writers.size() == 1) {
+        return writers.front();
+    }
+    return writers[std::hash<std::string>{}(target.id) % writers.size()];
+}
+
 // EndpointManager implementation
 EndpointManager::EndpointManager(std::shared_ptr<Remote> remote)
     : remote_(std::move(remote)), stopped_(false) {
@@ -51,7 +106,9 @@ void EndpointManager::Start() {
             auto terminated = std::dynamic_pointer_cast<EndpointTerminatedEvent>(
                 std::static_pointer_cast<SystemMessage>(evt));
             if (terminated) {
-                RemoveEndpoint(terminated->Address);
+                // Only the endpoint the writer belongs to: a stripe of an endpoint that was
+                // already replaced must not take the new one down
+                RemoveEndpoint(terminated->Address, terminated->Writer);
                 return;
             }
             
@@ -100,9 +157,13 @@ void EndpointManager::Stop() {
     StopSupervisor();
     
     // Clear connections
+    std::unordered_map<std::string, std::shared_ptr<Endpoint>> endpoints;
     {
         std::lock_guard<std::mutex> lock(connections_mutex_);
-        connections_.clear();
+        endpoints.swap(connections_);
+    }
+    for (auto& entry : endpoints) {
+        StopEndpoint(entry.second);
     }
     
     // Logger not available in ActorSystem, skip logging for now
@@ -122,44 +183,119 @@ std::shared_ptr<Endpoint> EndpointManager::EnsureConnected(const std::string& ad
     }
     
     // Create new endpoint (lazy connection)
-    // In full implementation, this would spawn EndpointWriter and EndpointWatcher actors
-    // For now, create placeholder
     auto endpoint = std::make_shared<Endpoint>();
+    auto config = remote_->GetConfig();
+    endpoint->queue = std::make_shared<EndpointQueue>(address, config ? config->endpoint_writer_queue_size : 0);
+    if (config && config->endpoint_writer_queue_policy == EndpointQueuePolicy::Backpressure) {
+        std::weak_ptr<ActorSystem> weak_system = remote_->GetActorSystem();
+        endpoint->queue->OnBackpressure([weak_system, address](bool active, int depth) {
+            auto system = weak_system.lock();
+            if (!system) {
+                return;
+            }
+            auto event = std::make_shared<EndpointBackpressureEvent>();
+            event->Address = address;
+            event->Active = active;
+            event->Depth = depth;
+            system->GetEventStream()->Publish(event);
+        });
+    }
     connections_[address] = endpoint;
     
-    // TODO: Spawn EndpointWriter and EndpointWatcher via supervisor
-    // This would be done by sending address to endpoint_supervisor_
+    // The writer connects when it starts; messages wait in its mailbox until then
+    auto transports = TransportsFor(address);
+    bool has_writer = !transports.empty();
+#ifdef ENABLE_GRPC
+    has_writer = true;
+#endif
+    if (has_writer) {
+        auto remote = remote_;
+        auto queue = endpoint->queue;
+        auto props = Props::FromProducer([remote, address, config, queue, transports]() {
+            return std::make_shared<EndpointWriter>(remote, address, config, queue, transports);
+        });
+        // Each stripe connects on its own; they share the endpoint's queue bound
+        int stripes = config ? std::max(1, config->endpoint_writer_stripes) : 1;
+        for (int i = 0; i < stripes; ++i) {
+            endpoint->writers.push_back(remote_->GetActorSystem()->GetRoot()->Spawn(props));
+        }
+    }
+    
+    // TODO: Spawn EndpointWatcher via supervisor
     
     return endpoint;
 }
 
 void EndpointManager::RemoveEndpoint(const std::string& address) {
-    std::lock_guard<std::mutex> lock(connections_mutex_);
-    connections_.erase(address);
+    std::shared_ptr<Endpoint> endpoint;
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        auto it = connections_.find(address);
+        if (it == connections_.end()) {
+            return;
+        }
+        endpoint = it->second;
+        connections_.erase(it);
+    }
+    StopEndpoint(endpoint);
+}
+
+void EndpointManager::RemoveEndpoint(const std::string& address, const std::shared_ptr<PID>& writer) {
+    std::shared_ptr<Endpoint> endpoint;
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        auto it = connections_.find(address);
+        if (it == connections_.end() || !writer) {
+            return;
+        }
+        const auto& writers = it->second->writers;
+        bool owned = std::any_of(writers.begin(), writers.end(), [&writer](const std::shared_ptr<PID>& pid) {
+            return pid && pid->id == writer->id;
+        });
+        if (!owned) {
+            return;
+        }
+        endpoint = it->second;
+        connections_.erase(it);
+    }
+    StopEndpoint(endpoint);
+}
+
+void EndpointManager::StopEndpoint(const std::shared_ptr<Endpoint>& endpoint) {
+    if (!endpoint) {
+        return;
+    }
+    for (const auto& writer : endpoint->writers) {
+        remote_->GetActorSystem()->GetRoot()->Stop(writer);
+    }
 }
 
-void EndpointManager::RemoteDeliver(
+std::error_code EndpointManager::RemoteDeliver(
     std::shared_ptr<PID> target,
     std::shared_ptr<void> message,
-    std::shared_ptr<PID> sender) {
+    std::shared_ptr<PID> sender,
+    int32_t serializer_id) {
     
     if (stopped_.load(std::memory_order_acquire)) {
-        // Send to deadletter
-        auto event_stream = remote_->GetActorSystem()->GetEventStream();
-        // TODO: Publish DeadLetterEvent when event system supports it
-        return;
+        DeadLetter(target, message, sender);
+        return std::make_error_code(std::errc::not_connected);
     }
     
     if (!target || target->address.empty()) {
-        return;
+        return std::make_error_code(std::errc::invalid_argument);
     }
     
     auto endpoint = EnsureConnected(target->address);
-    if (!endpoint || !endpoint->writer) {
-        // Send to deadletter
-        auto event_stream = remote_->GetActorSystem()->GetEventStream();
-        // TODO: Publish DeadLetterEvent when event system supports it
-        return;
+    auto writer = endpoint ? endpoint->WriterFor(*target) : nullptr;
+    if (!writer) {
+        DeadLetter(target, message, sender);
+        return std::make_error_code(std::errc::not_connected);
+    }
+    
+    // Bounded per-endpoint queue: a slow or unreachable peer must not grow memory unbounded
+    if (endpoint->queue && !endpoint->queue->TryAcquire()) {
+        DeadLetter(target, message, sender);
+        return std::make_error_code(std::errc::no_buffer_space);
     }
     
     // Create remoteDeliver message and send to endpoint writer
@@ -167,9 +303,68 @@ void EndpointManager::RemoteDeliver(
     deliver->target = target;
     deliver->message = message;
     deliver->sender = sender;
-    deliver->serializer_id = -1; // Use default serializer
+    deliver->serializer_id = serializer_id;
+    
+    remote_->GetActorSystem()->GetRoot()->Send(writer, deliver);
+    return std::error_code();
+}
+
+std::error_code EndpointManager::RemoteDeliverSystem(
+    std::shared_ptr<PID> target,
+    std::shared_ptr<void> message) {
+    
+    if (!target || target->address.empty()) {
+        return std::make_error_code(std::errc::invalid_argument);
+    }
+    auto endpoint = stopped_.load(std::memory_order_acquire) ? nullptr : EnsureConnected(target->address);
+    auto writer = endpoint ? endpoint->WriterFor(*target) : nullptr;
+    if (!writer) {
+        DeadLetter(target, message, nullptr);
+        return std::make_error_code(std::errc::not_connected);
+    }
+    
+    auto deliver = std::shared_ptr<struct RemoteDeliver>(new struct RemoteDeliver());
+    deliver->target = target;
+    deliver->message = message;
+    deliver->serializer_id = -1;
+    deliver->system = true;
     
-        remote_->GetActorSystem()->GetRoot()->Send(endpoint->writer, deliver);
+    // The writer's system mailbox is drained before its user backlog, so a Stop or Watch is
+    // not held behind queued user traffic
+    writer->SendSystemMessage(remote_->GetActorSystem(), deliver);
+    return std::error_code();
+}
+
+int EndpointManager::QueueDepth(const std::string& address) {
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    auto it = connections_.find(address);
+    if (it == connections_.end() || !it->second->queue) {
+        return 0;
+    }
+    return it->second->queue->Depth();
+}
+
+std::vector<std::shared_ptr<Transport>> EndpointManager::TransportsFor(const std::string& address) const {
+    std::vector<std::shared_ptr<Transport>> transports;
+    auto shm = remote_->GetSharedMemoryTransport();
+    if (shm && ShmTransport::IsLocalAddress(address)) {
+        transports.push_back(shm);
+    }
+    if (auto transport = remote_->GetTransport()) {
+        transports.push_back(transport);
+    }
+    return transports;
+}
+
+void EndpointManager::DeadLetter(
+    std::shared_ptr<PID> target,
+    std::shared_ptr<void> message,
+    std::shared_ptr<PID> sender) {
+    
+    auto dead_letter = remote_->GetActorSystem()->GetDeadLetter();
+    if (dead_letter && target) {
+        dead_letter->SendUserMessage(target, std::make_shared<MessageEnvelope>(nullptr, message, sender));
+    }
 }
 
 void EndpointManager::RemoteWatch(
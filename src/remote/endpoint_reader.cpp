@@ -7,23 +7,160 @@
 #include "internal/process_registry.h"
 #include "external/messages.h"
 #include "internal/log.h"
+#include "internal/actor/deadletter.h"
+#include "external/dispatcher.h"
+#include <algorithm>
+#include <functional>
+#include <iostream>
 #include <stdexcept>
+#include <thread>
 
 namespace protoactor {
 namespace remote {
 
-EndpointReader::EndpointReader(std::shared_ptr<Remote> remote)
-    : remote_(std::move(remote)), suspended_(false) {
+namespace {
+
+const int DEFAULT_READER_THROUGHPUT = 300;
+
+} // namespace
+
+EndpointReader::EndpointReader(
+    std::shared_ptr<Remote> remote,
+    int partitions,
+    std::shared_ptr<Dispatcher> dispatcher)
+    : remote_(std::move(remote)),
+      suspended_(false),
+      dispatcher_(dispatcher ? std::move(dispatcher) : NewDefaultDispatcher(DEFAULT_READER_THROUGHPUT)),
+      pending_(0),
+      high_water_(0),
+      low_water_(0),
+      paused_(false) {
+    if (remote_ && remote_->GetConfig()) {
+        if (partitions <= 0) {
+            partitions = remote_->GetConfig()->endpoint_reader_workers;
+        }
+        high_water_ = remote_->GetConfig()->endpoint_reader_high_water;
+        low_water_ = high_water_ / 2;
+    }
+    if (partitions <= 0) {
+        partitions = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    for (int i = 0; i < partitions; ++i) {
+        partitions_.push_back(std::make_unique<Partition>());
+    }
 }
 
-void EndpointReader::OnMessageBatch(std::shared_ptr<void> batch) {
-    if (suspended_.load(std::memory_order_acquire)) {
+void EndpointReader::OnMessageBatch(std::shared_ptr<InboundBatch> batch) {
+    if (suspended_.load(std::memory_order_acquire) || !batch || batch->envelopes.empty()) {
         return;
     }
     
-    // When gRPC is integrated, batch will be protobuf MessageBatch
-    // For now, this is a placeholder - full implementation would deserialize and route
-    // TODO: Implement message batch handling when gRPC is integrated
+    // Group by partition first so each partition is locked and scheduled once per batch
+    std::vector<std::vector<std::size_t>> groups(partitions_.size());
+    std::hash<std::string> hasher;
+    for (std::size_t i = 0; i < batch->envelopes.size(); ++i) {
+        const auto& target = batch->envelopes[i].target;
+        std::size_t p = target ? hasher(target->id) % partitions_.size() : 0;
+        groups[p].push_back(i);
+    }
+    
+    auto pending = pending_.fetch_add(batch->envelopes.size(), std::memory_order_relaxed) + batch->envelopes.size();
+    if (high_water_ > 0 && pending >= high_water_ && !paused_.exchange(true, std::memory_order_acq_rel)) {
+        UpdateFlow();
+    }
+    for (std::size_t p = 0; p < groups.size(); ++p) {
+        if (groups[p].empty()) {
+            continue;
+        }
+        auto* partition = partitions_[p].get();
+        {
+            std::lock_guard<std::mutex> lock(partition->mutex);
+            for (auto index : groups[p]) {
+                partition->queue.push_back(Work{batch, index});
+            }
+        }
+        Schedule(partition);
+    }
+}
+
+std::size_t EndpointReader::Pending() const {
+    return pending_.load(std::memory_order_relaxed);
+}
+
+void EndpointReader::SetFlowControl(std::function<void(bool paused)> handler) {
+    std::lock_guard<std::mutex> lock(flow_mutex_);
+    flow_handler_ = std::move(handler);
+    flow_reported_ = false;
+}
+
+bool EndpointReader::WaitWhilePaused(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(flow_mutex_);
+    return flow_cv_.wait_for(lock, timeout, [this]() { return !paused_.load(std::memory_order_acquire); });
+}
+
+void EndpointReader::UpdateFlow() {
+    // Pause and resume may cross on different threads; reporting the current state under
+    // the lock means the last call always matches it
+    std::lock_guard<std::mutex> lock(flow_mutex_);
+    bool paused = paused_.load(std::memory_order_acquire);
+    if (!paused) {
+        flow_cv_.notify_all();
+    }
+    if (paused == flow_reported_) {
+        return;
+    }
+    flow_reported_ = paused;
+    if (flow_handler_) {
+        flow_handler_(paused);
+    }
+}
+
+void EndpointReader::Schedule(Partition* partition) {
+    if (partition->scheduled.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    auto self = shared_from_this();
+    dispatcher_->Schedule([self, partition]() { self->Drain(partition); });
+}
+
+void EndpointReader::Drain(Partition* partition) {
+    int budget = std::max(1, dispatcher_->Throughput());
+    while (true) {
+        Work work;
+        {
+            std::lock_guard<std::mutex> lock(partition->mutex);
+            if (partition->queue.empty()) {
+                break;
+            }
+            if (budget-- <= 0) {
+                // Yield the worker to other partitions; keep the scheduled flag
+                auto self = shared_from_this();
+                dispatcher_->Schedule([self, partition]() { self->Drain(partition); });
+                return;
+            }
+            work = std::move(partition->queue.front());
+            partition->queue.pop_front();
+        }
+        const auto& envelope = work.batch->envelopes[work.index];
+        DeserializeAndDeliver(envelope.data, envelope.type_name, envelope.serializer_id,
+                              envelope.target, envelope.sender);
+        auto left = pending_.fetch_sub(1, std::memory_order_relaxed) - 1;
+        if (left <= low_water_ && paused_.load(std::memory_order_relaxed) &&
+            paused_.exchange(false, std::memory_order_acq_rel)) {
+            UpdateFlow();
+        }
+    }
+    
+    partition->scheduled.store(false, std::memory_order_release);
+    // A batch may have been queued after the last check but before the flag was cleared
+    bool more;
+    {
+        std::lock_guard<std::mutex> lock(partition->mutex);
+        more = !partition->queue.empty();
+    }
+    if (more) {
+        Schedule(partition);
+    }
 }
 
 std::shared_ptr<void> EndpointReader::OnConnectRequest(std::shared_ptr<void> request) {
@@ -48,7 +185,7 @@ void EndpointReader::HandleServerConnection(std::shared_ptr<void> connection) {
 }
 
 void EndpointReader::DeserializeAndDeliver(
-    const std::vector<uint8_t>& data,
+    std::string_view data,
     const std::string& type_name,
     int32_t serializer_id,
     std::shared_ptr<PID> target,
@@ -56,34 +193,45 @@ void EndpointReader::DeserializeAndDeliver(
     
     try {
         // Deserialize message
-        auto message = SerializerRegistry::Deserialize(data, type_name, serializer_id);
+        auto message = SerializerRegistry::DeserializeFrom(data, type_name, serializer_id);
+        
+        // Plain types carry no vtable, so only probe messages that can be system messages
+        bool may_be_system = true;
+        if (serializer_id >= 0) {
+            auto serializer = SerializerRegistry::GetSerializer(serializer_id);
+            may_be_system = !serializer || serializer->DecodesSystemMessages();
+        }
         
         // Check if it's a Terminated message
-        auto terminated = std::dynamic_pointer_cast<Terminated>(
-            std::static_pointer_cast<SystemMessage>(message));
+        auto terminated = may_be_system ? std::dynamic_pointer_cast<Terminated>(
+            std::static_pointer_cast<SystemMessage>(message)) : nullptr;
         if (terminated) {
             // Handle remote terminate
             auto terminate = std::shared_ptr<RemoteTerminate>(new RemoteTerminate());
             terminate->Watcher = target;
             terminate->Watchee = terminated->who;
             remote_->GetEndpointManager()->RemoteTerminate(terminate->Watcher, terminate->Watchee);
-        } else if (IsSystemMessage(message)) {
+        } else if (may_be_system && IsSystemMessage(message)) {
             // Send system message directly
             auto [process, found] = remote_->GetActorSystem()->GetProcessRegistry()->GetLocal(target->id);
             if (found && process) {
                 process->SendSystemMessage(target, message);
             }
         } else {
-            // Send user message
+            // Send user message straight to the target's mailbox
+            auto system = remote_->GetActorSystem();
+            auto [process, found] = system->GetProcessRegistry()->GetLocal(target->id);
+            if (!found || !process) {
+                process = system->GetDeadLetter();
+            }
             if (sender) {
-                auto envelope = std::make_shared<MessageEnvelope>(nullptr, message, sender);
-                remote_->GetActorSystem()->GetRoot()->Send(target, envelope);
+                process->SendUserMessage(target, std::make_shared<MessageEnvelope>(nullptr, message, sender));
             } else {
-                remote_->GetActorSystem()->GetRoot()->Send(target, message);
+                process->SendUserMessage(target, message);
             }
         }
     } catch (const std::exception& e) {
-        protoactor::log::GetLogger("remote")->error(std::string("DeserializeAndDeliver failed: ") + e.what());
+        std::cerr << "DeserializeAndDeliver failed: " << e.what() << std::endl;
     }
 }
 
@@ -1,13 +1,25 @@
 #include "internal/remote/endpoint_writer.h"
 #include "external/remote/remote.h"
+#include "internal/remote/endpoint_manager.h"
 #include "internal/remote/serializer.h"
 #include "internal/remote/messages.h"
+#include "internal/remote/blocklist.h"
+#include "internal/remote/lz4.h"
+#include "internal/remote/transport.h"
+#include "internal/remote/wire.h"
 #include "external/messages.h"
+#include "external/eventstream.h"
+#include "external/actor_system.h"
+#include "internal/actor/actor_process.h"
+#include "internal/actor/deadletter.h"
+#include "internal/mailbox.h"
+#include "internal/process_registry.h"
+#include "internal/scheduler/timer_wheel.h"
 #include <thread>
 #include <chrono>
 #include <algorithm>
+#include <random>
 #include <stdexcept>
-#include <unordered_map>
 
 #ifdef ENABLE_GRPC
 #include <grpcpp/grpcpp.h>
@@ -18,14 +30,150 @@
 namespace protoactor {
 namespace remote {
 
+namespace {
+
+// Sent to the writer itself when the max-linger timer fires
+struct LingerTick : public SystemMessage {
+};
+
+// Sent to the writer itself when the reconnect backoff has elapsed
+struct ConnectRetry : public SystemMessage {
+};
+
+// The pending handshake got a response, was closed, or timed out
+struct HandshakeEvent : public SystemMessage {
+    uint64_t id = 0;
+    bool timeout = false;
+};
+
+// How long the writer waits for the peer's ConnectResponse
+constexpr auto kHandshakeTimeout = std::chrono::seconds(5);
+
+double Jitter() {
+    static thread_local std::mt19937 gen(std::random_device{}());
+    return std::uniform_real_distribution<double>(0.0, 1.0)(gen);
+}
+
+// Codec asked for in ConnectRequest
+uint32_t OfferedCompression(const Config& config) {
+    return config.endpoint_compression == BatchCompression::Lz4 ? wire::kCompressionLz4 : wire::kCompressionNone;
+}
+
+// Codec to use after the peer answered; a peer without compression support answers none
+uint32_t AcceptedCompression(const Config& config, uint32_t answered) {
+    uint32_t offered = OfferedCompression(config);
+    return answered == offered ? offered : wire::kCompressionNone;
+}
+
+#ifdef ENABLE_GRPC
+// The message to write for a batch: message itself, or its batch compressed into scratch
+const RemoteMessage& CompressedBatch(const RemoteMessage& message, uint32_t codec, std::size_t threshold,
+                                     RemoteMessage* scratch) {
+    if (codec == wire::kCompressionNone || message.ByteSizeLong() < threshold) {
+        return message;
+    }
+    std::string body;
+    message.message_batch().SerializeToString(&body);
+    std::string packed;
+    lz4::Compress(body, &packed);
+    if (packed.size() >= body.size()) {
+        return message;
+    }
+    scratch->Clear();
+    auto* batch = scratch->mutable_message_batch();
+    batch->set_compression(static_cast<CompressionCodec>(codec));
+    batch->set_uncompressed_size(body.size());
+    batch->set_compressed_batch(std::move(packed));
+    return *scratch;
+}
+#endif
+
+} // namespace
+
+// Shared with the transport callbacks, which may outlive the writer
+struct EndpointWriter::Handshake {
+    std::mutex mutex;
+    uint64_t id = 0;
+    bool responded = false;
+    bool closed = false;
+    bool established = false;
+    bool closing = false;  // The writer closes the connection itself; not reported as lost
+    wire::ConnectResponse response;
+};
+
+ReconnectBackoff::ReconnectBackoff(std::chrono::milliseconds initial, std::chrono::milliseconds max)
+    : initial_(std::max(initial, std::chrono::milliseconds(1))),
+      max_(std::max(max, initial_)) {
+}
+
+std::chrono::milliseconds ReconnectBackoff::Delay(int retry, double jitter) const {
+    auto delay = initial_;
+    for (int i = 1; i < retry && delay < max_; ++i) {
+        delay *= 2;
+    }
+    delay = std::min(delay, max_);
+    jitter = std::min(std::max(jitter, 0.0), 1.0);
+    auto half = delay / 2;
+    return delay - half + std::chrono::milliseconds(static_cast<int64_t>(static_cast<double>(half.count()) * jitter));
+}
+
+AdaptiveFlushPolicy::AdaptiveFlushPolicy(std::size_t max_batch_size, std::size_t max_batch_bytes, std::size_t min_batch_size)
+    : min_limit_(std::max<std::size_t>(1, std::min(min_batch_size, std::max<std::size_t>(1, max_batch_size)))),
+      max_limit_(std::max<std::size_t>(1, max_batch_size)),
+      max_bytes_(max_batch_bytes),
+      limit_(min_limit_),
+      avg_bytes_(0) {
+}
+
+AdaptiveFlushPolicy::Reason AdaptiveFlushPolicy::OnEnqueue(std::size_t queued, bool mailbox_empty) const {
+    if (queued >= limit_) {
+        return Reason::BatchFull;
+    }
+    if (max_bytes_ > 0 && avg_bytes_ > 0 && queued * avg_bytes_ >= max_bytes_) {
+        return Reason::Bytes;
+    }
+    if (mailbox_empty) {
+        return Reason::Drained;
+    }
+    return Reason::None;
+}
+
+void AdaptiveFlushPolicy::OnFlushed(std::size_t messages, std::size_t bytes, bool backlog) {
+    if (messages > 0 && bytes > 0) {
+        std::size_t sample = bytes / messages;
+        // EWMA with weight 1/8; the first sample seeds it
+        avg_bytes_ = avg_bytes_ == 0 ? sample : avg_bytes_ - avg_bytes_ / 8 + sample / 8;
+    }
+    if (backlog) {
+        // Falling behind: larger batches amortize per-write overhead
+        limit_ = std::min(max_limit_, limit_ * 2);
+    } else if (messages * 4 < limit_) {
+        limit_ = std::max(min_limit_, limit_ / 2);
+    }
+}
+
 EndpointWriter::EndpointWriter(
     std::shared_ptr<Remote> remote,
     const std::string& address,
-    std::shared_ptr<Config> config)
+    std::shared_ptr<Config> config,
+    std::shared_ptr<EndpointQueue> queue,
+    std::vector<std::shared_ptr<Transport>> transports)
     : remote_(std::move(remote)),
       address_(address),
       config_(std::move(config)),
-      connected_(false)
+      queue_(std::move(queue)),
+      transports_(std::move(transports)),
+      backoff_(config_->endpoint_connect_backoff, config_->endpoint_connect_backoff_max),
+      retry_count_(0),
+      transport_index_(0),
+      handshakes_(0),
+      connected_(false),
+      flush_policy_(static_cast<std::size_t>(std::max(1, config_->endpoint_writer_batch_size)),
+                    config_->endpoint_writer_batch_bytes),
+      dictionary_(config_->endpoint_dictionary_size),
+      use_dictionary_(false),
+      compression_(wire::kCompressionNone),
+      linger_armed_(false)
 #ifdef ENABLE_GRPC
       , receive_thread_running_(false)
 #endif
@@ -39,6 +187,12 @@ void EndpointWriter::Receive(std::shared_ptr<Context> context) {
     auto started = std::dynamic_pointer_cast<protoactor::Started>(
         std::static_pointer_cast<protoactor::SystemMessage>(msg));
     if (started) {
+        auto [process, exists] = context->GetActorSystem()->GetProcessRegistry()->Get(context->Self());
+        auto actor = exists ? std::dynamic_pointer_cast<ActorProcess>(process) : nullptr;
+        if (actor) {
+            mailbox_ = actor->GetMailbox();
+        }
+        self_ = context->Self();
         Initialize(context);
         return;
     }
@@ -54,17 +208,63 @@ void EndpointWriter::Receive(std::shared_ptr<Context> context) {
     // Try RemoteDeliver
     auto deliver = std::dynamic_pointer_cast<RemoteDeliver>(
         std::static_pointer_cast<SystemMessage>(msg));
+    if (deliver && deliver->system) {
+        // Priority lane: sent right away, ahead of whatever user messages are queued
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            system_queue_.push(deliver);
+        }
+        FlushSystem();
+        return;
+    }
     if (deliver) {
         // Queue RemoteDeliver message for batch sending
+        std::size_t queued;
         {
             std::lock_guard<std::mutex> lock(queue_mutex_);
             message_queue_.push(deliver);
+            queued = message_queue_.size();
         }
         
-        // If queue reaches batch size, send batch
-        if (message_queue_.size() >= static_cast<size_t>(config_->endpoint_writer_batch_size)) {
-            SendBatch(context);
+        switch (flush_policy_.OnEnqueue(queued, MailboxEmpty())) {
+            case AdaptiveFlushPolicy::Reason::Drained:
+                // Nothing else is waiting: send now rather than wait for more traffic
+                Flush(context, true);
+                break;
+            case AdaptiveFlushPolicy::Reason::BatchFull:
+            case AdaptiveFlushPolicy::Reason::Bytes:
+                Flush(context, false);
+                break;
+            case AdaptiveFlushPolicy::Reason::None:
+                break;
         }
+        ArmLingerTimer(context);
+        return;
+    }
+    
+    // Connection attempts
+    auto handshake = std::dynamic_pointer_cast<HandshakeEvent>(
+        std::static_pointer_cast<SystemMessage>(msg));
+    if (handshake) {
+        OnHandshake(context, handshake->id, handshake->timeout);
+        return;
+    }
+    auto retry = std::dynamic_pointer_cast<ConnectRetry>(
+        std::static_pointer_cast<SystemMessage>(msg));
+    if (retry) {
+        if (!connected_.load(std::memory_order_acquire) && !handshake_) {
+            transport_index_ = 0;
+            Connect(context);
+        }
+        return;
+    }
+    
+    // Max-linger timer fired
+    auto linger = std::dynamic_pointer_cast<LingerTick>(
+        std::static_pointer_cast<SystemMessage>(msg));
+    if (linger) {
+        linger_armed_ = false;
+        Flush(context, true);
         return;
     }
     
@@ -73,34 +273,72 @@ void EndpointWriter::Receive(std::shared_ptr<Context> context) {
         std::static_pointer_cast<protoactor::SystemMessage>(msg));
     if (terminated) {
         HandleDisconnect();
+        if (!transports_.empty() && remote_->GetEndpointManager()) {
+            // The next message to this address spawns fresh writers
+            remote_->GetEndpointManager()->RemoveEndpoint(address_, self_);
+        }
         return;
     }
 }
 
 void EndpointWriter::Initialize(std::shared_ptr<Context> context) {
-    // Try to connect with retries
-    int retry_count = 0;
-    bool connected = false;
-    
-    while (retry_count < config_->max_retry_count && !connected) {
-        connected = InitializeInternal();
-        if (!connected) {
-            retry_count++;
-            // Wait before retry (exponential backoff would be better)
-            std::this_thread::sleep_for(std::chrono::seconds(2));
+    retry_count_ = 0;
+    transport_index_ = 0;
+    Connect(context);
+}
+
+void EndpointWriter::Connect(std::shared_ptr<Context> context) {
+    if (transports_.empty()) {
+        // gRPC connects in one call
+        if (InitializeInternal()) {
+            OnConnected(context);
+        } else {
+            OnConnectFailed(context);
         }
-    }
-    
-    if (!connected) {
-        // Publish EndpointTerminatedEvent
-        // TODO: Publish event to event stream
         return;
     }
-    
+    // Shared memory first for same-host peers; fall back when the peer does not offer it
+    for (; transport_index_ < transports_.size(); ++transport_index_) {
+        if (ConnectTransport(transports_[transport_index_])) {
+            // OnHandshake continues once the peer answers
+            return;
+        }
+    }
+    OnConnectFailed(context);
+}
+
+void EndpointWriter::OnConnected(std::shared_ptr<Context> context) {
+    retry_count_ = 0;
     connected_.store(true, std::memory_order_release);
-    
-    // Start receiving thread (when gRPC is integrated)
-    // receive_thread_ = std::thread([this]() { ReceiveLoop(); });
+    // Send what queued up while connecting
+    Flush(context, true);
+    ArmLingerTimer(context);
+}
+
+void EndpointWriter::OnConnectFailed(std::shared_ptr<Context> context) {
+    ++retry_count_;
+    if (retry_count_ >= std::max(1, config_->max_retry_count)) {
+        auto terminated = std::make_shared<EndpointTerminatedEvent>();
+        terminated->Address = address_;
+        terminated->Writer = context->Self();
+        context->GetActorSystem()->GetEventStream()->Publish(terminated);
+        context->Send(context->Self(), terminated);
+        return;
+    }
+    auto delay = backoff_.Delay(retry_count_, Jitter());
+    auto system = context->GetActorSystem();
+    auto wheel = system ? system->GetTimerWheel() : nullptr;
+    auto self = context->Self();
+    if (!wheel) {
+        context->Send(self, std::make_shared<ConnectRetry>());
+        return;
+    }
+    std::weak_ptr<ActorSystem> weak_system = system;
+    wheel->ScheduleAt(wheel->CurrentTick() + wheel->TicksFor(delay), [weak_system, self]() {
+        if (auto system = weak_system.lock()) {
+            system->GetRoot()->Send(self, std::make_shared<ConnectRetry>());
+        }
+    });
 }
 
 bool EndpointWriter::InitializeInternal() {
@@ -129,7 +367,7 @@ bool EndpointWriter::InitializeInternal() {
         RemoteMessage connect_msg;
         ConnectRequest* connect_req = connect_msg.mutable_connect_request();
         ServerConnection* server_conn = connect_req->mutable_server_connection();
-        server_conn->set_member_id(remote_->GetActorSystem()->Id);
+        server_conn->set_member_id(remote_->GetActorSystem()->GetID());
         server_conn->set_address(remote_->GetActorSystem()->Address());
         
         // Add blocklist
@@ -139,14 +377,32 @@ bool EndpointWriter::InitializeInternal() {
                 server_conn->add_block_list(member_id);
             }
         }
+        server_conn->set_connection_dictionary(config_->endpoint_dictionary_size > 0);
+        server_conn->set_compression(static_cast<CompressionCodec>(OfferedCompression(*config_)));
         
         if (!stream_->Write(connect_msg)) {
             return false;
         }
         
-        // 5. Receive ConnectResponse
+        // 5. Receive ConnectResponse; this blocks the writer until the peer answers (the
+        // native transports complete connect and handshake asynchronously). A deadline on the
+        // context would also end the stream later, so a timer cancels the call instead if the
+        // peer has not answered within kHandshakeTimeout
+        auto answered = std::make_shared<std::atomic<bool>>(false);
+        auto wheel = remote_->GetActorSystem()->GetTimerWheel();
+        if (wheel) {
+            std::weak_ptr<grpc::ClientContext> weak_context = client_context_;
+            wheel->ScheduleAt(wheel->CurrentTick() + wheel->TicksFor(kHandshakeTimeout), [weak_context, answered]() {
+                auto context = weak_context.lock();
+                if (context && !answered->load(std::memory_order_acquire)) {
+                    context->TryCancel();
+                }
+            });
+        }
         RemoteMessage response;
-        if (!stream_->Read(&response)) {
+        bool read = stream_->Read(&response);
+        answered->store(true, std::memory_order_release);
+        if (!read) {
             return false;
         }
         
@@ -160,6 +416,11 @@ bool EndpointWriter::InitializeInternal() {
             return false;
         }
         
+        // Both ends start with empty dictionaries on every connection
+        use_dictionary_ = config_->endpoint_dictionary_size > 0 && conn_resp.connection_dictionary();
+        dictionary_.Reset();
+        compression_ = AcceptedCompression(*config_, conn_resp.compression());
+        
         // 6. Start receive loop in background thread
         receive_thread_running_.store(true, std::memory_order_release);
         receive_thread_ = std::thread([this]() { ReceiveLoop(); });
@@ -175,78 +436,236 @@ bool EndpointWriter::InitializeInternal() {
 #endif
 }
 
-void EndpointWriter::SendMessageBatch(const std::vector<std::shared_ptr<RemoteDeliver>>& batch) {
-    if (!connected_.load(std::memory_order_acquire) || batch.empty()) {
+bool EndpointWriter::ConnectTransport(const std::shared_ptr<Transport>& transport) {
+    auto system = remote_->GetActorSystem();
+    auto handshake = std::make_shared<Handshake>();
+    handshake->id = ++handshakes_;
+    std::weak_ptr<ActorSystem> weak_system = system;
+    auto self = self_;
+    auto address = address_;
+    
+    // Both callbacks report to the writer; it ignores events of handshakes it abandoned
+    auto notify = [weak_system, self](uint64_t id) {
+        auto system = weak_system.lock();
+        if (system && self) {
+            auto event = std::make_shared<HandshakeEvent>();
+            event->id = id;
+            system->GetRoot()->Send(self, event);
+        }
+    };
+    
+    TransportHandler handler;
+    handler.on_frame = [handshake, notify](const std::shared_ptr<TransportConnection>& connection,
+                                           std::shared_ptr<std::string> frame) {
+        wire::RemoteMessage message;
+        if (!wire::Decode(*frame, &message)) {
+            connection->Close();
+            return;
+        }
+        if (message.type == wire::RemoteMessage::Type::ConnectResponse) {
+            {
+                std::lock_guard<std::mutex> lock(handshake->mutex);
+                handshake->response = std::move(message.connect_response);
+                handshake->responded = true;
+            }
+            notify(handshake->id);
+        } else if (message.type == wire::RemoteMessage::Type::DisconnectRequest) {
+            connection->Close();
+        }
+    };
+    handler.on_close = [handshake, notify, weak_system, self, address](const std::shared_ptr<TransportConnection>&) {
+        bool established;
+        bool closing;
+        {
+            std::lock_guard<std::mutex> lock(handshake->mutex);
+            handshake->closed = true;
+            established = handshake->established;
+            closing = handshake->closing;
+        }
+        if (!established) {
+            // The attempt failed; the writer tries the next transport or backs off
+            notify(handshake->id);
+            return;
+        }
+        auto system = weak_system.lock();
+        if (!system || closing) {
+            return;
+        }
+        auto terminated = std::make_shared<EndpointTerminatedEvent>();
+        terminated->Address = address;
+        terminated->Writer = self;
+        system->GetEventStream()->Publish(terminated);
+        if (self) {
+            system->GetRoot()->Send(self, terminated);
+        }
+    };
+    
+    auto [connection, err] = transport->Connect(address_, handler);
+    if (err || !connection) {
+        return false;
+    }
+    
+    wire::ConnectRequest request;
+    request.member_id = system->GetID();
+    request.address = system->Address();
+    if (remote_->GetBlockList()) {
+        request.block_list = remote_->GetBlockList()->BlockedMembers();
+    }
+    request.connection_dictionary = config_->endpoint_dictionary_size > 0;
+    request.compression = OfferedCompression(*config_);
+    std::string frame;
+    wire::EncodeConnectRequest(request, &frame);
+    if (connection->Send(std::move(frame))) {
+        connection->Close();
+        return false;
+    }
+    handshake_ = handshake;
+    pending_connection_ = connection;
+    
+    auto wheel = system->GetTimerWheel();
+    if (wheel) {
+        uint64_t id = handshake->id;
+        wheel->ScheduleAt(wheel->CurrentTick() + wheel->TicksFor(kHandshakeTimeout), [weak_system, self, id]() {
+            auto system = weak_system.lock();
+            if (system && self) {
+                auto event = std::make_shared<HandshakeEvent>();
+                event->id = id;
+                event->timeout = true;
+                system->GetRoot()->Send(self, event);
+            }
+        });
+    }
+    return true;
+}
+
+void EndpointWriter::OnHandshake(std::shared_ptr<Context> context, uint64_t id, bool timeout) {
+    auto handshake = handshake_;
+    if (!handshake || handshake->id != id) {
+        // Stale: the attempt was already decided
+        return;
+    }
+    bool established = false;
+    {
+        std::lock_guard<std::mutex> lock(handshake->mutex);
+        if (handshake->responded && !handshake->closed && !handshake->response.blocked) {
+            handshake->established = true;
+            established = true;
+            use_dictionary_ = config_->endpoint_dictionary_size > 0 && handshake->response.connection_dictionary;
+            compression_ = AcceptedCompression(*config_, handshake->response.compression);
+        } else if (!timeout && !handshake->closed && !handshake->responded) {
+            return;
+        }
+    }
+    auto connection = std::move(pending_connection_);
+    handshake_.reset();
+    
+    if (established) {
+        // Both ends start with empty dictionaries on every connection
+        dictionary_.Reset();
+        connection_ = connection;
+        connection_handshake_ = handshake;
+        OnConnected(context);
         return;
     }
+    // Timed out, dropped, or the remote endpoint blocked us
+    if (connection) {
+        connection->Close();
+    }
+    ++transport_index_;
+    Connect(context);
+}
+
+void EndpointWriter::CancelHandshake() {
+    handshake_.reset();
+    if (auto connection = std::move(pending_connection_)) {
+        connection->Close();
+    }
+}
+
+std::size_t EndpointWriter::SendMessageBatch(const std::vector<std::shared_ptr<RemoteDeliver>>& batch) {
+    if (!connected_.load(std::memory_order_acquire) || batch.empty()) {
+        return 0;
+    }
+    
+    if (connection_) {
+        return SendTransportBatch(batch);
+    }
     
 #ifdef ENABLE_GRPC
     if (!stream_) {
-        return;
+        return 0;
     }
     
-    // Create MessageBatch protobuf
-    RemoteMessage remote_msg;
+    // Reuse the batch message: Clear() keeps the envelopes and their string capacity,
+    // so steady-state batches serialize without reallocating payload buffers
+    RemoteMessage& remote_msg = batch_message_;
+    remote_msg.Clear();
     MessageBatch* msg_batch = remote_msg.mutable_message_batch();
     
-    // Collect unique type names, targets, and senders
-    std::unordered_map<std::string, int32_t> type_name_map;
-    std::unordered_map<std::string, int32_t> target_map;
-    std::unordered_map<std::shared_ptr<protoactor::PID>, int32_t> sender_map;
+    // Ids come from the connection dictionary; only entries new to the peer go on the wire.
+    // A peer without dictionary support gets per-message tables (the dictionary is reset
+    // for every stream message instead).
+    if (!use_dictionary_) {
+        dictionary_.Reset();
+    } else if (dictionary_.BeginBatch()) {
+        msg_batch->set_dictionary_reset(true);
+    }
+    std::size_t total_bytes = 0;
+    std::size_t pending_bytes = 0;
+    RemoteMessage compressed;
+    
+    // Writes what is accumulated and starts a new message
+    auto write = [&]() {
+        if (msg_batch->envelopes_size() > 0 &&
+            !stream_->Write(CompressedBatch(remote_msg, compression_, config_->endpoint_compression_threshold, &compressed))) {
+            // Failed to send, disconnect
+            OnConnectionLost();
+            return false;
+        }
+        remote_msg.Clear();
+        msg_batch = remote_msg.mutable_message_batch();
+        if (!use_dictionary_) {
+            dictionary_.Reset();
+        }
+        pending_bytes = 0;
+        return true;
+    };
     
     for (const auto& deliver : batch) {
         if (!deliver || !deliver->target) {
             continue;
         }
         
+        // Serialize straight into the envelope's buffer; the batch owns it from here
+        MessageEnvelope* pb_envelope = msg_batch->add_envelopes();
         try {
-            // Serialize message
-            auto [bytes, type_name] = SerializerRegistry::Serialize(
+            const auto& type_name = SerializerRegistry::SerializeNamed(
                 deliver->message,
+                pb_envelope->mutable_message_data(),
                 deliver->serializer_id >= 0 ? deliver->serializer_id : -1);
             
-            // Add type name if not already present
-            int32_t type_id;
-            auto type_it = type_name_map.find(type_name);
-            if (type_it == type_name_map.end()) {
-                type_id = msg_batch->type_names_size();
+            bool added;
+            int32_t type_id = dictionary_.TypeName(type_name, &added);
+            if (added) {
                 msg_batch->add_type_names(type_name);
-                type_name_map[type_name] = type_id;
-            } else {
-                type_id = type_it->second;
             }
             
-            // Add target if not already present
-            int32_t target_idx;
-            std::string target_id = deliver->target->id;
-            auto target_it = target_map.find(target_id);
-            if (target_it == target_map.end()) {
-                target_idx = msg_batch->targets_size();
-                msg_batch->add_targets(target_id);
-                target_map[target_id] = target_idx;
-            } else {
-                target_idx = target_it->second;
+            int32_t target_idx = dictionary_.Target(deliver->target->id, &added);
+            if (added) {
+                msg_batch->add_targets(deliver->target->id);
             }
             
-            // Add sender if not already present
             int32_t sender_idx = 0; // 0 means no sender
             if (deliver->sender) {
-                auto sender_it = sender_map.find(deliver->sender);
-                if (sender_it == sender_map.end()) {
-                    sender_idx = msg_batch->senders_size() + 1; // 1-based index
+                sender_idx = dictionary_.Sender(*deliver->sender, &added);
+                if (added) {
                     auto* sender_pid = msg_batch->add_senders();
                     sender_pid->set_address(deliver->sender->address);
                     sender_pid->set_id(deliver->sender->id);
-                    sender_map[deliver->sender] = sender_idx;
-                } else {
-                    sender_idx = sender_it->second;
                 }
             }
             
-            // Create envelope
-            MessageEnvelope* pb_envelope = msg_batch->add_envelopes();
             pb_envelope->set_type_id(type_id);
-            pb_envelope->set_message_data(bytes.data(), bytes.size());
             pb_envelope->set_target(target_idx);
             pb_envelope->set_sender(sender_idx);
             pb_envelope->set_serializer_id(deliver->serializer_id >= 0 ? deliver->serializer_id : -1);
@@ -262,39 +681,177 @@ void EndpointWriter::SendMessageBatch(const std::vector<std::shared_ptr<RemoteDe
             if (deliver->header) {
                 // TODO: Serialize header
             }
+            
+            pending_bytes += pb_envelope->message_data().size();
+            total_bytes += pb_envelope->message_data().size();
         } catch (const std::exception& e) {
             // Log error and skip message
+            msg_batch->mutable_envelopes()->RemoveLast();
             continue;
         }
+        
+        // Byte threshold: cut the batch so one write stays bounded
+        if (flush_policy_.MaxBatchBytes() > 0 && pending_bytes >= flush_policy_.MaxBatchBytes() && !write()) {
+            return total_bytes;
+        }
     }
     
     // Send via gRPC stream
-    if (msg_batch->envelopes_size() > 0) {
-        if (!stream_->Write(remote_msg)) {
-            // Failed to send, disconnect
-            HandleDisconnect();
-        }
-    }
+    write();
+    return total_bytes;
 #else
     // gRPC not enabled
+    return 0;
 #endif
 }
 
+std::size_t EndpointWriter::SendTransportBatch(const std::vector<std::shared_ptr<RemoteDeliver>>& batch) {
+    // Same layout as the gRPC path, but encoded straight into the frame: each payload is
+    // serialized in place, so a batch costs one buffer and one write
+    std::string frame;
+    auto encoder = std::make_unique<wire::BatchEncoder>(&frame);
+    if (!use_dictionary_) {
+        dictionary_.Reset();
+    } else if (dictionary_.BeginBatch()) {
+        encoder->DictionaryReset();
+    }
+    std::size_t total_bytes = 0;
+    std::size_t pending_bytes = 0;
+    
+    // Sends what is accumulated and starts a new frame
+    auto write = [&]() {
+        if (encoder->Envelopes() > 0) {
+            encoder->Finish();
+            if (compression_ != wire::kCompressionNone && frame.size() >= config_->endpoint_compression_threshold) {
+                // Kept as it is when compressing does not make it smaller
+                std::string compressed;
+                if (wire::CompressBatch(frame, compression_, &compressed)) {
+                    frame.swap(compressed);
+                }
+            }
+            if (connection_->Send(std::move(frame))) {
+                OnConnectionLost();
+                return false;
+            }
+        }
+        frame = std::string();
+        encoder = std::make_unique<wire::BatchEncoder>(&frame);
+        if (!use_dictionary_) {
+            dictionary_.Reset();
+        }
+        pending_bytes = 0;
+        return true;
+    };
+    
+    for (const auto& deliver : batch) {
+        if (!deliver || !deliver->target) {
+            continue;
+        }
+        
+        int32_t serializer_id = deliver->serializer_id >= 0 ? deliver->serializer_id : -1;
+        std::string* payload = encoder->BeginEnvelope();
+        const std::string* type_name;
+        try {
+            type_name = &SerializerRegistry::SerializeNamed(deliver->message, payload, serializer_id);
+        } catch (const std::exception& e) {
+            // Skip messages that cannot be serialized
+            encoder->AbortEnvelope();
+            continue;
+        }
+        
+        wire::Envelope fields;
+        bool type_added;
+        bool target_added;
+        bool sender_added = false;
+        fields.type_id = dictionary_.TypeName(*type_name, &type_added);
+        fields.target = dictionary_.Target(deliver->target->id, &target_added);
+        if (deliver->sender) {
+            fields.sender = dictionary_.Sender(*deliver->sender, &sender_added);
+            fields.sender_request_id = deliver->sender->request_id;
+        }
+        fields.serializer_id = serializer_id;
+        fields.target_request_id = deliver->target->request_id;
+        std::size_t bytes = encoder->EndEnvelope(fields);
+        
+        // New dictionary entries follow the envelope; repeated fields keep their order and
+        // the reader resolves ids only after the whole batch is decoded
+        if (type_added) {
+            encoder->TypeName(*type_name);
+        }
+        if (target_added) {
+            encoder->Target(deliver->target->id);
+        }
+        if (sender_added) {
+            encoder->Sender(deliver->sender->address, deliver->sender->id);
+        }
+        pending_bytes += bytes;
+        total_bytes += bytes;
+        
+        // Byte threshold: cut the batch so one frame stays bounded
+        if (flush_policy_.MaxBatchBytes() > 0 && pending_bytes >= flush_policy_.MaxBatchBytes() && !write()) {
+            return total_bytes;
+        }
+    }
+    
+    write();
+    return total_bytes;
+}
+
 void EndpointWriter::HandleDisconnect() {
     connected_.store(false, std::memory_order_release);
     
+    CancelHandshake();
     CloseClientConn();
     
-    // Clear message queue
+    // Unsent messages go to dead letters
+    std::queue<std::shared_ptr<RemoteDeliver>> dropped;
+    std::queue<std::shared_ptr<RemoteDeliver>> dropped_system;
     {
         std::lock_guard<std::mutex> lock(queue_mutex_);
-        while (!message_queue_.empty()) {
-            message_queue_.pop();
+        dropped.swap(message_queue_);
+        dropped_system.swap(system_queue_);
+    }
+    if (queue_) {
+        queue_->Release(static_cast<int>(dropped.size()));
+    }
+    for (; !dropped_system.empty(); dropped_system.pop()) {
+        dropped.push(std::move(dropped_system.front()));
+    }
+    auto system = remote_->GetActorSystem();
+    auto dead_letter = system ? system->GetDeadLetter() : nullptr;
+    for (; !dropped.empty(); dropped.pop()) {
+        const auto& deliver = dropped.front();
+        if (dead_letter && deliver && deliver->target) {
+            dead_letter->SendUserMessage(deliver->target,
+                std::make_shared<MessageEnvelope>(nullptr, deliver->message, deliver->sender));
         }
     }
 }
 
+void EndpointWriter::OnConnectionLost() {
+    // Closing it here is not reported by the transport, so report it the way a drop by the
+    // peer would be
+    HandleDisconnect();
+    auto system = remote_->GetActorSystem();
+    if (!system) {
+        return;
+    }
+    auto terminated = std::make_shared<EndpointTerminatedEvent>();
+    terminated->Address = address_;
+    terminated->Writer = self_;
+    system->GetEventStream()->Publish(terminated);
+}
+
 void EndpointWriter::CloseClientConn() {
+    if (auto handshake = std::move(connection_handshake_)) {
+        std::lock_guard<std::mutex> lock(handshake->mutex);
+        handshake->closing = true;
+    }
+    if (connection_) {
+        connection_->Close();
+        connection_.reset();
+    }
+    
 #ifdef ENABLE_GRPC
     receive_thread_running_.store(false, std::memory_order_release);
     
@@ -336,6 +893,7 @@ void EndpointWriter::ReceiveLoop() {
             // Publish EndpointTerminatedEvent
             auto terminated = std::make_shared<EndpointTerminatedEvent>();
             terminated->Address = address_;
+            terminated->Writer = self_;
             remote_->GetActorSystem()->EventStream->Publish(terminated);
             break;
         }
@@ -347,31 +905,99 @@ void EndpointWriter::ReceiveLoop() {
     connected_.store(false, std::memory_order_release);
     auto terminated = std::make_shared<EndpointTerminatedEvent>();
     terminated->Address = address_;
+    terminated->Writer = self_;
     remote_->GetActorSystem()->EventStream->Publish(terminated);
 #endif
 }
 
-void EndpointWriter::SendBatch(std::shared_ptr<Context> context) {
-    std::vector<std::shared_ptr<RemoteDeliver>> batch;
-    
-    {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        size_t batch_size = std::min(
-            message_queue_.size(),
-            static_cast<size_t>(config_->endpoint_writer_batch_size));
-        
-        for (size_t i = 0; i < batch_size; ++i) {
-            if (!message_queue_.empty()) {
-                batch.push_back(message_queue_.front());
+void EndpointWriter::Flush(std::shared_ptr<Context>, bool all) {
+    if (!connected_.load(std::memory_order_acquire)) {
+        // Messages wait until the connection is up (bounded by the endpoint queue)
+        return;
+    }
+    FlushSystem();
+    while (true) {
+        std::vector<std::shared_ptr<RemoteDeliver>> batch;
+        bool backlog;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            size_t batch_size = std::min(message_queue_.size(), flush_policy_.BatchLimit());
+            batch.reserve(batch_size);
+            for (size_t i = 0; i < batch_size; ++i) {
+                batch.push_back(std::move(message_queue_.front()));
                 message_queue_.pop();
             }
+            backlog = !message_queue_.empty();
+        }
+        
+        if (batch.empty()) {
+            return;
+        }
+        auto bytes = SendMessageBatch(batch);
+        flush_policy_.OnFlushed(batch.size(), bytes, backlog);
+        if (queue_) {
+            queue_->Release(static_cast<int>(batch.size()));
+        }
+        if (!all || !backlog) {
+            return;
         }
     }
-    
-    if (!batch.empty()) {
+}
+
+void EndpointWriter::FlushSystem() {
+    if (!connected_.load(std::memory_order_acquire)) {
+        return;
+    }
+    // Own small batches, so a burst of Terminated messages does not form one huge frame
+    std::size_t limit = static_cast<std::size_t>(std::max(1, config_->endpoint_writer_system_batch_size));
+    while (connected_.load(std::memory_order_acquire)) {
+        std::vector<std::shared_ptr<RemoteDeliver>> batch;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            std::size_t batch_size = std::min(system_queue_.size(), limit);
+            batch.reserve(batch_size);
+            for (std::size_t i = 0; i < batch_size; ++i) {
+                batch.push_back(std::move(system_queue_.front()));
+                system_queue_.pop();
+            }
+        }
+        if (batch.empty()) {
+            return;
+        }
         SendMessageBatch(batch);
     }
 }
 
+void EndpointWriter::ArmLingerTimer(std::shared_ptr<Context> context) {
+    if (linger_armed_ || config_->endpoint_writer_max_linger.count() <= 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (message_queue_.empty()) {
+            return;
+        }
+    }
+    auto system = context->GetActorSystem();
+    auto wheel = system ? system->GetTimerWheel() : nullptr;
+    if (!wheel) {
+        return;
+    }
+    linger_armed_ = true;
+    std::weak_ptr<ActorSystem> weak_system = system;
+    auto self = context->Self();
+    wheel->ScheduleAt(wheel->CurrentTick() + wheel->TicksFor(config_->endpoint_writer_max_linger),
+        [weak_system, self]() {
+            if (auto system = weak_system.lock()) {
+                system->GetRoot()->Send(self, std::make_shared<LingerTick>());
+            }
+        });
+}
+
+bool EndpointWriter::MailboxEmpty() const {
+    auto mailbox = mailbox_.lock();
+    return !mailbox || mailbox->UserMessageCount() == 0;
+}
+
 } // namespace remote
 } // namespace protoactor
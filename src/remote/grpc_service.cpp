@@ -1,6 +1,9 @@
 #include "internal/remote/grpc_service.h"
 #include "external/remote/remote.h"
+#include "internal/remote/connection_dictionary.h"
 #include "internal/remote/endpoint_reader.h"
+#include "internal/remote/lz4.h"
+#include "internal/remote/wire.h"
 #include "internal/remote/serializer.h"
 #include "external/actor_system.h"
 #include "internal/process_registry.h"
@@ -10,7 +13,8 @@ namespace protoactor {
 namespace remote {
 
 GrpcService::GrpcService(std::shared_ptr<Remote> remote)
-    : remote_(remote) {
+    : remote_(remote),
+      endpoint_reader_(remote ? std::make_shared<EndpointReader>(remote) : nullptr) {
 }
 
 grpc::Status GrpcService::Receive(
@@ -24,14 +28,42 @@ grpc::Status GrpcService::Receive(
     // Store connection for disconnect handling
     // TODO: Store in EndpointManager for disconnect management
     
-    // Receive loop
+    // Receive loop; the dictionary lives as long as the stream
+    ConnectionDictionaryDecoder dictionary(remote_->GetActorSystem()->Address(),
+                                           remote_->GetConfig()->endpoint_dictionary_size);
+    bool use_dictionary = false;
     RemoteMessage msg;
-    while (stream->Read(&msg)) {
+    while (true) {
+        // Stop reading while the reader is above its high-water mark; flow control of the
+        // stream then slows the sender
+        while (endpoint_reader_ && !endpoint_reader_->WaitWhilePaused(std::chrono::milliseconds(100))) {
+            if (context->IsCancelled()) {
+                return grpc::Status::CANCELLED;
+            }
+        }
+        if (!stream->Read(&msg)) {
+            break;
+        }
         if (msg.has_message_batch()) {
-            HandleMessageBatch(msg.message_batch());
+            if (msg.message_batch().compression() != COMPRESSION_NONE && !DecompressBatch(&msg)) {
+                // Undecodable compressed batch: drop the stream
+                break;
+            }
+            if (!use_dictionary) {
+                // Peer sends self-contained batches
+                dictionary.Reset();
+            }
+            // Hand the message over to the reader; payloads are parsed in place from it
+            if (!HandleMessageBatch(std::make_shared<const RemoteMessage>(std::move(msg)), dictionary)) {
+                // Peer exceeded the dictionary bound: drop the stream
+                break;
+            }
+            msg.Clear();
         } else if (msg.has_connect_request()) {
             ConnectResponse response;
             HandleConnectRequest(msg.connect_request(), &response);
+            use_dictionary = response.connection_dictionary();
+            dictionary.Reset();
             
             RemoteMessage response_msg;
             *response_msg.mutable_connect_response() = response;
@@ -68,55 +100,76 @@ grpc::Status GrpcService::GetProcessDiagnostics(
     return grpc::Status(grpc::StatusCode::UNIMPLEMENTED, "Not implemented");
 }
 
-void GrpcService::HandleMessageBatch(const MessageBatch& batch) {
-    if (!remote_) {
-        return;
+bool GrpcService::DecompressBatch(RemoteMessage* message) {
+    // Same checks as the native transports (wire::DecompressBatch)
+    const MessageBatch& batch = message->message_batch();
+    wire::MessageBatch compressed;
+    compressed.compression = static_cast<uint32_t>(batch.compression());
+    compressed.uncompressed_size = batch.uncompressed_size();
+    compressed.compressed = batch.compressed_batch();
+    std::string body;
+    wire::MessageBatch ignored;
+    if (!wire::DecompressBatch(compressed, &body, &ignored)) {
+        return false;
+    }
+    MessageBatch decompressed;
+    if (!decompressed.ParseFromString(body)) {
+        return false;
+    }
+    message->mutable_message_batch()->Swap(&decompressed);
+    return true;
+}
+
+bool GrpcService::HandleMessageBatch(
+    std::shared_ptr<const RemoteMessage> message,
+    ConnectionDictionaryDecoder& dictionary) {
+    if (!remote_ || !endpoint_reader_) {
+        return true;
     }
     
-    // Create endpoint reader to process the batch
-    auto endpoint_reader = std::make_shared<EndpointReader>(remote_);
+    const MessageBatch& batch = message->message_batch();
     
-    // Process each envelope in the batch
+    // Apply the entries this batch adds to the connection dictionary
+    if (batch.dictionary_reset()) {
+        dictionary.Reset();
+    }
+    if (!dictionary.Admit(static_cast<std::size_t>(batch.type_names_size() + batch.targets_size() + batch.senders_size()),
+                          static_cast<std::size_t>(batch.envelopes_size()))) {
+        return false;
+    }
+    for (const auto& type_name : batch.type_names()) {
+        dictionary.AddTypeName(type_name);
+    }
+    for (const auto& target_id : batch.targets()) {
+        dictionary.AddTarget(target_id);
+    }
+    for (const auto& sender_pid : batch.senders()) {
+        dictionary.AddSender(sender_pid.address(), sender_pid.id());
+    }
+    
+    // Resolve ids on the stream thread (cheap); deserialization runs on the reader's workers
+    auto inbound = std::make_shared<InboundBatch>();
+    inbound->owner = message;
+    inbound->envelopes.reserve(batch.envelopes_size());
     for (int i = 0; i < batch.envelopes_size(); ++i) {
         const auto& envelope = batch.envelopes(i);
+        auto target = dictionary.Target(envelope.target(), envelope.target_request_id());
+        auto sender = dictionary.Sender(envelope.sender(), envelope.sender_request_id());
+        const std::string* type_name = dictionary.TypeName(envelope.type_id());
         
-        // Deserialize target PID (targets is a string array of IDs)
-        std::shared_ptr<protoactor::PID> target;
-        if (envelope.target() >= 0 && envelope.target() < batch.targets_size()) {
-            const std::string& target_id = batch.targets(envelope.target());
-            std::string address = remote_->GetActorSystem()->Address();
-            target = std::make_shared<protoactor::PID>(address, target_id);
-            if (envelope.target_request_id() > 0) {
-                target->RequestId = envelope.target_request_id();
-            }
-        }
-        
-        // Deserialize sender PID (senders is a PID array)
-        std::shared_ptr<protoactor::PID> sender;
-        if (envelope.sender() > 0 && envelope.sender() <= batch.senders_size()) {
-            // sender index is 1-based (0 means no sender)
-            const auto& sender_pid = batch.senders(envelope.sender() - 1);
-            sender = std::make_shared<protoactor::PID>(
-                sender_pid.address(), sender_pid.id());
-            if (envelope.sender_request_id() > 0) {
-                sender->RequestId = envelope.sender_request_id();
-            }
-        }
-        
-        // Get type name
-        std::string type_name;
-        if (envelope.type_id() >= 0 && envelope.type_id() < batch.type_names_size()) {
-            type_name = batch.type_names(envelope.type_id());
-        }
-        
-        // Deserialize and deliver message
-        if (target && !type_name.empty()) {
-            std::vector<uint8_t> data(envelope.message_data().begin(), 
-                                      envelope.message_data().end());
-            endpoint_reader->DeserializeAndDeliver(
-                data, type_name, envelope.serializer_id(), target, sender);
+        if (target && type_name && !type_name->empty()) {
+            InboundEnvelope item;
+            item.data = envelope.message_data();
+            item.type_name = *type_name;
+            item.serializer_id = envelope.serializer_id();
+            item.target = std::move(target);
+            item.sender = std::move(sender);
+            inbound->envelopes.push_back(std::move(item));
         }
     }
+    
+    endpoint_reader_->OnMessageBatch(std::move(inbound));
+    return true;
 }
 
 void GrpcService::HandleConnectRequest(const ConnectRequest& request, ConnectResponse* response) {
@@ -139,6 +192,9 @@ void GrpcService::HandleConnectRequest(const ConnectRequest& request, ConnectRes
         // Set response
         response->set_member_id(remote_->GetActorSystem()->Id);
         response->set_blocked(blocked);
+        response->set_connection_dictionary(
+            server_conn.connection_dictionary() && remote_->GetConfig()->endpoint_dictionary_size > 0);
+        response->set_compression(static_cast<CompressionCodec>(wire::NegotiateCompression(server_conn.compression())));
     } else if (request.has_client_connection()) {
         // Client connection (outgoing connection)
         // TODO: Handle client connection
@@ -0,0 +1,333 @@
+#include "internal/remote/inprocess_transport.h"
+#include <cstdlib>
+#include <deque>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace protoactor {
+namespace remote {
+
+namespace {
+
+constexpr int kMaxPort = 65535;
+
+// Listening in-process transports by address, shared by every actor system of the process
+struct Listeners {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::weak_ptr<InProcessTransport>> by_address;
+    int next_port = 1;
+};
+
+Listeners& GlobalListeners() {
+    // Never destroyed: transports may be stopped from static destructors
+    static Listeners* listeners = new Listeners();
+    return *listeners;
+}
+
+bool ParseAddress(const std::string& address, std::string* host, int* port) {
+    auto colon = address.rfind(':');
+    if (colon == std::string::npos || colon + 1 == address.size()) {
+        return false;
+    }
+    char* end = nullptr;
+    long value = std::strtol(address.c_str() + colon + 1, &end, 10);
+    if (*end != '\0' || value < 0 || value > kMaxPort) {
+        return false;
+    }
+    *host = address.substr(0, colon);
+    *port = static_cast<int>(value);
+    return true;
+}
+
+} // namespace
+
+/**
+ * One end of a linked pair. Frames sent on one end are posted to the other end's transport
+ * thread; on_close is posted under the same lock, so it always follows the frames already
+ * delivered to that end. While reading is paused, frames are held by the receiving end and
+ * posted in order on resume (there is no socket buffer to leave them in).
+ */
+class InProcessTransport::Connection : public TransportConnection,
+                                       public std::enable_shared_from_this<Connection> {
+public:
+    Connection(std::weak_ptr<InProcessTransport> owner, TransportHandler handler)
+        : owner_(std::move(owner)), handler_(std::move(handler)), closed_(false) {
+    }
+
+    std::error_code Send(std::string frame) override {
+        if (closed_.load(std::memory_order_acquire)) {
+            return std::make_error_code(std::errc::not_connected);
+        }
+        auto peer = peer_.lock();
+        if (!peer || !peer->Deliver(std::make_shared<std::string>(std::move(frame)))) {
+            return std::make_error_code(std::errc::not_connected);
+        }
+        return std::error_code();
+    }
+
+    void Close() override {
+        std::shared_ptr<InProcessTransport> owner;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (closed_.exchange(true, std::memory_order_acq_rel)) {
+                return;
+            }
+            owner = owner_.lock();
+            if (owner) {
+                auto self = shared_from_this();
+                owner->Post([self]() {
+                    if (self->handler_.on_close) {
+                        self->handler_.on_close(self);
+                    }
+                });
+            }
+        }
+        if (owner) {
+            owner->Untrack(shared_from_this());
+        }
+        if (auto peer = peer_.lock()) {
+            peer->Close();
+        }
+    }
+
+    bool Closed() const override {
+        return closed_.load(std::memory_order_acquire);
+    }
+
+    void PauseReading(bool paused) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        paused_ = paused;
+        if (paused || held_.empty()) {
+            return;
+        }
+        auto owner = owner_.lock();
+        if (owner && !closed_.load(std::memory_order_relaxed)) {
+            for (auto& frame : held_) {
+                Post(*owner, std::move(frame));
+            }
+        }
+        held_.clear();
+    }
+
+    void Link(const std::shared_ptr<Connection>& peer) {
+        peer_ = peer;
+    }
+
+private:
+    std::weak_ptr<InProcessTransport> owner_;
+    TransportHandler handler_;
+    std::weak_ptr<Connection> peer_;
+    std::mutex mutex_;
+    std::atomic<bool> closed_;
+    bool paused_ = false;                             // Guarded by mutex_
+    std::deque<std::shared_ptr<std::string>> held_;   // Frames received while paused
+
+    bool Deliver(std::shared_ptr<std::string> frame) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        auto owner = owner_.lock();
+        if (!owner) {
+            return false;
+        }
+        if (paused_) {
+            held_.push_back(std::move(frame));
+            return true;
+        }
+        Post(*owner, std::move(frame));
+        return true;
+    }
+
+    // mutex_ held
+    void Post(InProcessTransport& owner, std::shared_ptr<std::string> frame) {
+        auto self = shared_from_this();
+        owner.Post([self, frame]() {
+            if (self->handler_.on_frame) {
+                self->handler_.on_frame(self, frame);
+            }
+        });
+    }
+};
+
+InProcessTransport::InProcessTransport()
+    : stopped_(false), queue_closed_(false) {
+    thread_ = std::thread([this]() { Run(); });
+}
+
+InProcessTransport::~InProcessTransport() {
+    Stop();
+}
+
+std::error_code InProcessTransport::Listen(const std::string& address, TransportHandler handler) {
+    if (stopped_.load(std::memory_order_acquire)) {
+        return std::make_error_code(std::errc::operation_canceled);
+    }
+    std::string host;
+    int port;
+    if (!ParseAddress(address, &host, &port)) {
+        return std::make_error_code(std::errc::invalid_argument);
+    }
+    std::lock_guard<std::mutex> lock(listen_mutex_);
+    if (!listen_address_.empty()) {
+        return std::make_error_code(std::errc::already_connected);
+    }
+
+    auto& listeners = GlobalListeners();
+    std::lock_guard<std::mutex> registry_lock(listeners.mutex);
+    auto taken = [&listeners](const std::string& candidate) {
+        auto it = listeners.by_address.find(candidate);
+        return it != listeners.by_address.end() && !it->second.expired();
+    };
+    std::string bound = address;
+    if (port == 0) {
+        bool found = false;
+        for (int attempt = 0; attempt < kMaxPort && !found; ++attempt) {
+            bound = host + ":" + std::to_string(listeners.next_port);
+            listeners.next_port = listeners.next_port % kMaxPort + 1;
+            found = !taken(bound);
+        }
+        if (!found) {
+            return std::make_error_code(std::errc::address_not_available);
+        }
+    } else if (taken(bound)) {
+        return std::make_error_code(std::errc::address_in_use);
+    }
+    listeners.by_address[bound] = weak_from_this();
+    listen_address_ = bound;
+    accept_handler_ = std::move(handler);
+    return std::error_code();
+}
+
+std::string InProcessTransport::ListenAddress() const {
+    std::lock_guard<std::mutex> lock(listen_mutex_);
+    return listen_address_;
+}
+
+std::pair<std::shared_ptr<TransportConnection>, std::error_code> InProcessTransport::Connect(
+    const std::string& address,
+    TransportHandler handler) {
+    if (stopped_.load(std::memory_order_acquire)) {
+        return {nullptr, std::make_error_code(std::errc::operation_canceled)};
+    }
+    std::shared_ptr<InProcessTransport> listener;
+    {
+        auto& listeners = GlobalListeners();
+        std::lock_guard<std::mutex> lock(listeners.mutex);
+        auto it = listeners.by_address.find(address);
+        if (it != listeners.by_address.end()) {
+            listener = it->second.lock();
+        }
+    }
+    if (!listener || listener->stopped_.load(std::memory_order_acquire)) {
+        return {nullptr, std::make_error_code(std::errc::connection_refused)};
+    }
+    TransportHandler accept_handler;
+    {
+        std::lock_guard<std::mutex> lock(listener->listen_mutex_);
+        accept_handler = listener->accept_handler_;
+    }
+
+    auto local = std::make_shared<Connection>(weak_from_this(), std::move(handler));
+    auto remote = std::make_shared<Connection>(listener, std::move(accept_handler));
+    local->Link(remote);
+    remote->Link(local);
+    Track(local);
+    listener->Track(remote);
+    if (listener->stopped_.load(std::memory_order_acquire)) {
+        local->Close();
+        return {nullptr, std::make_error_code(std::errc::connection_refused)};
+    }
+    return {local, std::error_code()};
+}
+
+void InProcessTransport::Stop() {
+    if (stopped_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(listen_mutex_);
+        if (!listen_address_.empty()) {
+            auto& listeners = GlobalListeners();
+            std::lock_guard<std::mutex> registry_lock(listeners.mutex);
+            auto it = listeners.by_address.find(listen_address_);
+            if (it != listeners.by_address.end()) {
+                auto registered = it->second.lock();
+                if (!registered || registered.get() == this) {
+                    listeners.by_address.erase(it);
+                }
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<Connection>> open;
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        open.assign(connections_.begin(), connections_.end());
+    }
+    for (auto& connection : open) {
+        connection->Close();
+    }
+
+    // Deliver what is queued (including the on_close callbacks above), then exit
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        queue_closed_ = true;
+    }
+    queue_cv_.notify_one();
+    if (thread_.joinable()) {
+        if (thread_.get_id() == std::this_thread::get_id()) {
+            thread_.detach();
+        } else {
+            thread_.join();
+        }
+    }
+}
+
+std::size_t InProcessTransport::Connections() const {
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    return connections_.size();
+}
+
+void InProcessTransport::Post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (queue_closed_) {
+            return;
+        }
+        queue_.push_back(std::move(task));
+    }
+    queue_cv_.notify_one();
+}
+
+void InProcessTransport::Run() {
+    std::deque<std::function<void()>> tasks;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cv_.wait(lock, [this]() { return !queue_.empty() || queue_closed_; });
+            if (queue_.empty()) {
+                return;
+            }
+            tasks.swap(queue_);
+        }
+        for (auto& task : tasks) {
+            task();
+        }
+        tasks.clear();
+    }
+}
+
+void InProcessTransport::Track(const std::shared_ptr<Connection>& connection) {
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    connections_.insert(connection);
+}
+
+void InProcessTransport::Untrack(const std::shared_ptr<Connection>& connection) {
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    connections_.erase(connection);
+}
+
+} // namespace remote
+} // namespace protoactor
@@ -0,0 +1,179 @@
+#include "internal/remote/lz4.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace protoactor {
+namespace remote {
+namespace lz4 {
+
+namespace {
+
+constexpr std::size_t kMinMatch = 4;
+// The block format requires the last 5 bytes to be literals and the last match to start
+// at least 12 bytes before the end
+constexpr std::size_t kLastLiterals = 5;
+constexpr std::size_t kMatchStartLimit = 12;
+constexpr std::size_t kMaxOffset = 65535;
+constexpr int kHashBits = 13;
+// Misses before the search step grows by one (LZ4's skip strength)
+constexpr int kSkipShift = 6;
+
+uint32_t Read32(const char* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t Hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - kHashBits);
+}
+
+void WriteLength(std::string* out, std::size_t length) {
+    for (; length >= 255; length -= 255) {
+        out->push_back(static_cast<char>(255));
+    }
+    out->push_back(static_cast<char>(length));
+}
+
+// One sequence: literals, then a match (match_length 0 for the final literals-only sequence)
+void WriteSequence(std::string* out, const char* literals, std::size_t literal_length,
+                   std::size_t offset, std::size_t match_length) {
+    std::size_t match_code = match_length > 0 ? match_length - kMinMatch : 0;
+    auto token = static_cast<uint8_t>((std::min<std::size_t>(literal_length, 15) << 4) |
+                                      std::min<std::size_t>(match_code, 15));
+    out->push_back(static_cast<char>(token));
+    if (literal_length >= 15) {
+        WriteLength(out, literal_length - 15);
+    }
+    out->append(literals, literal_length);
+    if (match_length == 0) {
+        return;
+    }
+    out->push_back(static_cast<char>(offset & 0xFF));
+    out->push_back(static_cast<char>(offset >> 8));
+    if (match_code >= 15) {
+        WriteLength(out, match_code - 15);
+    }
+}
+
+bool ReadLength(std::string_view in, std::size_t* pos, std::size_t* length) {
+    uint8_t byte;
+    do {
+        if (*pos >= in.size()) {
+            return false;
+        }
+        byte = static_cast<uint8_t>(in[(*pos)++]);
+        *length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+} // namespace
+
+void Compress(std::string_view in, std::string* out) {
+    const char* base = in.data();
+    const std::size_t size = in.size();
+    out->reserve(out->size() + size + size / 255 + 16);
+
+    std::size_t anchor = 0;
+    if (size > kMatchStartLimit) {
+        // Positions of recently seen 4-byte sequences; stale or colliding entries are
+        // rejected by comparing the bytes
+        std::vector<uint32_t> table(std::size_t(1) << kHashBits, 0);
+        const std::size_t match_start_end = size - kMatchStartLimit;
+        const std::size_t match_end = size - kLastLiterals;
+        std::size_t pos = 0;
+        while (pos < match_start_end) {
+            uint32_t sequence = Read32(base + pos);
+            uint32_t& slot = table[Hash(sequence)];
+            std::size_t candidate = slot;
+            slot = static_cast<uint32_t>(pos);
+            if (candidate >= pos || pos - candidate > kMaxOffset || Read32(base + candidate) != sequence) {
+                pos += 1 + ((pos - anchor) >> kSkipShift);
+                continue;
+            }
+
+            std::size_t length = kMinMatch;
+            while (pos + length < match_end && base[candidate + length] == base[pos + length]) {
+                ++length;
+            }
+            while (pos > anchor && candidate > 0 && base[pos - 1] == base[candidate - 1]) {
+                --pos;
+                --candidate;
+                ++length;
+            }
+            WriteSequence(out, base + anchor, pos - anchor, pos - candidate, length);
+            pos += length;
+            anchor = pos;
+        }
+    }
+    WriteSequence(out, base + anchor, size - anchor, 0, 0);
+}
+
+bool Decompress(std::string_view in, std::size_t size, std::string* out) {
+    const std::size_t start = out->size();
+    out->resize(start + size);
+    char* dst = &(*out)[0] + start;
+    std::size_t pos = 0;
+    std::size_t written = 0;
+
+    auto fail = [out, start]() {
+        out->resize(start);
+        return false;
+    };
+
+    while (true) {
+        if (pos >= in.size()) {
+            return fail();
+        }
+        auto token = static_cast<uint8_t>(in[pos++]);
+
+        std::size_t literal_length = token >> 4;
+        if (literal_length == 15 && !ReadLength(in, &pos, &literal_length)) {
+            return fail();
+        }
+        if (literal_length > in.size() - pos || literal_length > size - written) {
+            return fail();
+        }
+        std::memcpy(dst + written, in.data() + pos, literal_length);
+        pos += literal_length;
+        written += literal_length;
+        if (pos == in.size()) {
+            break;
+        }
+
+        if (in.size() - pos < 2) {
+            return fail();
+        }
+        std::size_t offset = static_cast<uint8_t>(in[pos]) | (static_cast<std::size_t>(static_cast<uint8_t>(in[pos + 1])) << 8);
+        pos += 2;
+        std::size_t match_length = token & 0x0F;
+        if (match_length == 15 && !ReadLength(in, &pos, &match_length)) {
+            return fail();
+        }
+        match_length += kMinMatch;
+        if (offset == 0 || offset > written || match_length > size - written) {
+            return fail();
+        }
+        const char* match = dst + written - offset;
+        if (offset >= match_length) {
+            std::memcpy(dst + written, match, match_length);
+        } else {
+            // Overlapping match repeats the last offset bytes
+            for (std::size_t i = 0; i < match_length; ++i) {
+                dst[written + i] = match[i];
+            }
+        }
+        written += match_length;
+    }
+    if (written != size) {
+        return fail();
+    }
+    return true;
+}
+
+} // namespace lz4
+} // namespace remote
+} // namespace protoactor
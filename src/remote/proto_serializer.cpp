@@ -10,24 +10,38 @@ namespace remote {
  * 
  * This is a placeholder implementation. When gRPC and Protobuf are integrated,
  * this will serialize/deserialize messages using Protobuf.
+ *
+ * The vector-based methods wrap the zero-copy overloads, so the protobuf integration only
+ * has to fill in SerializeTo/DeserializeFrom. Until then SerializeTo appends nothing.
  */
 class ProtoSerializer : public Serializer {
 public:
     std::vector<uint8_t> Serialize(std::shared_ptr<void> message) override {
+        std::string bytes;
+        SerializeTo(std::move(message), &bytes);
+        return std::vector<uint8_t>(bytes.begin(), bytes.end());
+    }
+    
+    std::shared_ptr<void> Deserialize(const std::string& type_name, const std::vector<uint8_t>& bytes) override {
+        return DeserializeFrom(type_name, std::string_view(
+            reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+    }
+    
+    std::size_t SerializeTo(std::shared_ptr<void> message, std::string*) override {
         // TODO: When Protobuf is integrated:
         // 1. Get message type name
         // 2. Convert message to protobuf Message
-        // 3. Serialize to bytes
+        // 3. Append with Message::AppendToString(out) (no intermediate buffer)
         
-        // Placeholder: return empty vector
-        return std::vector<uint8_t>();
+        // Placeholder: append nothing
+        return 0;
     }
     
-    std::shared_ptr<void> Deserialize(const std::string& type_name, const std::vector<uint8_t>& bytes) override {
+    std::shared_ptr<void> DeserializeFrom(const std::string& type_name, std::string_view bytes) override {
         // TODO: When Protobuf is integrated:
         // 1. Look up message type by name
         // 2. Create protobuf Message instance
-        // 3. Deserialize from bytes
+        // 3. Parse in place with Message::ParseFromArray(bytes.data(), bytes.size())
         // 4. Convert to C++ message type
         
         // Placeholder: return nullptr
@@ -3,10 +3,17 @@
 #include "internal/remote/serializer.h"
 #include "internal/remote/grpc_service.h"
 #include "internal/remote/blocklist.h"
+#include "internal/remote/inprocess_transport.h"
+#include "internal/remote/remote_process.h"
+#include "internal/remote/shm_transport.h"
+#include "internal/remote/tcp_transport.h"
+#include "internal/remote/transport_service.h"
+#include "internal/process_registry.h"
 #include "external/actor_system.h"
 #include "external/props.h"
 #include "external/pid.h"
 #include "internal/log.h"
+#include <iostream>
 #include <sstream>
 #include <thread>
 #include <stdexcept>
@@ -26,10 +33,27 @@ Config::Config()
       port(8080),
       advertised_host(""),
       endpoint_writer_batch_size(1000),
+      endpoint_writer_batch_bytes(1024 * 1024),
+      endpoint_writer_max_linger(5),
       endpoint_writer_queue_size(1000000),
+      endpoint_writer_queue_policy(EndpointQueuePolicy::DeadLetter),
+      endpoint_writer_stripes(1),
+      endpoint_writer_system_batch_size(32),
+      endpoint_reader_workers(0),
+      endpoint_reader_high_water(100000),
+      endpoint_dictionary_size(65536),
+      endpoint_compression(BatchCompression::None),
+      endpoint_compression_threshold(4096),
       endpoint_manager_batch_size(1000),
       endpoint_manager_queue_size(1000000),
-      max_retry_count(5) {
+      max_retry_count(5),
+      endpoint_connect_backoff(100),
+      endpoint_connect_backoff_max(10000),
+      transport(TransportKind::Grpc),
+      transport_io_threads(2),
+      shared_memory_transport(true),
+      shared_memory_ring_bytes(4 * 1024 * 1024),
+      shared_memory_spin(50) {
 }
 
 std::string Config::Address() const {
@@ -62,10 +86,14 @@ std::shared_ptr<Remote> Remote::Start(
     // Initialize endpoint manager after remote is created
     remote->endpoint_manager_ = std::make_shared<EndpointManager>(remote);
     
-    // Start gRPC server if enabled
+    if (config->transport == TransportKind::Grpc) {
+        // Start gRPC server if enabled
 #ifdef ENABLE_GRPC
-    remote->StartGrpcServer();
+        remote->StartGrpcServer();
 #endif
+    } else {
+        remote->StartTransport();
+    }
     
     return remote;
 }
@@ -127,12 +155,75 @@ void Remote::StopGrpcServer(bool graceful) {
 #endif
 }
 
+void Remote::StartTransport() {
+    std::shared_ptr<Transport> transport;
+    if (config_->transport == TransportKind::InProcess) {
+        transport = std::make_shared<InProcessTransport>();
+    } else {
+        transport = std::make_shared<TcpTransport>(config_->transport_io_threads);
+    }
+    auto service = std::make_shared<TransportService>(shared_from_this());
+    
+    std::string address = config_->Address();
+    auto err = transport->Listen(address, service->Handler());
+    if (err) {
+        transport->Stop();
+        throw std::runtime_error("Failed to listen on " + address + ": " + err.message());
+    }
+    transport_ = transport;
+    transport_service_ = service;
+    
+    // Port 0 picks a free port; PIDs must carry the real one
+    auto listen_address = transport->ListenAddress();
+    auto colon = listen_address.rfind(':');
+    if (colon != std::string::npos) {
+        config_->port = std::stoi(listen_address.substr(colon + 1));
+    }
+    std::string host = config_->advertised_host.empty() ? config_->host : config_->advertised_host;
+    auto registry = actor_system_->GetProcessRegistry();
+    registry->SetAddress(host + ":" + std::to_string(config_->port));
+    
+    // Same-host peers reach this process through shared memory, rendezvous on the same port
+    if (config_->shared_memory_transport && config_->transport == TransportKind::Tcp) {
+        auto shm = std::make_shared<ShmTransport>(config_->shared_memory_ring_bytes, config_->shared_memory_spin);
+        err = shm->Listen(config_->Address(), service->Handler());
+        if (err) {
+            std::cerr << "Remote: shared-memory transport disabled: " << err.message() << std::endl;
+            shm->Stop();
+        } else {
+            shm_transport_ = shm;
+        }
+    }
+    
+    std::weak_ptr<Remote> weak_self = shared_from_this();
+    registry->RegisterAddressResolver([weak_self](std::shared_ptr<PID> pid) -> std::pair<std::shared_ptr<Process>, bool> {
+        auto self = weak_self.lock();
+        if (!self) {
+            return {nullptr, false};
+        }
+        return {std::make_shared<RemoteProcess>(pid, self), true};
+    });
+}
+
+void Remote::StopTransport() {
+    if (shm_transport_) {
+        shm_transport_->Stop();
+        shm_transport_.reset();
+    }
+    if (transport_) {
+        transport_->Stop();
+        transport_.reset();
+    }
+    transport_service_.reset();
+}
+
 void Remote::Shutdown(bool graceful) {
     if (endpoint_manager_) {
         endpoint_manager_->Stop();
     }
     
     StopGrpcServer(graceful);
+    StopTransport();
 }
 
 void Remote::Register(const std::string& kind, std::shared_ptr<protoactor::Props> props) {
@@ -158,7 +249,7 @@ std::shared_ptr<Serializer> Remote::GetSerializer() const {
     return serializer_;
 }
 
-void Remote::SendMessage(
+std::error_code Remote::SendMessage(
     std::shared_ptr<protoactor::PID> pid,
     std::shared_ptr<ReadonlyMessageHeader> header,
     std::shared_ptr<void> message,
@@ -166,7 +257,7 @@ void Remote::SendMessage(
     int32_t serializer_id) {
     
     if (!pid) {
-        return;
+        return std::make_error_code(std::errc::invalid_argument);
     }
     
     if (pid->address.empty()) {
@@ -182,13 +273,14 @@ void Remote::SendMessage(
                 process->SendUserMessage(pid, message);
             }
         }
-        return;
+        return std::error_code();
     }
     
     // Remote message, use endpoint manager
     if (endpoint_manager_) {
-        endpoint_manager_->RemoteDeliver(pid, message, sender);
+        return endpoint_manager_->RemoteDeliver(pid, message, sender, serializer_id);
     }
+    return std::make_error_code(std::errc::not_connected);
 }
 
 std::shared_ptr<protoactor::ActorSystem> Remote::GetActorSystem() const {
@@ -203,5 +295,13 @@ std::shared_ptr<BlockList> Remote::GetBlockList() const {
     return blocklist_;
 }
 
+std::shared_ptr<Transport> Remote::GetTransport() const {
+    return transport_;
+}
+
+std::shared_ptr<Transport> Remote::GetSharedMemoryTransport() const {
+    return shm_transport_;
+}
+
 } // namespace remote
 } // namespace protoactor
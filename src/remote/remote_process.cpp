@@ -35,6 +35,11 @@ void RemoteProcess::SendSystemMessage(std::shared_ptr<PID> pid, std::shared_ptr<
         return;
     }
     
+    // Other system messages overtake queued user traffic to the endpoint
+    if (auto endpoint_manager = remote_->GetEndpointManager()) {
+        endpoint_manager->RemoteDeliverSystem(pid, message);
+        return;
+    }
     remote_->SendMessage(pid, nullptr, message, nullptr, -1);
 }
 
@@ -1,42 +1,90 @@
 #include "internal/remote/serializer.h"
+#include <atomic>
+#include <mutex>
 #include <stdexcept>
 
 namespace protoactor {
 namespace remote {
 
-// Static members
-std::vector<std::shared_ptr<Serializer>> SerializerRegistry::serializers_;
-std::mutex SerializerRegistry::mutex_;
-int32_t SerializerRegistry::default_serializer_id_ = 0;
+std::size_t Serializer::SerializeTo(std::shared_ptr<void> message, std::string* out) {
+    auto bytes = Serialize(std::move(message));
+    out->append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    return bytes.size();
+}
+
+std::shared_ptr<void> Serializer::DeserializeFrom(const std::string& type_name, std::string_view bytes) {
+    std::vector<uint8_t> copy(bytes.begin(), bytes.end());
+    return Deserialize(type_name, copy);
+}
+
+const std::string& Serializer::SerializeNamed(std::shared_ptr<void> message, std::string* out) {
+    thread_local std::string type_name;
+    SerializeTo(message, out);
+    type_name = GetTypeName(std::move(message));
+    return type_name;
+}
+
+struct SerializerRegistry::Table {
+    std::vector<std::shared_ptr<Serializer>> serializers;  // Index is the serializer id; 0 is the default
+};
+
+namespace {
+
+struct RegistryState {
+    std::mutex mutex;  // Serializes registration only
+    std::atomic<const void*> table{nullptr};
+    std::vector<std::shared_ptr<const void>> published;  // Every table ever published
+};
+
+// Function-local and never destroyed: serializers register from static initializers of
+// other translation units and may be used from static destructors
+RegistryState& State() {
+    static RegistryState* state = new RegistryState();
+    return *state;
+}
+
+} // namespace
+
+const SerializerRegistry::Table* SerializerRegistry::CurrentTable() {
+    return static_cast<const Table*>(State().table.load(std::memory_order_acquire));
+}
+
+Serializer* SerializerRegistry::Find(int32_t serializer_id) {
+    auto table = CurrentTable();
+    if (!table || serializer_id < 0 || serializer_id >= static_cast<int32_t>(table->serializers.size())) {
+        return nullptr;
+    }
+    return table->serializers[serializer_id].get();
+}
 
 int32_t SerializerRegistry::RegisterSerializer(std::shared_ptr<Serializer> serializer) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    int32_t id = static_cast<int32_t>(serializers_.size());
-    serializers_.push_back(serializer);
-    if (id == 0) {
-        default_serializer_id_ = 0;
+    auto& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto table = std::make_shared<Table>();
+    if (auto current = CurrentTable()) {
+        table->serializers = current->serializers;
     }
+    int32_t id = static_cast<int32_t>(table->serializers.size());
+    table->serializers.push_back(std::move(serializer));
+    state.published.push_back(table);
+    state.table.store(table.get(), std::memory_order_release);
     return id;
 }
 
 std::shared_ptr<Serializer> SerializerRegistry::GetSerializer(int32_t serializer_id) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (serializer_id < 0 || serializer_id >= static_cast<int32_t>(serializers_.size())) {
+    auto table = CurrentTable();
+    if (!table || serializer_id < 0 || serializer_id >= static_cast<int32_t>(table->serializers.size())) {
         return nullptr;
     }
-    return serializers_[serializer_id];
+    return table->serializers[serializer_id];
 }
 
 std::pair<std::vector<uint8_t>, std::string> SerializerRegistry::Serialize(
     std::shared_ptr<void> message,
     int32_t serializer_id) {
     
-    int32_t id = serializer_id;
-    if (id < 0) {
-        id = default_serializer_id_;
-    }
-    
-    auto serializer = GetSerializer(id);
+    int32_t id = serializer_id < 0 ? 0 : serializer_id;
+    auto serializer = Find(id);
     if (!serializer) {
         throw std::runtime_error("Serializer not found: " + std::to_string(id));
     }
@@ -47,12 +95,33 @@ std::pair<std::vector<uint8_t>, std::string> SerializerRegistry::Serialize(
     return {bytes, type_name};
 }
 
+std::string SerializerRegistry::SerializeTo(
+    std::shared_ptr<void> message,
+    std::string* out,
+    int32_t serializer_id) {
+    
+    return SerializeNamed(std::move(message), out, serializer_id);
+}
+
+const std::string& SerializerRegistry::SerializeNamed(
+    std::shared_ptr<void> message,
+    std::string* out,
+    int32_t serializer_id) {
+    
+    int32_t id = serializer_id < 0 ? 0 : serializer_id;
+    auto serializer = Find(id);
+    if (!serializer) {
+        throw std::runtime_error("Serializer not found: " + std::to_string(id));
+    }
+    return serializer->SerializeNamed(std::move(message), out);
+}
+
 std::shared_ptr<void> SerializerRegistry::Deserialize(
     const std::vector<uint8_t>& bytes,
     const std::string& type_name,
     int32_t serializer_id) {
     
-    auto serializer = GetSerializer(serializer_id);
+    auto serializer = Find(serializer_id);
     if (!serializer) {
         throw std::runtime_error("Serializer not found: " + std::to_string(serializer_id));
     }
@@ -60,5 +129,18 @@ std::shared_ptr<void> SerializerRegistry::Deserialize(
     return serializer->Deserialize(type_name, bytes);
 }
 
+std::shared_ptr<void> SerializerRegistry::DeserializeFrom(
+    std::string_view bytes,
+    const std::string& type_name,
+    int32_t serializer_id) {
+    
+    auto serializer = Find(serializer_id);
+    if (!serializer) {
+        throw std::runtime_error("Serializer not found: " + std::to_string(serializer_id));
+    }
+    
+    return serializer->DeserializeFrom(type_name, bytes);
+}
+
 } // namespace remote
 } // namespace protoactor
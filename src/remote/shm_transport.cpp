@@ -0,0 +1,989 @@
+#include "internal/remote/shm_transport.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace protoactor {
+namespace remote {
+
+namespace {
+
+constexpr uint64_t kSegmentMagic = 0x50414354534D3031ULL;  // "PACTSM01"
+constexpr std::size_t kPage = 4096;
+constexpr std::size_t kMaxRingBytes = std::size_t(1) << 30;
+constexpr std::size_t kRecordHeader = 8;
+constexpr uint32_t kFlagMore = 1;     // More fragments of the frame follow
+constexpr uint32_t kFlagPadding = 2;  // Rest of the ring is unused; continue at its start
+constexpr int kMaxEvents = 64;
+constexpr int kSpaceWaitMs = 10;
+constexpr std::chrono::milliseconds kHelloTimeout(1000);  // Accepted sockets that stay silent are closed
+
+struct RingControl {
+    alignas(64) std::atomic<uint64_t> tail;  // Written by the producer
+    alignas(64) std::atomic<uint64_t> head;  // Written by the consumer
+    alignas(64) std::atomic<uint32_t> consumer_waiting;
+    std::atomic<uint32_t> producer_waiting;
+};
+
+// Start of the memfd; the two rings' data follows at kDataOffset
+struct Segment {
+    uint64_t magic;
+    uint64_t ring_bytes;
+    RingControl rings[2];  // 0: connector to acceptor, 1: acceptor to connector
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared rings need lock-free atomics");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "shared rings need lock-free atomics");
+
+constexpr std::size_t kDataOffset = (sizeof(Segment) + 63) / 64 * 64;
+
+struct RecordHeader {
+    uint32_t length;
+    uint32_t flags;
+};
+
+// Sent with the memfd and the eventfds when connecting
+struct Hello {
+    uint64_t magic;
+    uint64_t ring_bytes;
+};
+
+// Eventfds of a connection: "data" wakes a ring's consumer, "space" its producer
+enum EventFd {
+    kData0,
+    kSpace0,
+    kData1,
+    kSpace1,
+    kEventFds
+};
+
+std::size_t SegmentSize(std::size_t ring_bytes) {
+    return kDataOffset + 2 * ring_bytes;
+}
+
+std::size_t Align8(std::size_t size) {
+    return (size + 7) & ~std::size_t(7);
+}
+
+bool ParseAddress(const std::string& address, std::string* host, int* port) {
+    auto colon = address.rfind(':');
+    if (colon == std::string::npos || colon + 1 == address.size()) {
+        return false;
+    }
+    char* end = nullptr;
+    long value = std::strtol(address.c_str() + colon + 1, &end, 10);
+    if (*end != '\0' || value < 0 || value > 65535) {
+        return false;
+    }
+    *host = address.substr(0, colon);
+    *port = static_cast<int>(value);
+    return true;
+}
+
+// Abstract-namespace socket: nothing on the filesystem, released with the process
+sockaddr_un RendezvousAddress(int port, socklen_t* length) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::string name = "protoactor-shm:" + std::to_string(port);
+    std::memcpy(addr.sun_path + 1, name.data(), name.size());
+    *length = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1 + name.size());
+    return addr;
+}
+
+std::unordered_set<std::string> LocalNames() {
+    std::unordered_set<std::string> names;
+    char hostname[256] = {0};
+    if (gethostname(hostname, sizeof(hostname) - 1) == 0) {
+        names.insert(hostname);
+    }
+    ifaddrs* interfaces = nullptr;
+    if (getifaddrs(&interfaces) == 0) {
+        for (auto* it = interfaces; it; it = it->ifa_next) {
+            if (!it->ifa_addr) {
+                continue;
+            }
+            char text[INET6_ADDRSTRLEN] = {0};
+            if (it->ifa_addr->sa_family == AF_INET) {
+                inet_ntop(AF_INET, &reinterpret_cast<sockaddr_in*>(it->ifa_addr)->sin_addr, text, sizeof(text));
+            } else if (it->ifa_addr->sa_family == AF_INET6) {
+                inet_ntop(AF_INET6, &reinterpret_cast<sockaddr_in6*>(it->ifa_addr)->sin6_addr, text, sizeof(text));
+            } else {
+                continue;
+            }
+            names.insert(text);
+        }
+        freeifaddrs(interfaces);
+    }
+    return names;
+}
+
+void Signal(int fd) {
+    uint64_t one = 1;
+    ssize_t ignored = ::write(fd, &one, sizeof(one));
+    (void)ignored;
+}
+
+void Clear(int fd) {
+    uint64_t value;
+    ssize_t ignored = ::read(fd, &value, sizeof(value));
+    (void)ignored;
+}
+
+void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+void CloseAll(int* fds, int count) {
+    for (int i = 0; i < count; ++i) {
+        if (fds[i] >= 0) {
+            ::close(fds[i]);
+            fds[i] = -1;
+        }
+    }
+}
+
+bool SendHello(int socket_fd, const Hello& hello, const int* fds, int count) {
+    iovec iov{const_cast<Hello*>(&hello), sizeof(hello)};
+    std::vector<char> control(CMSG_SPACE(sizeof(int) * count));
+    msghdr message{};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control.data();
+    message.msg_controllen = control.size();
+    auto* cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * count);
+    std::memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * count);
+    ssize_t sent;
+    do {
+        sent = ::sendmsg(socket_fd, &message, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    return sent == static_cast<ssize_t>(sizeof(hello));
+}
+
+enum class HelloStatus { Received, Pending, Failed };
+
+// Non-blocking; every descriptor received is either returned in fds or closed
+HelloStatus ReceiveHello(int socket_fd, Hello* hello, int* fds, int count) {
+    iovec iov{hello, sizeof(*hello)};
+    std::vector<char> control(CMSG_SPACE(sizeof(int) * count));
+    msghdr message{};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control.data();
+    message.msg_controllen = control.size();
+    ssize_t received;
+    do {
+        received = ::recvmsg(socket_fd, &message, MSG_CMSG_CLOEXEC);
+    } while (received < 0 && errno == EINTR);
+    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return HelloStatus::Pending;
+    }
+    std::vector<int> got;
+    if (received > 0) {
+        for (auto* cmsg = CMSG_FIRSTHDR(&message); cmsg; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+                std::size_t n = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+                auto* data = reinterpret_cast<const int*>(CMSG_DATA(cmsg));
+                got.insert(got.end(), data, data + n);
+            }
+        }
+    }
+    if (received != static_cast<ssize_t>(sizeof(*hello)) || got.size() != static_cast<std::size_t>(count) ||
+        (message.msg_flags & (MSG_TRUNC | MSG_CTRUNC))) {
+        CloseAll(got.data(), static_cast<int>(got.size()));
+        return HelloStatus::Failed;
+    }
+    std::copy(got.begin(), got.end(), fds);
+    return HelloStatus::Received;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+
+class ShmTransport::IoThread {
+public:
+    IoThread(ShmTransport* owner, std::chrono::microseconds spin);
+    ~IoThread();
+
+    void Add(const std::shared_ptr<Connection>& connection);
+    void Remove(Connection* connection);
+    void WatchListener(int fd);
+    void WatchHello(int fd, std::chrono::steady_clock::time_point deadline);  // I/O thread only
+    bool InThread() const { return std::this_thread::get_id() == thread_id_; }
+    void Wake() { Signal(wake_fd_); }
+    std::size_t Size() const;
+    void Stop();
+
+private:
+    ShmTransport* owner_;
+    std::chrono::microseconds spin_;
+    int epoll_fd_;
+    int wake_fd_;
+    std::atomic<int> listen_fd_;
+    std::atomic<bool> stopping_;
+    std::thread thread_;
+    std::thread::id thread_id_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<Connection>> connections_;
+    std::unordered_map<int, std::shared_ptr<Connection>> by_fd_;  // Socket and wake fds
+    std::atomic<uint64_t> version_;
+    std::unordered_map<int, std::chrono::steady_clock::time_point> hellos_;  // Accepted sockets awaiting their hello (I/O thread)
+
+    void Run();
+    void OnHello(int fd);
+    int HelloWaitMs() const;
+    void ExpireHellos();
+};
+
+class ShmTransport::Connection : public TransportConnection, public std::enable_shared_from_this<Connection> {
+public:
+    /**
+     * @param side 0 for the connector, 1 for the acceptor
+     */
+    Connection(int socket_fd, void* base, std::size_t map_size, const int* event_fds, int side,
+               IoThread* io, TransportHandler handler, std::size_t max_frame_size)
+        : socket_fd_(socket_fd), base_(base), map_size_(map_size), io_(io),
+          handler_(std::move(handler)), max_frame_size_(max_frame_size) {
+        std::copy(event_fds, event_fds + kEventFds, event_fds_);
+        auto* segment = static_cast<Segment*>(base);
+        char* data = static_cast<char*>(base) + kDataOffset;
+        int out = side;
+        int in = 1 - side;
+        out_ = Ring{&segment->rings[out], data + out * segment->ring_bytes, segment->ring_bytes};
+        in_ = Ring{&segment->rings[in], data + in * segment->ring_bytes, segment->ring_bytes};
+        out_data_fd_ = event_fds_[out == 0 ? kData0 : kData1];
+        out_space_fd_ = event_fds_[out == 0 ? kSpace0 : kSpace1];
+        in_data_fd_ = event_fds_[in == 0 ? kData0 : kData1];
+        in_space_fd_ = event_fds_[in == 0 ? kSpace0 : kSpace1];
+    }
+
+    ~Connection() override {
+        Release();
+    }
+
+    int SocketFd() const { return socket_fd_; }
+    int WakeFd() const { return in_data_fd_; }
+
+    std::error_code Send(std::string frame) override {
+        if (frame.size() > max_frame_size_) {
+            return std::make_error_code(std::errc::message_size);
+        }
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        if (closed_.load(std::memory_order_acquire) || !base_) {
+            return std::make_error_code(std::errc::not_connected);
+        }
+        // A fragment never takes more than a quarter of the ring, so the producer always
+        // makes progress once the consumer has caught up
+        std::size_t fragment = out_.capacity / 4 - kRecordHeader;
+        std::size_t offset = 0;
+        do {
+            std::size_t size = std::min(fragment, frame.size() - offset);
+            bool more = offset + size < frame.size();
+            if (!WriteRecord(frame.data() + offset, size, more ? kFlagMore : 0)) {
+                return std::make_error_code(std::errc::not_connected);
+            }
+            offset += size;
+        } while (offset < frame.size());
+        return std::error_code();
+    }
+
+    void Close() override {
+        if (closed_.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        if (io_->InThread()) {
+            Finalize();
+            return;
+        }
+        // Tells the peer and wakes our I/O thread, which finalizes
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        if (socket_fd_ >= 0) {
+            ::shutdown(socket_fd_, SHUT_RDWR);
+        }
+    }
+
+    bool Closed() const override {
+        return closed_.load(std::memory_order_acquire);
+    }
+
+    void PauseReading(bool paused) override {
+        if (read_paused_.exchange(paused, std::memory_order_acq_rel) && !paused) {
+            // The I/O thread may be asleep with data left in the ring
+            io_->Wake();
+        }
+    }
+
+    // Deliver every complete frame in the inbound ring (I/O thread)
+    bool Drain() {
+        if (finalized_.load(std::memory_order_acquire) || read_paused_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        auto* control = in_.control;
+        uint64_t head = control->head.load(std::memory_order_relaxed);
+        uint64_t tail = control->tail.load(std::memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+        auto self = shared_from_this();
+        while (head != tail) {
+            std::size_t pos = static_cast<std::size_t>(head % in_.capacity);
+            RecordHeader header;
+            std::memcpy(&header, in_.data + pos, sizeof(header));
+            std::size_t size = (header.flags & kFlagPadding) ? in_.capacity - pos
+                                                             : kRecordHeader + Align8(header.length);
+            if (tail - head > in_.capacity || size > in_.capacity - pos || size > tail - head ||
+                partial_.size() + header.length > max_frame_size_) {
+                std::cerr << "ShmTransport: corrupt or oversized frame, closing connection" << std::endl;
+                closed_.store(true, std::memory_order_release);
+                Finalize();
+                return true;
+            }
+            bool complete = false;
+            if (!(header.flags & kFlagPadding)) {
+                partial_.append(in_.data + pos + kRecordHeader, header.length);
+                complete = !(header.flags & kFlagMore);
+            }
+            head += size;
+            control->head.store(head, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (control->producer_waiting.load(std::memory_order_relaxed)) {
+                Signal(in_space_fd_);
+            }
+            if (complete) {
+                auto frame = std::make_shared<std::string>(std::move(partial_));
+                partial_.clear();
+                Deliver(std::move(frame));
+                if (finalized_.load(std::memory_order_acquire) || read_paused_.load(std::memory_order_acquire)) {
+                    return true;
+                }
+            }
+            if (head == tail) {
+                tail = control->tail.load(std::memory_order_acquire);
+            }
+        }
+        return true;
+    }
+
+    // Announce that the I/O thread is about to sleep; true if data arrived meanwhile
+    bool ArmWait() {
+        if (finalized_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        auto* control = in_.control;
+        control->consumer_waiting.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (closed_.load(std::memory_order_acquire)) {
+            return true;
+        }
+        // Data left in a paused ring waits for PauseReading(false), which signals
+        return !read_paused_.load(std::memory_order_acquire) &&
+               control->tail.load(std::memory_order_acquire) != control->head.load(std::memory_order_relaxed);
+    }
+
+    void Disarm() {
+        if (finalized_.load(std::memory_order_acquire)) {
+            return;
+        }
+        in_.control->consumer_waiting.store(0, std::memory_order_relaxed);
+        Clear(in_data_fd_);
+    }
+
+    // Runs on the I/O thread (or after it stopped)
+    void Finalize() {
+        if (finalized_.exchange(true)) {
+            return;
+        }
+        auto self = shared_from_this();
+        closed_.store(true, std::memory_order_release);
+        io_->Remove(this);
+        {
+            std::lock_guard<std::mutex> lock(send_mutex_);
+            Release();
+        }
+        if (handler_.on_close) {
+            handler_.on_close(self);
+        }
+    }
+
+private:
+    struct Ring {
+        RingControl* control = nullptr;
+        char* data = nullptr;
+        uint64_t capacity = 0;
+    };
+
+    int socket_fd_;
+    void* base_;
+    std::size_t map_size_;
+    int event_fds_[kEventFds];
+    IoThread* io_;
+    TransportHandler handler_;
+    std::size_t max_frame_size_;
+
+    Ring out_;
+    Ring in_;
+    int out_data_fd_;
+    int out_space_fd_;
+    int in_data_fd_;
+    int in_space_fd_;
+
+    std::mutex send_mutex_;  // Single producer per ring; also guards the mapping
+    std::atomic<bool> closed_{false};
+    std::atomic<bool> finalized_{false};
+    std::atomic<bool> read_paused_{false};
+    std::string partial_;  // Fragments of the frame being received (I/O thread only)
+
+    // Append one record, waiting while the ring is full (send_mutex_ held)
+    bool WriteRecord(const char* data, std::size_t size, uint32_t flags) {
+        auto* control = out_.control;
+        std::size_t need = kRecordHeader + Align8(size);
+        uint64_t tail = control->tail.load(std::memory_order_relaxed);
+        while (true) {
+            uint64_t head = control->head.load(std::memory_order_acquire);
+            uint64_t free = out_.capacity - (tail - head);
+            std::size_t pos = static_cast<std::size_t>(tail % out_.capacity);
+            std::size_t contiguous = out_.capacity - pos;
+            if (contiguous < need && free >= contiguous) {
+                // Records never wrap: mark the rest of the ring as padding first
+                RecordHeader padding{0, kFlagPadding};
+                std::memcpy(out_.data + pos, &padding, sizeof(padding));
+                tail += contiguous;
+                Publish(tail);
+                continue;
+            }
+            if (contiguous >= need && free >= need) {
+                RecordHeader header{static_cast<uint32_t>(size), flags};
+                std::memcpy(out_.data + pos, &header, sizeof(header));
+                if (size > 0) {
+                    std::memcpy(out_.data + pos + kRecordHeader, data, size);
+                }
+                Publish(tail + need);
+                return true;
+            }
+            if (!WaitForSpace(head)) {
+                return false;
+            }
+        }
+    }
+
+    void Publish(uint64_t tail) {
+        auto* control = out_.control;
+        control->tail.store(tail, std::memory_order_release);
+        // Pairs with the fence in ArmWait: either the consumer sees the data or we see it waiting
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (control->consumer_waiting.load(std::memory_order_relaxed)) {
+            Signal(out_data_fd_);
+        }
+    }
+
+    bool WaitForSpace(uint64_t head) {
+        auto* control = out_.control;
+        control->producer_waiting.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (control->head.load(std::memory_order_acquire) == head && !closed_.load(std::memory_order_acquire)) {
+            pollfd waiter{out_space_fd_, POLLIN, 0};
+            ::poll(&waiter, 1, kSpaceWaitMs);
+            Clear(out_space_fd_);
+        }
+        control->producer_waiting.store(0, std::memory_order_relaxed);
+        return !closed_.load(std::memory_order_acquire);
+    }
+
+    void Deliver(std::shared_ptr<std::string> frame) {
+        if (!handler_.on_frame) {
+            return;
+        }
+        try {
+            handler_.on_frame(shared_from_this(), std::move(frame));
+        } catch (const std::exception& e) {
+            std::cerr << "ShmTransport frame handler exception: " << e.what() << std::endl;
+        }
+    }
+
+    void Release() {
+        if (base_) {
+            ::munmap(base_, map_size_);
+            base_ = nullptr;
+        }
+        CloseAll(event_fds_, kEventFds);
+        if (socket_fd_ >= 0) {
+            ::close(socket_fd_);
+            socket_fd_ = -1;
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+
+ShmTransport::IoThread::IoThread(ShmTransport* owner, std::chrono::microseconds spin)
+    : owner_(owner),
+      spin_(spin),
+      epoll_fd_(epoll_create1(EPOLL_CLOEXEC)),
+      wake_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      listen_fd_(-1),
+      stopping_(false),
+      version_(0) {
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = wake_fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event);
+    thread_ = std::thread([this]() { Run(); });
+    thread_id_ = thread_.get_id();
+}
+
+ShmTransport::IoThread::~IoThread() {
+    Stop();
+    ::close(wake_fd_);
+    ::close(epoll_fd_);
+}
+
+void ShmTransport::IoThread::Add(const std::shared_ptr<Connection>& connection) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stopping_.load(std::memory_order_acquire)) {
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLRDHUP;
+            event.data.fd = connection->SocketFd();
+            bool ok = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, connection->SocketFd(), &event) == 0;
+            event.events = EPOLLIN;
+            event.data.fd = connection->WakeFd();
+            ok = ok && epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, connection->WakeFd(), &event) == 0;
+            if (ok) {
+                connections_.push_back(connection);
+                by_fd_[connection->SocketFd()] = connection;
+                by_fd_[connection->WakeFd()] = connection;
+                version_.fetch_add(1, std::memory_order_release);
+                Signal(wake_fd_);
+                return;
+            }
+        }
+    }
+    connection->Close();
+    connection->Finalize();
+}
+
+void ShmTransport::IoThread::Remove(Connection* connection) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find_if(connections_.begin(), connections_.end(),
+                           [connection](const std::shared_ptr<Connection>& c) { return c.get() == connection; });
+    if (it == connections_.end()) {
+        return;
+    }
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, connection->SocketFd(), nullptr);
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, connection->WakeFd(), nullptr);
+    by_fd_.erase(connection->SocketFd());
+    by_fd_.erase(connection->WakeFd());
+    connections_.erase(it);
+    version_.fetch_add(1, std::memory_order_release);
+}
+
+void ShmTransport::IoThread::WatchListener(int fd) {
+    listen_fd_.store(fd, std::memory_order_release);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+}
+
+void ShmTransport::IoThread::WatchHello(int fd, std::chrono::steady_clock::time_point deadline) {
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.fd = fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+        ::close(fd);
+        return;
+    }
+    hellos_[fd] = deadline;
+}
+
+void ShmTransport::IoThread::OnHello(int fd) {
+    auto deadline = hellos_[fd];
+    // The connection registers the socket again once the handshake completes
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    hellos_.erase(fd);
+    if (!owner_->FinishAccept(fd)) {
+        WatchHello(fd, deadline);
+    }
+}
+
+int ShmTransport::IoThread::HelloWaitMs() const {
+    if (hellos_.empty()) {
+        return -1;
+    }
+    auto first = std::min_element(hellos_.begin(), hellos_.end(),
+                                  [](const auto& a, const auto& b) { return a.second < b.second; })->second;
+    auto wait = std::chrono::ceil<std::chrono::milliseconds>(first - std::chrono::steady_clock::now());
+    return static_cast<int>(std::max<std::chrono::milliseconds::rep>(0, wait.count()));
+}
+
+void ShmTransport::IoThread::ExpireHellos() {
+    auto now = std::chrono::steady_clock::now();
+    for (auto it = hellos_.begin(); it != hellos_.end();) {
+        if (it->second <= now) {
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, it->first, nullptr);
+            ::close(it->first);
+            it = hellos_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::size_t ShmTransport::IoThread::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return connections_.size();
+}
+
+void ShmTransport::IoThread::Stop() {
+    if (stopping_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    Signal(wake_fd_);
+    if (thread_.joinable()) {
+        if (InThread()) {
+            thread_.detach();
+        } else {
+            thread_.join();
+        }
+    }
+    std::vector<std::shared_ptr<Connection>> remaining;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        remaining = connections_;
+    }
+    for (auto& connection : remaining) {
+        connection->Close();
+        connection->Finalize();
+    }
+    // The loop has exited (or this is it), so the pending handshakes are ours
+    for (auto& hello : hellos_) {
+        ::close(hello.first);
+    }
+    hellos_.clear();
+}
+
+void ShmTransport::IoThread::Run() {
+    std::vector<std::shared_ptr<Connection>> active;
+    uint64_t seen = ~uint64_t(0);
+    epoll_event events[kMaxEvents];
+    auto idle_since = std::chrono::steady_clock::now();
+    while (!stopping_.load(std::memory_order_acquire)) {
+        if (version_.load(std::memory_order_acquire) != seen) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            active = connections_;
+            seen = version_.load(std::memory_order_relaxed);
+        }
+
+        bool progressed = false;
+        for (auto& connection : active) {
+            if (connection->Closed()) {
+                connection->Finalize();
+                continue;
+            }
+            progressed = connection->Drain() || progressed;
+        }
+        if (progressed) {
+            idle_since = std::chrono::steady_clock::now();
+            continue;
+        }
+        // Busy-poll for a while: under load the next frame usually arrives before a
+        // sleep/wake round trip would complete
+        if (!active.empty() && std::chrono::steady_clock::now() - idle_since < spin_) {
+            CpuRelax();
+            continue;
+        }
+
+        bool pending = false;
+        for (auto& connection : active) {
+            pending = connection->ArmWait() || pending;
+        }
+        int n = epoll_wait(epoll_fd_, events, kMaxEvents, pending ? 0 : HelloWaitMs());
+        for (int i = 0; i < n && !stopping_.load(std::memory_order_acquire); ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wake_fd_) {
+                Clear(wake_fd_);
+                continue;
+            }
+            if (fd == listen_fd_.load(std::memory_order_acquire)) {
+                owner_->Accept();
+                continue;
+            }
+            if (hellos_.count(fd)) {
+                OnHello(fd);
+                continue;
+            }
+            std::shared_ptr<Connection> connection;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = by_fd_.find(fd);
+                if (it != by_fd_.end()) {
+                    connection = it->second;
+                }
+            }
+            // Nothing is sent on the socket after the handshake: any event means it closed
+            if (connection && fd == connection->SocketFd()) {
+                connection->Finalize();
+            }
+        }
+        ExpireHellos();
+        for (auto& connection : active) {
+            connection->Disarm();
+        }
+        idle_since = std::chrono::steady_clock::now();
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+ShmTransport::ShmTransport(std::size_t ring_bytes, std::chrono::microseconds spin, std::size_t max_frame_size)
+    : ring_bytes_(std::min(kMaxRingBytes, std::max(kPage, (ring_bytes + kPage - 1) / kPage * kPage))),
+      max_frame_size_(max_frame_size),
+      stopped_(false),
+      listen_fd_(-1) {
+    io_ = std::make_unique<IoThread>(this, spin);
+}
+
+ShmTransport::~ShmTransport() {
+    Stop();
+}
+
+std::error_code ShmTransport::Listen(const std::string& address, TransportHandler handler) {
+    if (stopped_.load(std::memory_order_acquire)) {
+        return std::make_error_code(std::errc::operation_canceled);
+    }
+    std::string host;
+    int port;
+    if (!ParseAddress(address, &host, &port) || port == 0) {
+        return std::make_error_code(std::errc::invalid_argument);
+    }
+    std::lock_guard<std::mutex> lock(listen_mutex_);
+    if (listen_fd_ >= 0) {
+        return std::make_error_code(std::errc::already_connected);
+    }
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return std::error_code(errno, std::generic_category());
+    }
+    socklen_t length;
+    auto addr = RendezvousAddress(port, &length);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), length) < 0 || ::listen(fd, SOMAXCONN) < 0) {
+        auto err = std::error_code(errno, std::generic_category());
+        ::close(fd);
+        return err;
+    }
+    listen_address_ = address;
+    accept_handler_ = std::move(handler);
+    listen_fd_ = fd;
+    io_->WatchListener(fd);
+    return std::error_code();
+}
+
+std::string ShmTransport::ListenAddress() const {
+    std::lock_guard<std::mutex> lock(listen_mutex_);
+    return listen_address_;
+}
+
+std::pair<std::shared_ptr<TransportConnection>, std::error_code> ShmTransport::Connect(
+    const std::string& address,
+    TransportHandler handler) {
+    if (stopped_.load(std::memory_order_acquire)) {
+        return {nullptr, std::make_error_code(std::errc::operation_canceled)};
+    }
+    std::string host;
+    int port;
+    if (!ParseAddress(address, &host, &port) || port == 0) {
+        return {nullptr, std::make_error_code(std::errc::invalid_argument)};
+    }
+    if (!IsLocalAddress(address)) {
+        return {nullptr, std::make_error_code(std::errc::host_unreachable)};
+    }
+
+    int socket_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socket_fd < 0) {
+        return {nullptr, std::error_code(errno, std::generic_category())};
+    }
+    socklen_t length;
+    auto addr = RendezvousAddress(port, &length);
+    if (::connect(socket_fd, reinterpret_cast<sockaddr*>(&addr), length) < 0) {
+        auto err = std::error_code(errno, std::generic_category());
+        ::close(socket_fd);
+        return {nullptr, err};
+    }
+
+    // fds[0] is the memfd, then the eventfds
+    int fds[1 + kEventFds];
+    std::fill(std::begin(fds), std::end(fds), -1);
+    void* base = MAP_FAILED;
+    auto size = SegmentSize(ring_bytes_);
+    auto fail = [&]() -> std::pair<std::shared_ptr<TransportConnection>, std::error_code> {
+        auto err = std::error_code(errno ? errno : EIO, std::generic_category());
+        if (base != MAP_FAILED) {
+            ::munmap(base, size);
+        }
+        CloseAll(fds, 1 + kEventFds);
+        ::close(socket_fd);
+        return {nullptr, err};
+    };
+
+    fds[0] = memfd_create("protoactor-shm", MFD_CLOEXEC);
+    if (fds[0] < 0 || ::ftruncate(fds[0], static_cast<off_t>(size)) < 0) {
+        return fail();
+    }
+    base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+    if (base == MAP_FAILED) {
+        return fail();
+    }
+    auto* segment = new (base) Segment();
+    segment->magic = kSegmentMagic;
+    segment->ring_bytes = ring_bytes_;
+    for (auto& ring : segment->rings) {
+        // Until each side's I/O thread runs, the first frames must wake it
+        ring.consumer_waiting.store(1, std::memory_order_relaxed);
+    }
+    for (int i = 1; i <= kEventFds; ++i) {
+        fds[i] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (fds[i] < 0) {
+            return fail();
+        }
+    }
+    if (!SendHello(socket_fd, Hello{kSegmentMagic, ring_bytes_}, fds, 1 + kEventFds)) {
+        return fail();
+    }
+    ::close(fds[0]);  // The mapping stays valid
+
+    auto connection = std::make_shared<Connection>(socket_fd, base, size, fds + 1, 0, io_.get(), std::move(handler), max_frame_size_);
+    io_->Add(connection);
+    if (connection->Closed()) {
+        return {nullptr, std::make_error_code(std::errc::operation_canceled)};
+    }
+    return {connection, std::error_code()};
+}
+
+void ShmTransport::Stop() {
+    if (stopped_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    io_->Stop();
+    std::lock_guard<std::mutex> lock(listen_mutex_);
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+    }
+}
+
+std::size_t ShmTransport::Connections() const {
+    return io_->Size();
+}
+
+bool ShmTransport::IsLocalAddress(const std::string& address) {
+    std::string host;
+    int port;
+    if (!ParseAddress(address, &host, &port)) {
+        return false;
+    }
+    if (host.size() >= 2 && host.front() == '[' && host.back() == ']') {
+        host = host.substr(1, host.size() - 2);
+    }
+    if (host.empty() || host == "localhost" || host == "0.0.0.0" || host == "::" || host == "::1" ||
+        host.compare(0, 4, "127.") == 0) {
+        return true;
+    }
+    static const std::unordered_set<std::string> local_names = LocalNames();
+    return local_names.count(host) > 0;
+}
+
+void ShmTransport::Accept() {
+    int listen_fd;
+    {
+        std::lock_guard<std::mutex> lock(listen_mutex_);
+        listen_fd = listen_fd_;
+    }
+    while (listen_fd >= 0) {
+        int fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        // The connector sends the segment right after connecting; usually it is already here
+        if (!FinishAccept(fd)) {
+            io_->WatchHello(fd, std::chrono::steady_clock::now() + kHelloTimeout);
+        }
+    }
+}
+
+bool ShmTransport::FinishAccept(int fd) {
+    Hello hello{};
+    int fds[1 + kEventFds];
+    std::fill(std::begin(fds), std::end(fds), -1);
+    auto status = ReceiveHello(fd, &hello, fds, 1 + kEventFds);
+    if (status == HelloStatus::Pending) {
+        return false;
+    }
+    if (status == HelloStatus::Failed) {
+        ::close(fd);
+        return true;
+    }
+
+    struct stat info{};
+    auto size = SegmentSize(hello.ring_bytes);
+    bool valid = hello.magic == kSegmentMagic && hello.ring_bytes >= kPage &&
+                 hello.ring_bytes <= kMaxRingBytes && hello.ring_bytes % kPage == 0 &&
+                 ::fstat(fds[0], &info) == 0 && static_cast<std::size_t>(info.st_size) == size;
+    void* base = valid ? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0) : MAP_FAILED;
+    ::close(fds[0]);
+    fds[0] = -1;
+    if (base == MAP_FAILED) {
+        CloseAll(fds, 1 + kEventFds);
+        ::close(fd);
+        return true;
+    }
+    auto* segment = static_cast<Segment*>(base);
+    if (segment->magic != kSegmentMagic || segment->ring_bytes != hello.ring_bytes) {
+        ::munmap(base, size);
+        CloseAll(fds, 1 + kEventFds);
+        ::close(fd);
+        return true;
+    }
+
+    TransportHandler handler;
+    {
+        std::lock_guard<std::mutex> lock(listen_mutex_);
+        handler = accept_handler_;
+    }
+    auto connection = std::make_shared<Connection>(fd, base, size, fds + 1, 1, io_.get(), handler, max_frame_size_);
+    io_->Add(connection);
+    return true;
+}
+
+} // namespace remote
+} // namespace protoactor
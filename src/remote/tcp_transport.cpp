@@ -0,0 +1,736 @@
+#include "internal/remote/tcp_transport.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <unordered_map>
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace protoactor {
+namespace remote {
+
+namespace {
+
+constexpr std::size_t kReadChunk = 64 * 1024;
+constexpr int kMaxIov = 64;
+constexpr int kMaxEvents = 64;
+
+std::error_code LastError() {
+    return std::error_code(errno, std::generic_category());
+}
+
+bool SplitAddress(const std::string& address, std::string* host, std::string* port) {
+    auto colon = address.rfind(':');
+    if (colon == std::string::npos || colon + 1 == address.size()) {
+        return false;
+    }
+    *host = address.substr(0, colon);
+    *port = address.substr(colon + 1);
+    return true;
+}
+
+bool Resolve(const std::string& address, sockaddr_in* out) {
+    std::string host;
+    std::string port;
+    if (!SplitAddress(address, &host, &port)) {
+        return false;
+    }
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = host.empty() ? AI_PASSIVE : 0;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &result) != 0 || !result) {
+        return false;
+    }
+    std::memcpy(out, result->ai_addr, sizeof(sockaddr_in));
+    freeaddrinfo(result);
+    return true;
+}
+
+void SetNoDelay(int fd) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+
+class TcpTransport::IoThread {
+public:
+    explicit IoThread(TcpTransport* owner);
+    ~IoThread();
+
+    void Add(const std::shared_ptr<Connection>& connection);
+    // Fail the connect of a connection that is still connecting at deadline
+    void WatchConnect(const std::shared_ptr<Connection>& connection, std::chrono::steady_clock::time_point deadline);
+    void Remove(int fd);
+    void Modify(int fd, bool want_read, bool want_write);
+    void WatchListener(int fd);
+    bool InThread() const { return std::this_thread::get_id() == thread_id_; }
+    void Stop();
+
+private:
+    TcpTransport* owner_;
+    int epoll_fd_;
+    int wake_fd_;
+    std::atomic<int> listen_fd_;
+    std::atomic<bool> stopping_;
+    std::thread thread_;
+    std::thread::id thread_id_;
+    std::mutex mutex_;
+    std::unordered_map<int, std::shared_ptr<Connection>> connections_;
+    std::vector<std::pair<std::chrono::steady_clock::time_point, std::weak_ptr<Connection>>> connecting_;
+
+    void Run();
+    int ExpireConnects();  // epoll_wait timeout until the next connect deadline
+};
+
+class TcpTransport::Connection : public TransportConnection, public std::enable_shared_from_this<Connection> {
+public:
+    /**
+     * @param connecting The non-blocking connect is still in progress; the I/O thread
+     * completes it once the socket turns writable
+     */
+    Connection(int fd, IoThread* io, TransportHandler handler, std::size_t max_frame_size, bool connecting)
+        : fd_(fd), io_(io), handler_(std::move(handler)), max_frame_size_(max_frame_size),
+          write_armed_(connecting), connecting_(connecting) {
+    }
+
+    ~Connection() override {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    int Fd() const { return fd_; }
+    IoThread* Io() const { return io_; }
+    bool Connecting() const { return connecting_.load(std::memory_order_acquire); }
+
+    std::error_code Send(std::string frame) override {
+        if (frame.size() > std::numeric_limits<uint32_t>::max()) {
+            return std::make_error_code(std::errc::message_size);
+        }
+        std::unique_lock<std::mutex> lock(write_mutex_);
+        if (closed_.load(std::memory_order_acquire) || fd_ < 0) {
+            return std::make_error_code(std::errc::not_connected);
+        }
+        out_.push_back(OutFrame{htonl(static_cast<uint32_t>(frame.size())), std::move(frame)});
+        if (write_armed_) {
+            // The I/O thread drains the queue once the socket is writable
+            return std::error_code();
+        }
+        if (!FlushLocked()) {
+            lock.unlock();
+            Close();
+            return std::make_error_code(std::errc::connection_reset);
+        }
+        if (!out_.empty()) {
+            write_armed_ = true;
+            io_->Modify(fd_, !read_paused_, true);
+        }
+        return std::error_code();
+    }
+
+    void PauseReading(bool paused) override {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (read_paused_ == paused || fd_ < 0) {
+            read_paused_ = paused;
+            return;
+        }
+        // Level-triggered: bytes left in the socket are reported again once resumed
+        read_paused_ = paused;
+        reading_.store(!paused, std::memory_order_release);
+        io_->Modify(fd_, !paused, write_armed_);
+    }
+
+    void Close() override {
+        if (closed_.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        if (io_->InThread()) {
+            Finalize();
+            return;
+        }
+        // The I/O thread sees the shutdown and finalizes, so the fd is only closed there
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (fd_ >= 0) {
+            ::shutdown(fd_, SHUT_RDWR);
+        }
+    }
+
+    bool Closed() const override {
+        return closed_.load(std::memory_order_acquire);
+    }
+
+    void OnEvents(uint32_t events) {
+        auto self = shared_from_this();
+        if (closed_.load(std::memory_order_acquire)) {
+            Finalize();
+            return;
+        }
+        if (connecting_.load(std::memory_order_acquire)) {
+            if (!(events & (EPOLLOUT | EPOLLERR | EPOLLHUP))) {
+                return;
+            }
+            int error = 0;
+            socklen_t length = sizeof(error);
+            if (getsockopt(fd_, SOL_SOCKET, SO_ERROR, &error, &length) < 0 || error != 0) {
+                closed_.store(true, std::memory_order_release);
+                Finalize();
+                return;
+            }
+            // Connected: frames queued meanwhile go out with the EPOLLOUT below
+            connecting_.store(false, std::memory_order_release);
+            events |= EPOLLOUT;
+        }
+        // A paused connection may still see an event queued before the pause
+        bool readable = (events & (EPOLLHUP | EPOLLERR)) ||
+                        ((events & (EPOLLIN | EPOLLRDHUP)) && reading_.load(std::memory_order_acquire));
+        if (readable) {
+            ReadAvailable();
+            if (finalized_) {
+                return;
+            }
+        }
+        if (events & EPOLLOUT) {
+            std::unique_lock<std::mutex> lock(write_mutex_);
+            if (fd_ < 0) {
+                return;
+            }
+            if (!FlushLocked()) {
+                lock.unlock();
+                closed_.store(true, std::memory_order_release);
+                Finalize();
+                return;
+            }
+            if (out_.empty() && write_armed_) {
+                write_armed_ = false;
+                io_->Modify(fd_, !read_paused_, false);
+            }
+        }
+    }
+
+    // Runs on the I/O thread (or after it stopped)
+    void Finalize() {
+        if (finalized_.exchange(true)) {
+            return;
+        }
+        auto self = shared_from_this();
+        closed_.store(true, std::memory_order_release);
+        int fd;
+        {
+            std::lock_guard<std::mutex> lock(write_mutex_);
+            fd = fd_;
+            fd_ = -1;
+            out_.clear();
+        }
+        if (fd >= 0) {
+            io_->Remove(fd);
+            ::close(fd);
+        }
+        if (handler_.on_close) {
+            handler_.on_close(self);
+        }
+    }
+
+private:
+    struct OutFrame {
+        uint32_t header;  // Length, network byte order
+        std::string data;
+    };
+
+    int fd_;
+    IoThread* io_;
+    TransportHandler handler_;
+    std::size_t max_frame_size_;
+
+    std::mutex write_mutex_;
+    std::deque<OutFrame> out_;
+    std::size_t out_offset_ = 0;  // Bytes of the front frame (header included) already written
+    bool write_armed_;
+    bool read_paused_ = false;           // Guarded by write_mutex_ like write_armed_
+    std::atomic<bool> reading_{true};    // Mirror of !read_paused_ for the I/O thread
+
+    std::atomic<bool> connecting_;
+    std::atomic<bool> closed_{false};
+    std::atomic<bool> finalized_{false};
+
+    // Read state (I/O thread only)
+    std::vector<char> read_buffer_;
+    unsigned char header_[4] = {0, 0, 0, 0};
+    std::size_t header_got_ = 0;
+    std::shared_ptr<std::string> frame_;
+    std::size_t frame_got_ = 0;
+
+    // Write as much of the queue as the socket takes; false on a connection error
+    bool FlushLocked() {
+        while (!out_.empty()) {
+            iovec iov[kMaxIov];
+            int count = 0;
+            std::size_t skip = out_offset_;
+            for (auto it = out_.begin(); it != out_.end() && count + 2 <= kMaxIov; ++it) {
+                if (skip < sizeof(it->header)) {
+                    iov[count].iov_base = reinterpret_cast<char*>(&it->header) + skip;
+                    iov[count].iov_len = sizeof(it->header) - skip;
+                    ++count;
+                    skip = 0;
+                } else {
+                    skip -= sizeof(it->header);
+                }
+                if (it->data.size() > skip) {
+                    iov[count].iov_base = &it->data[skip];
+                    iov[count].iov_len = it->data.size() - skip;
+                    ++count;
+                }
+                skip = 0;
+            }
+            msghdr message{};
+            message.msg_iov = iov;
+            message.msg_iovlen = static_cast<std::size_t>(count);
+            ssize_t written = ::sendmsg(fd_, &message, MSG_NOSIGNAL);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+            auto remaining = static_cast<std::size_t>(written);
+            while (remaining > 0) {
+                auto left = sizeof(uint32_t) + out_.front().data.size() - out_offset_;
+                if (remaining < left) {
+                    out_offset_ += remaining;
+                    break;
+                }
+                remaining -= left;
+                out_.pop_front();
+                out_offset_ = 0;
+            }
+        }
+        return true;
+    }
+
+    void ReadAvailable() {
+        if (read_buffer_.empty()) {
+            read_buffer_.resize(kReadChunk);
+        }
+        while (!finalized_ && reading_.load(std::memory_order_acquire)) {
+            ssize_t n;
+            bool direct = frame_ && frame_->size() - frame_got_ >= read_buffer_.size();
+            if (direct) {
+                // Large frame: receive straight into it
+                n = ::recv(fd_, &(*frame_)[frame_got_], frame_->size() - frame_got_, 0);
+            } else {
+                n = ::recv(fd_, read_buffer_.data(), read_buffer_.size(), 0);
+            }
+            if (n > 0) {
+                bool ok = true;
+                if (direct) {
+                    frame_got_ += static_cast<std::size_t>(n);
+                    if (frame_got_ == frame_->size()) {
+                        Deliver();
+                    }
+                } else {
+                    ok = Consume(read_buffer_.data(), static_cast<std::size_t>(n));
+                }
+                if (!ok) {
+                    std::cerr << "TcpTransport: oversized frame, closing connection" << std::endl;
+                    closed_.store(true, std::memory_order_release);
+                    Finalize();
+                    return;
+                }
+                if (closed_.load(std::memory_order_acquire)) {
+                    Finalize();
+                    return;
+                }
+                continue;
+            }
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                return;
+            }
+            // Peer closed or connection error
+            closed_.store(true, std::memory_order_release);
+            Finalize();
+            return;
+        }
+    }
+
+    bool Consume(const char* data, std::size_t size) {
+        while (size > 0) {
+            if (!frame_) {
+                auto take = std::min(sizeof(header_) - header_got_, size);
+                std::memcpy(header_ + header_got_, data, take);
+                header_got_ += take;
+                data += take;
+                size -= take;
+                if (header_got_ < sizeof(header_)) {
+                    return true;
+                }
+                header_got_ = 0;
+                uint32_t length;
+                std::memcpy(&length, header_, sizeof(length));
+                length = ntohl(length);
+                if (length > max_frame_size_) {
+                    return false;
+                }
+                frame_ = std::make_shared<std::string>();
+                frame_->resize(length);
+                frame_got_ = 0;
+            }
+            auto take = std::min(frame_->size() - frame_got_, size);
+            if (take > 0) {
+                std::memcpy(&(*frame_)[frame_got_], data, take);
+            }
+            frame_got_ += take;
+            data += take;
+            size -= take;
+            if (frame_got_ == frame_->size()) {
+                Deliver();
+            }
+        }
+        return true;
+    }
+
+    void Deliver() {
+        auto frame = std::move(frame_);
+        frame_got_ = 0;
+        if (!handler_.on_frame) {
+            return;
+        }
+        try {
+            handler_.on_frame(shared_from_this(), std::move(frame));
+        } catch (const std::exception& e) {
+            std::cerr << "TcpTransport frame handler exception: " << e.what() << std::endl;
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+
+TcpTransport::IoThread::IoThread(TcpTransport* owner)
+    : owner_(owner),
+      epoll_fd_(epoll_create1(EPOLL_CLOEXEC)),
+      wake_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      listen_fd_(-1),
+      stopping_(false) {
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = wake_fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event);
+    thread_ = std::thread([this]() { Run(); });
+    thread_id_ = thread_.get_id();
+}
+
+TcpTransport::IoThread::~IoThread() {
+    Stop();
+    ::close(wake_fd_);
+    ::close(epoll_fd_);
+}
+
+void TcpTransport::IoThread::Add(const std::shared_ptr<Connection>& connection) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stopping_.load(std::memory_order_acquire)) {
+            connections_[connection->Fd()] = connection;
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLRDHUP | (connection->Connecting() ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+            event.data.fd = connection->Fd();
+            if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, connection->Fd(), &event) == 0) {
+                return;
+            }
+            connections_.erase(connection->Fd());
+        }
+    }
+    connection->Close();
+    connection->Finalize();
+}
+
+void TcpTransport::IoThread::WatchConnect(
+    const std::shared_ptr<Connection>& connection,
+    std::chrono::steady_clock::time_point deadline) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        connecting_.emplace_back(deadline, connection);
+    }
+    // Recompute the epoll_wait timeout
+    uint64_t one = 1;
+    ssize_t ignored = ::write(wake_fd_, &one, sizeof(one));
+    (void)ignored;
+}
+
+int TcpTransport::IoThread::ExpireConnects() {
+    std::vector<std::shared_ptr<Connection>> expired;
+    int timeout = -1;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = std::chrono::steady_clock::now();
+        auto it = connecting_.begin();
+        while (it != connecting_.end()) {
+            auto connection = it->second.lock();
+            if (!connection || !connection->Connecting() || connection->Closed()) {
+                it = connecting_.erase(it);
+                continue;
+            }
+            if (it->first <= now) {
+                expired.push_back(std::move(connection));
+                it = connecting_.erase(it);
+                continue;
+            }
+            auto left = std::chrono::ceil<std::chrono::milliseconds>(it->first - now).count();
+            timeout = timeout < 0 ? static_cast<int>(left) : std::min(timeout, static_cast<int>(left));
+            ++it;
+        }
+    }
+    for (auto& connection : expired) {
+        connection->Close();
+    }
+    return timeout;
+}
+
+void TcpTransport::IoThread::Remove(int fd) {
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    std::lock_guard<std::mutex> lock(mutex_);
+    connections_.erase(fd);
+}
+
+void TcpTransport::IoThread::Modify(int fd, bool want_read, bool want_write) {
+    epoll_event event{};
+    event.events = (want_read ? static_cast<uint32_t>(EPOLLIN | EPOLLRDHUP) : 0u) |
+                   (want_write ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    event.data.fd = fd;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &event);
+}
+
+void TcpTransport::IoThread::WatchListener(int fd) {
+    listen_fd_.store(fd, std::memory_order_release);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+}
+
+void TcpTransport::IoThread::Stop() {
+    if (stopping_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    uint64_t one = 1;
+    ssize_t ignored = ::write(wake_fd_, &one, sizeof(one));
+    (void)ignored;
+    if (thread_.joinable()) {
+        if (InThread()) {
+            thread_.detach();
+        } else {
+            thread_.join();
+        }
+    }
+    std::vector<std::shared_ptr<Connection>> remaining;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& entry : connections_) {
+            remaining.push_back(entry.second);
+        }
+    }
+    for (auto& connection : remaining) {
+        connection->Close();
+        connection->Finalize();
+    }
+}
+
+void TcpTransport::IoThread::Run() {
+    epoll_event events[kMaxEvents];
+    while (!stopping_.load(std::memory_order_acquire)) {
+        int n = epoll_wait(epoll_fd_, events, kMaxEvents, ExpireConnects());
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        for (int i = 0; i < n && !stopping_.load(std::memory_order_acquire); ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wake_fd_) {
+                uint64_t value;
+                ssize_t ignored = ::read(wake_fd_, &value, sizeof(value));
+                (void)ignored;
+                continue;
+            }
+            if (fd == listen_fd_.load(std::memory_order_acquire)) {
+                owner_->Accept();
+                continue;
+            }
+            std::shared_ptr<Connection> connection;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = connections_.find(fd);
+                if (it != connections_.end()) {
+                    connection = it->second;
+                }
+            }
+            if (connection) {
+                connection->OnEvents(events[i].events);
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+TcpTransport::TcpTransport(int io_threads, std::size_t max_frame_size, std::chrono::milliseconds connect_timeout)
+    : max_frame_size_(max_frame_size),
+      connect_timeout_(connect_timeout),
+      next_thread_(0),
+      stopped_(false),
+      listen_fd_(-1) {
+    int count = std::max(1, io_threads);
+    for (int i = 0; i < count; ++i) {
+        threads_.push_back(std::make_unique<IoThread>(this));
+    }
+}
+
+TcpTransport::~TcpTransport() {
+    Stop();
+}
+
+std::error_code TcpTransport::Listen(const std::string& address, TransportHandler handler) {
+    if (stopped_.load(std::memory_order_acquire)) {
+        return std::make_error_code(std::errc::operation_canceled);
+    }
+    std::lock_guard<std::mutex> lock(listen_mutex_);
+    if (listen_fd_ >= 0) {
+        return std::make_error_code(std::errc::already_connected);
+    }
+    sockaddr_in addr{};
+    if (!Resolve(address, &addr)) {
+        return std::make_error_code(std::errc::invalid_argument);
+    }
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return LastError();
+    }
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(fd, SOMAXCONN) < 0) {
+        auto err = LastError();
+        ::close(fd);
+        return err;
+    }
+    socklen_t length = sizeof(addr);
+    getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &length);
+    std::string host;
+    std::string port;
+    SplitAddress(address, &host, &port);
+    listen_address_ = host + ":" + std::to_string(ntohs(addr.sin_port));
+    accept_handler_ = std::move(handler);
+    listen_fd_ = fd;
+    threads_[0]->WatchListener(fd);
+    return std::error_code();
+}
+
+std::string TcpTransport::ListenAddress() const {
+    std::lock_guard<std::mutex> lock(listen_mutex_);
+    return listen_address_;
+}
+
+std::pair<std::shared_ptr<TransportConnection>, std::error_code> TcpTransport::Connect(
+    const std::string& address,
+    TransportHandler handler) {
+    if (stopped_.load(std::memory_order_acquire)) {
+        return {nullptr, std::make_error_code(std::errc::operation_canceled)};
+    }
+    sockaddr_in addr{};
+    if (!Resolve(address, &addr)) {
+        return {nullptr, std::make_error_code(std::errc::invalid_argument)};
+    }
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return {nullptr, LastError()};
+    }
+    bool connecting = false;
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        if (errno != EINPROGRESS) {
+            auto err = LastError();
+            ::close(fd);
+            return {nullptr, err};
+        }
+        // The I/O thread finishes the connect; a failure or timeout closes the connection
+        connecting = true;
+    }
+    SetNoDelay(fd);
+    std::shared_ptr<Connection> connection;
+    Register(fd, std::move(handler), connecting, &connection);
+    if (connection->Closed()) {
+        return {nullptr, std::make_error_code(std::errc::operation_canceled)};
+    }
+    if (connecting) {
+        connection->Io()->WatchConnect(connection, std::chrono::steady_clock::now() + connect_timeout_);
+    }
+    return {connection, std::error_code()};
+}
+
+void TcpTransport::Stop() {
+    if (stopped_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    for (auto& thread : threads_) {
+        thread->Stop();
+    }
+    std::lock_guard<std::mutex> lock(listen_mutex_);
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+    }
+}
+
+TcpTransport::IoThread* TcpTransport::NextThread() {
+    return threads_[next_thread_.fetch_add(1, std::memory_order_relaxed) % threads_.size()].get();
+}
+
+void TcpTransport::Accept() {
+    int listen_fd;
+    TransportHandler handler;
+    {
+        std::lock_guard<std::mutex> lock(listen_mutex_);
+        listen_fd = listen_fd_;
+        handler = accept_handler_;
+    }
+    while (listen_fd >= 0) {
+        int fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        SetNoDelay(fd);
+        Register(fd, handler, false, nullptr);
+    }
+}
+
+void TcpTransport::Register(int fd, TransportHandler handler, bool connecting, std::shared_ptr<Connection>* out) {
+    auto io = NextThread();
+    auto connection = std::make_shared<Connection>(fd, io, std::move(handler), max_frame_size_, connecting);
+    if (out) {
+        *out = connection;
+    }
+    io->Add(connection);
+}
+
+} // namespace remote
+} // namespace protoactor
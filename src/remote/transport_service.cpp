@@ -0,0 +1,200 @@
+#include "internal/remote/transport_service.h"
+#include "external/remote/remote.h"
+#include "internal/remote/blocklist.h"
+#include "internal/remote/connection_dictionary.h"
+#include "internal/remote/endpoint_reader.h"
+#include "internal/remote/wire.h"
+#include "external/actor_system.h"
+#include <iostream>
+
+namespace protoactor {
+namespace remote {
+
+struct TransportService::Peer {
+    Peer(const std::string& address, std::size_t dictionary_size, const std::shared_ptr<TransportConnection>& conn)
+        : dictionary(address, dictionary_size), connection(conn) {}
+    
+    ConnectionDictionaryDecoder dictionary;
+    std::weak_ptr<TransportConnection> connection;
+    bool accepted = false;
+    bool use_dictionary = false;
+};
+
+TransportService::TransportService(std::shared_ptr<Remote> remote)
+    : remote_(remote),
+      endpoint_reader_(remote ? std::make_shared<EndpointReader>(remote) : nullptr) {
+}
+
+TransportHandler TransportService::Handler() {
+    std::weak_ptr<TransportService> weak_self = shared_from_this();
+    if (endpoint_reader_) {
+        endpoint_reader_->SetFlowControl([weak_self](bool paused) {
+            if (auto self = weak_self.lock()) {
+                self->PauseReading(paused);
+            }
+        });
+    }
+    TransportHandler handler;
+    handler.on_frame = [weak_self](const std::shared_ptr<TransportConnection>& connection,
+                                   std::shared_ptr<std::string> frame) {
+        if (auto self = weak_self.lock()) {
+            self->OnFrame(connection, std::move(frame));
+        }
+    };
+    handler.on_close = [weak_self](const std::shared_ptr<TransportConnection>& connection) {
+        if (auto self = weak_self.lock()) {
+            self->OnClose(connection);
+        }
+    };
+    return handler;
+}
+
+void TransportService::OnFrame(const std::shared_ptr<TransportConnection>& connection, std::shared_ptr<std::string> frame) {
+    if (!remote_ || !endpoint_reader_) {
+        return;
+    }
+    
+    // Frames of one connection arrive one at a time, so the peer state needs no lock
+    std::shared_ptr<Peer> peer;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& entry = peers_[connection.get()];
+        if (!entry) {
+            entry = std::make_shared<Peer>(remote_->GetActorSystem()->Address(),
+                                           remote_->GetConfig()->endpoint_dictionary_size, connection);
+            if (endpoint_reader_->Paused()) {
+                connection->PauseReading(true);
+            }
+        }
+        peer = entry;
+    }
+    
+    wire::RemoteMessage message;
+    if (!wire::Decode(*frame, &message)) {
+        std::cerr << "TransportService: malformed frame, closing connection" << std::endl;
+        connection->Close();
+        return;
+    }
+    
+    switch (message.type) {
+        case wire::RemoteMessage::Type::MessageBatch:
+            if (!peer->accepted) {
+                break;
+            }
+            if (message.message_batch.compression != wire::kCompressionNone) {
+                // The decompressed batch replaces the frame as owner of the payloads
+                auto body = std::make_shared<std::string>();
+                wire::MessageBatch batch;
+                if (!wire::DecompressBatch(message.message_batch, body.get(), &batch)) {
+                    std::cerr << "TransportService: undecodable compressed batch, closing connection" << std::endl;
+                    connection->Close();
+                    return;
+                }
+                if (!HandleMessageBatch(*peer, std::move(body), batch)) {
+                    connection->Close();
+                }
+                break;
+            }
+            if (!HandleMessageBatch(*peer, std::move(frame), message.message_batch)) {
+                connection->Close();
+            }
+            break;
+        case wire::RemoteMessage::Type::ConnectRequest:
+            HandleConnectRequest(connection, *peer, message.connect_request);
+            break;
+        case wire::RemoteMessage::Type::DisconnectRequest:
+            connection->Close();
+            break;
+        default:
+            break;
+    }
+}
+
+void TransportService::OnClose(const std::shared_ptr<TransportConnection>& connection) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    peers_.erase(connection.get());
+}
+
+void TransportService::PauseReading(bool paused) {
+    // Every connection feeds the one reader, so all of them pause together
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : peers_) {
+        if (auto connection = entry.second->connection.lock()) {
+            connection->PauseReading(paused);
+        }
+    }
+}
+
+void TransportService::HandleConnectRequest(
+    const std::shared_ptr<TransportConnection>& connection,
+    Peer& peer,
+    const wire::ConnectRequest& request) {
+    
+    bool blocked = request.server_connection && remote_->GetBlockList() &&
+                   remote_->GetBlockList()->IsBlocked(request.member_id);
+    
+    wire::ConnectResponse response;
+    response.member_id = remote_->GetActorSystem()->GetID();
+    response.blocked = blocked;
+    response.connection_dictionary = request.server_connection && request.connection_dictionary &&
+                                     remote_->GetConfig()->endpoint_dictionary_size > 0;
+    // Decompressing does not depend on this side's own endpoint_compression
+    response.compression = request.server_connection ? wire::NegotiateCompression(request.compression)
+                                                     : wire::kCompressionNone;
+    
+    peer.accepted = !blocked;
+    peer.use_dictionary = response.connection_dictionary;
+    peer.dictionary.Reset();
+    
+    std::string frame;
+    wire::EncodeConnectResponse(response, &frame);
+    connection->Send(std::move(frame));
+}
+
+bool TransportService::HandleMessageBatch(Peer& peer, std::shared_ptr<std::string> frame, const wire::MessageBatch& batch) {
+    auto& dictionary = peer.dictionary;
+    if (!peer.use_dictionary || batch.dictionary_reset) {
+        // Without dictionaries every batch is self-contained
+        dictionary.Reset();
+    }
+    if (!dictionary.Admit(batch.type_names.size() + batch.targets.size() + batch.senders.size(),
+                          batch.envelopes.size())) {
+        std::cerr << "TransportService: peer exceeded the connection dictionary bound, closing connection"
+                  << std::endl;
+        return false;
+    }
+    for (auto type_name : batch.type_names) {
+        dictionary.AddTypeName(std::string(type_name));
+    }
+    for (auto target_id : batch.targets) {
+        dictionary.AddTarget(std::string(target_id));
+    }
+    for (const auto& sender : batch.senders) {
+        dictionary.AddSender(std::string(sender.address), std::string(sender.id));
+    }
+    
+    // Payloads stay in the frame; the batch keeps it alive until every envelope is delivered
+    auto inbound = std::make_shared<InboundBatch>();
+    inbound->owner = frame;
+    inbound->envelopes.reserve(batch.envelopes.size());
+    for (const auto& envelope : batch.envelopes) {
+        auto target = dictionary.Target(envelope.target, envelope.target_request_id);
+        const std::string* type_name = dictionary.TypeName(envelope.type_id);
+        if (!target || !type_name || type_name->empty()) {
+            continue;
+        }
+        InboundEnvelope item;
+        item.data = envelope.message_data;
+        item.type_name = *type_name;
+        item.serializer_id = envelope.serializer_id;
+        item.target = std::move(target);
+        item.sender = dictionary.Sender(envelope.sender, envelope.sender_request_id);
+        inbound->envelopes.push_back(std::move(item));
+    }
+    
+    endpoint_reader_->OnMessageBatch(std::move(inbound));
+    return true;
+}
+
+} // namespace remote
+} // namespace protoactor
@@ -0,0 +1,574 @@
+#include "internal/remote/wire.h"
+#include "internal/remote/lz4.h"
+#include <cstring>
+
+namespace protoactor {
+namespace remote {
+namespace wire {
+
+namespace {
+
+constexpr uint32_t kVarint = 0;
+constexpr uint32_t kFixed64 = 1;
+constexpr uint32_t kLengthDelimited = 2;
+constexpr uint32_t kFixed32 = 5;
+
+// Reserved length: a padded varint, valid protobuf and large enough for any frame
+constexpr std::size_t kLengthSlot = 5;
+// Contents up to this size are moved to drop the padding
+constexpr std::size_t kCompactLimit = 4096;
+// Largest batch DecompressBatch expands (the transports' default frame limit)
+constexpr uint64_t kMaxUncompressedBatch = 64 * 1024 * 1024;
+// LZ4 cannot expand input by more than this factor; larger claims are malformed
+constexpr uint64_t kMaxLz4Ratio = 255;
+
+// Field numbers (proto/remote.proto, proto/actor.proto)
+namespace field {
+constexpr uint32_t kMessageBatch = 1;
+constexpr uint32_t kConnectRequest = 2;
+constexpr uint32_t kConnectResponse = 3;
+constexpr uint32_t kDisconnectRequest = 4;
+
+constexpr uint32_t kBatchTypeNames = 1;
+constexpr uint32_t kBatchTargets = 2;
+constexpr uint32_t kBatchEnvelopes = 3;
+constexpr uint32_t kBatchSenders = 4;
+constexpr uint32_t kBatchDictionaryReset = 5;
+constexpr uint32_t kBatchCompression = 6;
+constexpr uint32_t kBatchUncompressedSize = 7;
+constexpr uint32_t kBatchCompressed = 8;
+
+constexpr uint32_t kEnvelopeTypeId = 1;
+constexpr uint32_t kEnvelopeData = 2;
+constexpr uint32_t kEnvelopeTarget = 3;
+constexpr uint32_t kEnvelopeSender = 4;
+constexpr uint32_t kEnvelopeSerializerId = 5;
+constexpr uint32_t kEnvelopeTargetRequestId = 7;
+constexpr uint32_t kEnvelopeSenderRequestId = 8;
+
+constexpr uint32_t kPidAddress = 1;
+constexpr uint32_t kPidId = 2;
+constexpr uint32_t kPidRequestId = 3;
+
+constexpr uint32_t kClientConnection = 1;
+constexpr uint32_t kServerConnection = 2;
+constexpr uint32_t kConnectionMemberId = 1;
+constexpr uint32_t kConnectionAddress = 2;
+constexpr uint32_t kConnectionBlockList = 3;
+constexpr uint32_t kConnectionDictionary = 4;
+constexpr uint32_t kConnectionCompression = 5;
+
+constexpr uint32_t kResponseMemberId = 2;
+constexpr uint32_t kResponseBlocked = 3;
+constexpr uint32_t kResponseDictionary = 4;
+constexpr uint32_t kResponseCompression = 5;
+} // namespace field
+
+bool DecodePID(std::string_view bytes, PID* pid) {
+    ProtoReader reader(bytes);
+    uint32_t number;
+    uint32_t type;
+    while (reader.Next(&number, &type)) {
+        uint64_t value;
+        if (number == field::kPidAddress && type == kLengthDelimited) {
+            if (!reader.ReadBytes(&pid->address)) return false;
+        } else if (number == field::kPidId && type == kLengthDelimited) {
+            if (!reader.ReadBytes(&pid->id)) return false;
+        } else if (number == field::kPidRequestId && type == kVarint) {
+            if (!reader.ReadVarint(&value)) return false;
+            pid->request_id = static_cast<uint32_t>(value);
+        } else if (!reader.Skip(type)) {
+            return false;
+        }
+    }
+    return reader.Ok();
+}
+
+bool DecodeEnvelope(std::string_view bytes, Envelope* envelope) {
+    ProtoReader reader(bytes);
+    uint32_t number;
+    uint32_t type;
+    while (reader.Next(&number, &type)) {
+        if (number == field::kEnvelopeData && type == kLengthDelimited) {
+            if (!reader.ReadBytes(&envelope->message_data)) return false;
+            continue;
+        }
+        if (type != kVarint) {
+            if (!reader.Skip(type)) return false;
+            continue;
+        }
+        uint64_t value;
+        if (!reader.ReadVarint(&value)) return false;
+        switch (number) {
+            case field::kEnvelopeTypeId: envelope->type_id = static_cast<int32_t>(value); break;
+            case field::kEnvelopeTarget: envelope->target = static_cast<int32_t>(value); break;
+            case field::kEnvelopeSender: envelope->sender = static_cast<int32_t>(value); break;
+            case field::kEnvelopeSerializerId: envelope->serializer_id = static_cast<int32_t>(value); break;
+            case field::kEnvelopeTargetRequestId: envelope->target_request_id = static_cast<uint32_t>(value); break;
+            case field::kEnvelopeSenderRequestId: envelope->sender_request_id = static_cast<uint32_t>(value); break;
+            default: break;
+        }
+    }
+    return reader.Ok();
+}
+
+bool DecodeBatch(std::string_view bytes, MessageBatch* batch) {
+    ProtoReader reader(bytes);
+    uint32_t number;
+    uint32_t type;
+    while (reader.Next(&number, &type)) {
+        std::string_view value;
+        if (type == kVarint && number >= field::kBatchDictionaryReset && number <= field::kBatchUncompressedSize) {
+            uint64_t flag;
+            if (!reader.ReadVarint(&flag)) return false;
+            if (number == field::kBatchDictionaryReset) {
+                batch->dictionary_reset = flag != 0;
+            } else if (number == field::kBatchCompression) {
+                batch->compression = static_cast<uint32_t>(flag);
+            } else {
+                batch->uncompressed_size = flag;
+            }
+            continue;
+        }
+        if (type != kLengthDelimited) {
+            if (!reader.Skip(type)) return false;
+            continue;
+        }
+        if (!reader.ReadBytes(&value)) return false;
+        switch (number) {
+            case field::kBatchTypeNames:
+                batch->type_names.push_back(value);
+                break;
+            case field::kBatchTargets:
+                batch->targets.push_back(value);
+                break;
+            case field::kBatchEnvelopes:
+                batch->envelopes.emplace_back();
+                if (!DecodeEnvelope(value, &batch->envelopes.back())) return false;
+                break;
+            case field::kBatchSenders:
+                batch->senders.emplace_back();
+                if (!DecodePID(value, &batch->senders.back())) return false;
+                break;
+            case field::kBatchCompressed:
+                batch->compressed = value;
+                break;
+            default:
+                break;
+        }
+    }
+    return reader.Ok();
+}
+
+bool DecodeConnection(std::string_view bytes, ConnectRequest* request) {
+    ProtoReader reader(bytes);
+    uint32_t number;
+    uint32_t type;
+    while (reader.Next(&number, &type)) {
+        std::string_view value;
+        if ((number == field::kConnectionDictionary || number == field::kConnectionCompression) && type == kVarint) {
+            uint64_t flag;
+            if (!reader.ReadVarint(&flag)) return false;
+            if (number == field::kConnectionDictionary) {
+                request->connection_dictionary = flag != 0;
+            } else {
+                request->compression = static_cast<uint32_t>(flag);
+            }
+            continue;
+        }
+        if (type != kLengthDelimited) {
+            if (!reader.Skip(type)) return false;
+            continue;
+        }
+        if (!reader.ReadBytes(&value)) return false;
+        if (number == field::kConnectionMemberId) {
+            request->member_id.assign(value);
+        } else if (number == field::kConnectionAddress) {
+            request->address.assign(value);
+        } else if (number == field::kConnectionBlockList) {
+            request->block_list.emplace_back(value);
+        }
+    }
+    return reader.Ok();
+}
+
+bool DecodeConnectRequest(std::string_view bytes, ConnectRequest* request) {
+    ProtoReader reader(bytes);
+    uint32_t number;
+    uint32_t type;
+    while (reader.Next(&number, &type)) {
+        std::string_view value;
+        if ((number == field::kClientConnection || number == field::kServerConnection) && type == kLengthDelimited) {
+            if (!reader.ReadBytes(&value)) return false;
+            request->server_connection = number == field::kServerConnection;
+            if (!DecodeConnection(value, request)) return false;
+        } else if (!reader.Skip(type)) {
+            return false;
+        }
+    }
+    return reader.Ok();
+}
+
+bool DecodeConnectResponse(std::string_view bytes, ConnectResponse* response) {
+    ProtoReader reader(bytes);
+    uint32_t number;
+    uint32_t type;
+    while (reader.Next(&number, &type)) {
+        if (number == field::kResponseMemberId && type == kLengthDelimited) {
+            std::string_view value;
+            if (!reader.ReadBytes(&value)) return false;
+            response->member_id.assign(value);
+        } else if ((number == field::kResponseBlocked || number == field::kResponseDictionary) && type == kVarint) {
+            uint64_t flag;
+            if (!reader.ReadVarint(&flag)) return false;
+            (number == field::kResponseBlocked ? response->blocked : response->connection_dictionary) = flag != 0;
+        } else if (number == field::kResponseCompression && type == kVarint) {
+            uint64_t codec;
+            if (!reader.ReadVarint(&codec)) return false;
+            response->compression = static_cast<uint32_t>(codec);
+        } else if (!reader.Skip(type)) {
+            return false;
+        }
+    }
+    return reader.Ok();
+}
+
+} // namespace
+
+uint32_t NegotiateCompression(uint32_t codec) {
+    return codec == kCompressionLz4 ? kCompressionLz4 : kCompressionNone;
+}
+
+void ProtoWriter::RawVarint(uint64_t value) {
+    while (value >= 0x80) {
+        out_->push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out_->push_back(static_cast<char>(value));
+}
+
+void ProtoWriter::Varint(uint32_t field, uint64_t value) {
+    RawVarint((static_cast<uint64_t>(field) << 3) | kVarint);
+    RawVarint(value);
+}
+
+void ProtoWriter::Int32(uint32_t field, int32_t value) {
+    // Negative int32 values are sign-extended to ten bytes, as protobuf does
+    Varint(field, static_cast<uint64_t>(static_cast<int64_t>(value)));
+}
+
+void ProtoWriter::Bool(uint32_t field, bool value) {
+    Varint(field, value ? 1 : 0);
+}
+
+void ProtoWriter::Bytes(uint32_t field, std::string_view value) {
+    RawVarint((static_cast<uint64_t>(field) << 3) | kLengthDelimited);
+    RawVarint(value.size());
+    out_->append(value.data(), value.size());
+}
+
+std::size_t ProtoWriter::Begin(uint32_t field) {
+    RawVarint((static_cast<uint64_t>(field) << 3) | kLengthDelimited);
+    auto mark = out_->size();
+    out_->append(kLengthSlot, '\0');
+    return mark;
+}
+
+std::size_t ProtoWriter::End(std::size_t mark) {
+    auto start = mark + kLengthSlot;
+    auto length = out_->size() - start;
+    char* slot = &(*out_)[mark];
+    if (length <= kCompactLimit) {
+        char encoded[kLengthSlot];
+        std::size_t n = 0;
+        auto value = static_cast<uint64_t>(length);
+        while (value >= 0x80) {
+            encoded[n++] = static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        encoded[n++] = static_cast<char>(value);
+        std::memmove(slot + n, slot + kLengthSlot, length);
+        std::memcpy(slot, encoded, n);
+        out_->resize(mark + n + length);
+        return length;
+    }
+    auto value = static_cast<uint64_t>(length);
+    for (std::size_t i = 0; i < kLengthSlot; ++i) {
+        auto bits = static_cast<char>(value & 0x7F);
+        value >>= 7;
+        slot[i] = i + 1 < kLengthSlot ? static_cast<char>(bits | 0x80) : bits;
+    }
+    return length;
+}
+
+bool ProtoReader::ReadVarint(uint64_t* value) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64 && pos_ < in_.size(); shift += 7) {
+        auto byte = static_cast<uint8_t>(in_[pos_++]);
+        result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+    ok_ = false;
+    return false;
+}
+
+bool ProtoReader::Next(uint32_t* field, uint32_t* wire_type) {
+    if (!ok_ || pos_ >= in_.size()) {
+        return false;
+    }
+    uint64_t tag;
+    if (!ReadVarint(&tag)) {
+        return false;
+    }
+    *field = static_cast<uint32_t>(tag >> 3);
+    *wire_type = static_cast<uint32_t>(tag & 0x7);
+    return true;
+}
+
+bool ProtoReader::ReadBytes(std::string_view* value) {
+    uint64_t length;
+    if (!ReadVarint(&length)) {
+        return false;
+    }
+    if (length > in_.size() - pos_) {
+        ok_ = false;
+        return false;
+    }
+    *value = in_.substr(pos_, static_cast<std::size_t>(length));
+    pos_ += static_cast<std::size_t>(length);
+    return true;
+}
+
+bool ProtoReader::Skip(uint32_t wire_type) {
+    uint64_t ignored;
+    std::string_view view;
+    std::size_t size = 0;
+    switch (wire_type) {
+        case kVarint:
+            return ReadVarint(&ignored);
+        case kLengthDelimited:
+            return ReadBytes(&view);
+        case kFixed64:
+            size = 8;
+            break;
+        case kFixed32:
+            size = 4;
+            break;
+        default:
+            ok_ = false;
+            return false;
+    }
+    if (size > in_.size() - pos_) {
+        ok_ = false;
+        return false;
+    }
+    pos_ += size;
+    return true;
+}
+
+bool Decode(std::string_view frame, RemoteMessage* message) {
+    ProtoReader reader(frame);
+    uint32_t number;
+    uint32_t type;
+    message->type = RemoteMessage::Type::None;
+    while (reader.Next(&number, &type)) {
+        if (type != kLengthDelimited || number < field::kMessageBatch || number > field::kDisconnectRequest) {
+            if (!reader.Skip(type)) return false;
+            continue;
+        }
+        std::string_view value;
+        if (!reader.ReadBytes(&value)) return false;
+        bool ok = true;
+        switch (number) {
+            case field::kMessageBatch:
+                message->type = RemoteMessage::Type::MessageBatch;
+                message->message_batch = MessageBatch();
+                ok = DecodeBatch(value, &message->message_batch);
+                break;
+            case field::kConnectRequest:
+                message->type = RemoteMessage::Type::ConnectRequest;
+                message->connect_request = ConnectRequest();
+                ok = DecodeConnectRequest(value, &message->connect_request);
+                break;
+            case field::kConnectResponse:
+                message->type = RemoteMessage::Type::ConnectResponse;
+                message->connect_response = ConnectResponse();
+                ok = DecodeConnectResponse(value, &message->connect_response);
+                break;
+            default:
+                message->type = RemoteMessage::Type::DisconnectRequest;
+                break;
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    return reader.Ok();
+}
+
+void EncodeConnectRequest(const ConnectRequest& request, std::string* out) {
+    ProtoWriter writer(out);
+    auto message = writer.Begin(field::kConnectRequest);
+    auto connection = writer.Begin(request.server_connection ? field::kServerConnection : field::kClientConnection);
+    if (!request.member_id.empty()) {
+        writer.Bytes(field::kConnectionMemberId, request.member_id);
+    }
+    if (request.server_connection) {
+        if (!request.address.empty()) {
+            writer.Bytes(field::kConnectionAddress, request.address);
+        }
+        for (const auto& member : request.block_list) {
+            writer.Bytes(field::kConnectionBlockList, member);
+        }
+        if (request.connection_dictionary) {
+            writer.Bool(field::kConnectionDictionary, true);
+        }
+        if (request.compression != kCompressionNone) {
+            writer.Varint(field::kConnectionCompression, request.compression);
+        }
+    }
+    writer.End(connection);
+    writer.End(message);
+}
+
+void EncodeConnectResponse(const ConnectResponse& response, std::string* out) {
+    ProtoWriter writer(out);
+    auto message = writer.Begin(field::kConnectResponse);
+    if (!response.member_id.empty()) {
+        writer.Bytes(field::kResponseMemberId, response.member_id);
+    }
+    if (response.blocked) {
+        writer.Bool(field::kResponseBlocked, true);
+    }
+    if (response.connection_dictionary) {
+        writer.Bool(field::kResponseDictionary, true);
+    }
+    if (response.compression != kCompressionNone) {
+        writer.Varint(field::kResponseCompression, response.compression);
+    }
+    writer.End(message);
+}
+
+void EncodeDisconnectRequest(std::string* out) {
+    ProtoWriter writer(out);
+    writer.End(writer.Begin(field::kDisconnectRequest));
+}
+
+bool CompressBatch(std::string_view frame, uint32_t codec, std::string* out) {
+    if (codec != kCompressionLz4) {
+        return false;
+    }
+    ProtoReader reader(frame);
+    uint32_t number;
+    uint32_t type;
+    std::string_view body;
+    if (!reader.Next(&number, &type) || number != field::kMessageBatch || type != kLengthDelimited ||
+        !reader.ReadBytes(&body)) {
+        return false;
+    }
+
+    // The batch contents (type names, targets, envelopes, senders) become one LZ4 block
+    auto start = out->size();
+    ProtoWriter writer(out);
+    auto message = writer.Begin(field::kMessageBatch);
+    writer.Varint(field::kBatchCompression, codec);
+    writer.Varint(field::kBatchUncompressedSize, body.size());
+    auto data = writer.Begin(field::kBatchCompressed);
+    lz4::Compress(body, out);
+    writer.End(data);
+    writer.End(message);
+    if (out->size() - start >= frame.size()) {
+        out->resize(start);
+        return false;
+    }
+    return true;
+}
+
+bool DecompressBatch(const MessageBatch& batch, std::string* body, MessageBatch* decoded) {
+    if (batch.compression != kCompressionLz4 || batch.uncompressed_size > kMaxUncompressedBatch ||
+        batch.uncompressed_size > batch.compressed.size() * kMaxLz4Ratio) {
+        return false;
+    }
+    body->clear();
+    if (!lz4::Decompress(batch.compressed, static_cast<std::size_t>(batch.uncompressed_size), body)) {
+        return false;
+    }
+    *decoded = MessageBatch();
+    // A compressed batch must not nest another one
+    return DecodeBatch(*body, decoded) && decoded->compression == kCompressionNone;
+}
+
+BatchEncoder::BatchEncoder(std::string* out)
+    : writer_(out),
+      message_mark_(writer_.Begin(field::kMessageBatch)),
+      envelope_start_(0),
+      envelope_mark_(0),
+      data_mark_(0),
+      envelopes_(0) {
+}
+
+void BatchEncoder::DictionaryReset() {
+    writer_.Bool(field::kBatchDictionaryReset, true);
+}
+
+void BatchEncoder::TypeName(std::string_view type_name) {
+    writer_.Bytes(field::kBatchTypeNames, type_name);
+}
+
+void BatchEncoder::Target(std::string_view id) {
+    writer_.Bytes(field::kBatchTargets, id);
+}
+
+void BatchEncoder::Sender(std::string_view address, std::string_view id) {
+    auto mark = writer_.Begin(field::kBatchSenders);
+    writer_.Bytes(field::kPidAddress, address);
+    writer_.Bytes(field::kPidId, id);
+    writer_.End(mark);
+}
+
+std::string* BatchEncoder::BeginEnvelope() {
+    envelope_start_ = writer_.Buffer()->size();
+    envelope_mark_ = writer_.Begin(field::kBatchEnvelopes);
+    data_mark_ = writer_.Begin(field::kEnvelopeData);
+    return writer_.Buffer();
+}
+
+std::size_t BatchEncoder::EndEnvelope(const Envelope& fields) {
+    auto size = writer_.End(data_mark_);
+    if (fields.type_id != 0) {
+        writer_.Int32(field::kEnvelopeTypeId, fields.type_id);
+    }
+    if (fields.target != 0) {
+        writer_.Int32(field::kEnvelopeTarget, fields.target);
+    }
+    if (fields.sender != 0) {
+        writer_.Int32(field::kEnvelopeSender, fields.sender);
+    }
+    if (fields.serializer_id != 0) {
+        writer_.Int32(field::kEnvelopeSerializerId, fields.serializer_id);
+    }
+    if (fields.target_request_id != 0) {
+        writer_.Varint(field::kEnvelopeTargetRequestId, fields.target_request_id);
+    }
+    if (fields.sender_request_id != 0) {
+        writer_.Varint(field::kEnvelopeSenderRequestId, fields.sender_request_id);
+    }
+    writer_.End(envelope_mark_);
+    ++envelopes_;
+    return size;
+}
+
+void BatchEncoder::AbortEnvelope() {
+    writer_.Buffer()->resize(envelope_start_);
+}
+
+void BatchEncoder::Finish() {
+    writer_.End(message_mark_);
+}
+
+} // namespace wire
+} // namespace remote
+} // namespace protoactor
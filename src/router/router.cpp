@@ -1,16 +1,45 @@
 #include "external/router/router.h"
 #include "external/context.h"
 #include "external/pid.h"
+#include "external/actor_system.h"
+#include "external/messages.h"
+#include "external/scatter_gather.h"
+#include "internal/actor/actor_process.h"
+#include "internal/actor/scatter_gather.h"
+#include "internal/mailbox.h"
 #include <random>
 #include <algorithm>
+#include <climits>
 #include <cstddef>
+#include <unordered_map>
 
 namespace protoactor {
 namespace router {
 
+namespace {
+
+// Finalizer from splitmix64: spreads sequential keys evenly over the ring
+uint64_t Mix(uint64_t h) {
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h;
+}
+
+std::mt19937& Generator() {
+    static thread_local std::random_device rd;
+    static thread_local std::mt19937 gen(rd());
+    return gen;
+}
+
+} // namespace
+
 // BroadcastRouter implementation
 void BroadcastRouter::RouteMessage(std::shared_ptr<void> message) {
-    for (auto& routee : routees_) {
+    auto routees = routees_.Load();
+    for (auto& routee : *routees) {
         if (sender_) {
             sender_->Send(routee, message);
         }
@@ -18,11 +47,11 @@ void BroadcastRouter::RouteMessage(std::shared_ptr<void> message) {
 }
 
 void BroadcastRouter::SetRoutees(const std::vector<std::shared_ptr<PID>>& routees) {
-    routees_ = routees;
+    routees_.Store(routees);
 }
 
 std::vector<std::shared_ptr<PID>> BroadcastRouter::GetRoutees() const {
-    return routees_;
+    return *routees_.Load();
 }
 
 void BroadcastRouter::SetSender(SenderContext sender) {
@@ -35,29 +64,30 @@ RoundRobinRouter::RoundRobinRouter()
 }
 
 void RoundRobinRouter::RouteMessage(std::shared_ptr<void> message) {
-    if (routees_.empty()) {
+    auto routees = routees_.Load();
+    if (routees->empty()) {
         return;
     }
     
     int index = current_index_.fetch_add(1, std::memory_order_relaxed);
-    index = index % static_cast<int>(routees_.size());
+    index = index % static_cast<int>(routees->size());
     
     if (index < 0) {
-        index += routees_.size();
+        index += routees->size();
     }
     
-    if (sender_ && index < static_cast<int>(routees_.size())) {
-        sender_->Send(routees_[index], message);
+    if (sender_ && index < static_cast<int>(routees->size())) {
+        sender_->Send((*routees)[index], message);
     }
 }
 
 void RoundRobinRouter::SetRoutees(const std::vector<std::shared_ptr<PID>>& routees) {
-    routees_ = routees;
+    routees_.Store(routees);
     current_index_.store(0, std::memory_order_relaxed);
 }
 
 std::vector<std::shared_ptr<PID>> RoundRobinRouter::GetRoutees() const {
-    return routees_;
+    return *routees_.Load();
 }
 
 void RoundRobinRouter::SetSender(SenderContext sender) {
@@ -66,60 +96,408 @@ void RoundRobinRouter::SetSender(SenderContext sender) {
 
 // RandomRouter implementation
 void RandomRouter::RouteMessage(std::shared_ptr<void> message) {
-    if (routees_.empty()) {
+    auto routees = routees_.Load();
+    if (routees->empty()) {
         return;
     }
     
-    static thread_local std::random_device rd;
-    static thread_local std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, static_cast<int>(routees_.size()) - 1);
+    std::uniform_int_distribution<> dis(0, static_cast<int>(routees->size()) - 1);
     
-    int index = dis(gen);
+    int index = dis(Generator());
     if (!sender_) {
         return;
     }
-    if (index < static_cast<int>(routees_.size())) {
-        sender_->Send(routees_[index], message);
+    if (index < static_cast<int>(routees->size())) {
+        sender_->Send((*routees)[index], message);
     }
 }
 
 void RandomRouter::SetRoutees(const std::vector<std::shared_ptr<PID>>& routees) {
-    routees_ = routees;
+    routees_.Store(routees);
 }
 
 std::vector<std::shared_ptr<PID>> RandomRouter::GetRoutees() const {
-    return routees_;
+    return *routees_.Load();
 }
 
 void RandomRouter::SetSender(SenderContext sender) {
     sender_ = sender;
 }
 
-// ConsistentHashRouter implementation
-void ConsistentHashRouter::RouteMessage(std::shared_ptr<void> message) {
-    if (routees_.empty()) {
+// MailboxRouter implementation
+void MailboxRouter::SetRoutees(const std::vector<std::shared_ptr<PID>>& routees) {
+    pending_ = routees;
+    Publish();
+}
+
+std::vector<std::shared_ptr<PID>> MailboxRouter::GetRoutees() const {
+    std::vector<std::shared_ptr<PID>> pids;
+    for (auto& routee : *Load()) {
+        pids.push_back(routee.pid);
+    }
+    return pids;
+}
+
+void MailboxRouter::SetSender(SenderContext sender) {
+    sender_ = sender;
+    Publish();
+}
+
+MailboxRouter::Snapshot MailboxRouter::Load() const {
+    return snapshot_.Load();
+}
+
+void MailboxRouter::Publish() {
+    auto system = sender_ ? sender_->GetActorSystem() : nullptr;
+    auto registry = system ? system->GetProcessRegistry() : nullptr;
+    std::vector<Routee> routees;
+    routees.reserve(pending_.size());
+    for (auto& pid : pending_) {
+        Routee routee{pid, {}};
+        if (registry && pid) {
+            auto [process, exists] = registry->Get(pid);
+            auto actor = exists ? std::dynamic_pointer_cast<ActorProcess>(process) : nullptr;
+            if (actor) {
+                routee.mailbox = actor->GetMailbox();
+            }
+        }
+        routees.push_back(std::move(routee));
+    }
+    snapshot_.Store(std::move(routees));
+}
+
+int MailboxRouter::Depth(const Routee& routee) {
+    auto mailbox = routee.mailbox.lock();
+    return mailbox ? mailbox->UserMessageCount() : INT_MAX;
+}
+
+void MailboxRouter::Send(const Routee& routee, std::shared_ptr<void> message) {
+    if (sender_) {
+        sender_->Send(routee.pid, message);
+    }
+}
+
+// FanoutBroadcastRouter implementation
+void FanoutBroadcastRouter::RouteMessage(std::shared_ptr<void> message) {
+    auto routees = Load();
+    
+    // Mailboxes this broadcast made runnable, grouped by dispatcher
+    std::unordered_map<Dispatcher*, std::pair<std::shared_ptr<Dispatcher>, std::vector<std::shared_ptr<Mailbox>>>> groups;
+    for (auto& routee : *routees) {
+        auto mailbox = routee.mailbox.lock();
+        if (!mailbox) {
+            Send(routee, message);
+            continue;
+        }
+        if (!mailbox->EnqueueUserMessage(message)) {
+            continue;  // Already scheduled; the running pass picks the message up
+        }
+        auto dispatcher = mailbox->GetDispatcher();
+        if (!dispatcher) {
+            mailbox->Run();
+            continue;
+        }
+        auto& group = groups[dispatcher.get()];
+        group.first = dispatcher;
+        group.second.push_back(std::move(mailbox));
+    }
+    
+    for (auto& entry : groups) {
+        auto& dispatcher = entry.second.first;
+        auto& mailboxes = entry.second.second;
+        for (std::size_t begin = 0; begin < mailboxes.size(); begin += FANOUT_BATCH) {
+            std::size_t end = std::min(begin + FANOUT_BATCH, mailboxes.size());
+            std::vector<std::shared_ptr<Mailbox>> batch(
+                std::make_move_iterator(mailboxes.begin() + begin),
+                std::make_move_iterator(mailboxes.begin() + end));
+            dispatcher->Schedule([batch = std::move(batch)]() {
+                for (auto& mailbox : batch) {
+                    mailbox->Run();
+                }
+            });
+        }
+    }
+}
+
+// LeastLoadedRouter implementation
+void LeastLoadedRouter::RouteMessage(std::shared_ptr<void> message) {
+    auto routees = Load();
+    std::size_t n = routees->size();
+    if (n == 0) {
+        return;
+    }
+    if (n == 1) {
+        Send((*routees)[0], message);
         return;
     }
     
-    // Simplified consistent hashing - would use proper hash ring in production
-    // For now, use a simple hash of the message pointer
-    size_t hash = std::hash<std::shared_ptr<void>>()(message);
-    int index = static_cast<int>(hash % routees_.size());
+    // Two distinct random choices; ties keep the first one
+    auto& gen = Generator();
+    std::size_t a = std::uniform_int_distribution<std::size_t>(0, n - 1)(gen);
+    std::size_t b = (a + 1 + std::uniform_int_distribution<std::size_t>(0, n - 2)(gen)) % n;
+    const Routee& pick = Depth((*routees)[b]) < Depth((*routees)[a]) ? (*routees)[b] : (*routees)[a];
+    Send(pick, message);
+}
+
+// SmallestMailboxRouter implementation
+void SmallestMailboxRouter::RouteMessage(std::shared_ptr<void> message) {
+    auto routees = Load();
+    if (routees->empty()) {
+        return;
+    }
     
+    // Start the scan at a random routee so that ties do not all land on the first one
+    std::size_t n = routees->size();
+    std::size_t start = std::uniform_int_distribution<std::size_t>(0, n - 1)(Generator());
+    std::size_t best = start;
+    int best_depth = INT_MAX;
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t index = (start + i) % n;
+        int depth = Depth((*routees)[index]);
+        if (depth < best_depth) {
+            best = index;
+            best_depth = depth;
+            if (depth == 0) {
+                break;  // Cannot do better than an empty mailbox
+            }
+        }
+    }
+    Send((*routees)[best], message);
+}
+
+// ScatterGatherFirstCompletedRouter implementation
+void ScatterGatherFirstCompletedRouter::LatencyHistogram::Record(std::chrono::microseconds latency) {
+    uint64_t us = static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0));
+    int bucket = 0;
+    while (bucket < BUCKETS - 1 && (us >> (bucket + 1)) > 0) {
+        ++bucket;
+    }
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    if (count.fetch_add(1, std::memory_order_relaxed) + 1 >= DECAY_AT) {
+        // Halve the history so the estimate follows recent latency (approximate under races)
+        uint64_t kept = 0;
+        for (auto& b : buckets) {
+            uint64_t half = b.load(std::memory_order_relaxed) / 2;
+            b.store(half, std::memory_order_relaxed);
+            kept += half;
+        }
+        count.store(kept, std::memory_order_relaxed);
+    }
+}
+
+std::chrono::microseconds ScatterGatherFirstCompletedRouter::LatencyHistogram::P95() const {
+    uint64_t total = 0;
+    uint64_t counts[BUCKETS];
+    for (int i = 0; i < BUCKETS; ++i) {
+        counts[i] = buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total < MIN_SAMPLES) {
+        return std::chrono::microseconds(0);
+    }
+    uint64_t threshold = (total * 95 + 99) / 100;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        seen += counts[i];
+        if (seen >= threshold) {
+            return std::chrono::microseconds(uint64_t(2) << i);
+        }
+    }
+    return std::chrono::microseconds(uint64_t(2) << (BUCKETS - 1));
+}
+
+ScatterGatherFirstCompletedRouter::ScatterGatherFirstCompletedRouter(
+    int k,
+    std::chrono::milliseconds timeout,
+    bool hedged,
+    std::chrono::milliseconds initial_hedge_delay)
+    : k_(k > 0 ? k : 1),
+      timeout_(timeout),
+      hedged_(hedged),
+      initial_hedge_delay_(initial_hedge_delay),
+      next_(0),
+      state_(std::make_shared<State>()) {
+}
+
+ScatterGatherFirstCompletedRouter::~ScatterGatherFirstCompletedRouter() {
+    // Resolve the pending futures; callbacks still running only touch state_
+    CancelOutstanding();
+}
+
+std::chrono::milliseconds ScatterGatherFirstCompletedRouter::HedgeDelay() const {
+    auto p95 = state_->latency.P95();
+    if (p95.count() == 0) {
+        return initial_hedge_delay_;
+    }
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(p95 + std::chrono::microseconds(999));
+    return std::max(ms, std::chrono::milliseconds(1));
+}
+
+std::shared_ptr<Future> ScatterGatherFirstCompletedRouter::Request(std::shared_ptr<void> message) {
+    auto routees = routees_.Load();
+    auto system = sender_ ? sender_->GetActorSystem() : nullptr;
+    if (!system) {
+        return nullptr;
+    }
+    
+    // k distinct routees, rotating the starting point across requests
+    std::vector<std::shared_ptr<PID>> targets;
+    std::size_t n = routees->size();
+    std::size_t count = std::min(static_cast<std::size_t>(k_), n);
+    std::size_t start = n > 0 ? next_.fetch_add(1, std::memory_order_relaxed) % n : 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        targets.push_back((*routees)[(start + i) % n]);
+    }
+    
+    auto future = ScatterGatherFuture::New(system, targets, GatherMode::First, 0, timeout_);
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        id = state_->next_request++;
+        state_->outstanding[id] = future;
+    }
+    auto start_time = std::chrono::steady_clock::now();
+    std::weak_ptr<State> weak_state = state_;
+    future->ContinueWith([weak_state, id, start_time](std::shared_ptr<void>, std::error_code err) {
+        auto state = weak_state.lock();
+        if (!state) {
+            return;
+        }
+        if (!err) {
+            state->latency.Record(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start_time));
+        }
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->outstanding.erase(id);
+    });
+    
+    auto send = [system](std::shared_ptr<PID> pid, std::shared_ptr<MessageEnvelope> env) {
+        pid->SendUserMessage(system, env);
+    };
+    if (hedged_) {
+        future->Hedge(message, send, HedgeDelay());
+    } else {
+        future->Scatter(message, send);
+    }
+    return future;
+}
+
+void ScatterGatherFirstCompletedRouter::RouteMessage(std::shared_ptr<void> message) {
+    auto [header, msg, sender] = UnwrapEnvelope(message);
+    auto future = Request(msg);
+    if (!future || !sender) {
+        return;
+    }
+    auto system = sender_->GetActorSystem();
+    future->ContinueWith([system, sender](std::shared_ptr<void> res, std::error_code err) {
+        if (err || !res) {
+            return;
+        }
+        for (auto& response : std::static_pointer_cast<ScatterGatherResult>(res)->responses) {
+            if (response) {
+                sender->SendUserMessage(system, response);
+                return;
+            }
+        }
+    });
+}
+
+std::size_t ScatterGatherFirstCompletedRouter::CancelOutstanding() {
+    std::unordered_map<uint64_t, std::weak_ptr<ScatterGatherFuture>> outstanding;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        outstanding.swap(state_->outstanding);
+    }
+    std::size_t cancelled = 0;
+    for (auto& entry : outstanding) {
+        if (auto future = entry.second.lock()) {
+            future->Cancel();
+            ++cancelled;
+        }
+    }
+    return cancelled;
+}
+
+std::size_t ScatterGatherFirstCompletedRouter::Outstanding() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->outstanding.size();
+}
+
+void ScatterGatherFirstCompletedRouter::SetRoutees(const std::vector<std::shared_ptr<PID>>& routees) {
+    routees_.Store(routees);
+}
+
+std::vector<std::shared_ptr<PID>> ScatterGatherFirstCompletedRouter::GetRoutees() const {
+    return *routees_.Load();
+}
+
+void ScatterGatherFirstCompletedRouter::SetSender(SenderContext sender) {
+    sender_ = sender;
+}
+
+// ConsistentHashRouter implementation
+ConsistentHashRouter::ConsistentHashRouter(HashFunc hash, int replicas)
+    : hash_(std::move(hash)),
+      replicas_(replicas > 0 ? replicas : 1) {
+}
+
+uint64_t ConsistentHashRouter::HashKey(const std::string& key) {
+    // FNV-1a: stable across processes, unlike std::hash
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (unsigned char c : key) {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+std::shared_ptr<PID> ConsistentHashRouter::RouteeFor(const std::shared_ptr<void>& message) const {
+    auto ring = ring_.Load();
+    if (ring->nodes.empty()) {
+        return nullptr;
+    }
+    
+    uint64_t key = hash_ ? hash_(message) : static_cast<uint64_t>(std::hash<std::shared_ptr<void>>()(message));
+    uint64_t point = Mix(key);
+    auto it = std::lower_bound(
+        ring->nodes.begin(), ring->nodes.end(), point,
+        [](const std::pair<uint64_t, std::size_t>& node, uint64_t p) { return node.first < p; });
+    if (it == ring->nodes.end()) {
+        it = ring->nodes.begin();  // Wrap around
+    }
+    return ring->routees[it->second];
+}
+
+void ConsistentHashRouter::RouteMessage(std::shared_ptr<void> message) {
     if (!sender_) {
         return;
     }
-    if (index < static_cast<int>(routees_.size())) {
-        sender_->Send(routees_[index], message);
+    auto routee = RouteeFor(message);
+    if (routee) {
+        sender_->Send(routee, message);
     }
 }
 
 void ConsistentHashRouter::SetRoutees(const std::vector<std::shared_ptr<PID>>& routees) {
-    routees_ = routees;
+    Ring ring;
+    ring.routees = routees;
+    ring.nodes.reserve(routees.size() * static_cast<std::size_t>(replicas_));
+    for (std::size_t i = 0; i < routees.size(); ++i) {
+        if (!routees[i]) {
+            continue;
+        }
+        // Virtual node positions depend only on the routee identity, so they survive resizes
+        uint64_t base = HashKey(routees[i]->address + "/" + routees[i]->id);
+        for (int r = 0; r < replicas_; ++r) {
+            ring.nodes.emplace_back(Mix(base + static_cast<uint64_t>(r)), i);
+        }
+    }
+    std::sort(ring.nodes.begin(), ring.nodes.end());
+    ring_.Store(std::move(ring));
 }
 
 std::vector<std::shared_ptr<PID>> ConsistentHashRouter::GetRoutees() const {
-    return routees_;
+    return ring_.Load()->routees;
 }
 
 void ConsistentHashRouter::SetSender(SenderContext sender) {
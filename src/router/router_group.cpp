@@ -1,7 +1,17 @@
 #include "internal/router/router_group.h"
+#include "external/actor_system.h"
 #include "external/context.h"
+#include "external/dispatcher.h"
+#include "external/messages.h"
 #include "external/props.h"
+#include "external/router/router.h"
+#include "internal/actor/actor_process.h"
+#include "internal/mailbox.h"
+#include "internal/process_registry.h"
+#include "internal/scheduler/timer_wheel.h"
 #include <algorithm>
+#include <cmath>
+#include <iterator>
 
 namespace protoactor {
 namespace router {
@@ -89,5 +99,308 @@ void RouterActorPool::Stop() {
     routees_.clear();
 }
 
+ElasticPoolConfig::ElasticPoolConfig()
+    : min_routees(1),
+      max_routees(16),
+      scale_up_depth(32.0),
+      scale_down_depth(1.0),
+      scale_up_latency(0),
+      scale_down_latency(0),
+      stable_checks(3),
+      cooldown_checks(2),
+      grow_ratio(0.5),
+      check_interval(500) {
+}
+
+ElasticRouterActorPool::ElasticRouterActorPool(
+    std::shared_ptr<Context> context,
+    std::shared_ptr<Props> routee_props,
+    const ElasticPoolConfig& config)
+    : context_(context),
+      config_(config),
+      latency_(std::make_shared<LatencyStats>()) {
+    if (!context_->Self()) {
+        dispatcher_ = NewDefaultDispatcher(1);
+    }
+    config_.min_routees = std::max(config_.min_routees, 1);
+    config_.max_routees = std::max(config_.max_routees, config_.min_routees);
+    config_.stable_checks = std::max(config_.stable_checks, 1);
+    config_.cooldown_checks = std::max(config_.cooldown_checks, 0);
+    
+    // Routees share one stats block; the middleware only touches two atomics per message
+    std::weak_ptr<LatencyStats> stats = latency_;
+    ReceiverMiddleware timing = [stats](
+        std::function<void(std::shared_ptr<Context>, std::shared_ptr<MessageEnvelope>)> next) {
+        return [stats, next](std::shared_ptr<Context> ctx, std::shared_ptr<MessageEnvelope> envelope) {
+            auto start = std::chrono::steady_clock::now();
+            next(ctx, envelope);
+            if (auto s = stats.lock()) {
+                auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start);
+                s->total_us.fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+                s->messages.fetch_add(1, std::memory_order_relaxed);
+            }
+        };
+    };
+    props_ = std::make_shared<Props>(*routee_props);
+    auto middleware = routee_props->GetReceiverMiddleware();
+    middleware.push_back(timing);
+    props_->WithReceiverMiddleware(middleware);
+}
+
+std::shared_ptr<ElasticRouterActorPool> ElasticRouterActorPool::New(
+    std::shared_ptr<Context> context,
+    std::shared_ptr<Props> routee_props,
+    const ElasticPoolConfig& config) {
+    
+    auto pool = std::make_shared<ElasticRouterActorPool>(context, routee_props, config);
+    pool->Resize(pool->config_.min_routees);
+    pool->ScheduleCheck();
+    return pool;
+}
+
+std::vector<std::shared_ptr<PID>> ElasticRouterActorPool::GetRoutees() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return Pids();
+}
+
+void ElasticRouterActorPool::AttachRouter(std::shared_ptr<Router> router) {
+    if (!router) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    routers_.push_back(router);
+    router->SetRoutees(Pids());
+}
+
+double ElasticRouterActorPool::AverageDepth() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (routees_.empty()) {
+        return 0.0;
+    }
+    long total = 0;
+    for (auto& routee : routees_) {
+        if (auto mailbox = routee.mailbox.lock()) {
+            total += mailbox->UserMessageCount();
+        }
+    }
+    return static_cast<double>(total) / static_cast<double>(routees_.size());
+}
+
+std::chrono::microseconds ElasticRouterActorPool::MeanLatency() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_latency_;
+}
+
+int ElasticRouterActorPool::Evaluate() {
+    return Resize(Decide());
+}
+
+int ElasticRouterActorPool::Decide() {
+    double depth = AverageDepth();
+    
+    // Latency over the messages processed since the previous check
+    auto messages = latency_->messages.exchange(0, std::memory_order_relaxed);
+    auto total_us = latency_->total_us.exchange(0, std::memory_order_relaxed);
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) {
+        return 0;
+    }
+    if (messages > 0) {
+        last_latency_ = std::chrono::microseconds(static_cast<int64_t>(total_us / messages));
+    }
+    
+    bool latency_high = config_.scale_up_latency.count() > 0 && messages > 0 &&
+                        last_latency_ >= config_.scale_up_latency;
+    bool latency_low = config_.scale_up_latency.count() <= 0 || messages == 0 ||
+                       last_latency_ <= config_.scale_down_latency;
+    bool depth_high = config_.scale_up_depth > 0 && depth >= config_.scale_up_depth;
+    bool depth_low = depth <= config_.scale_down_depth;
+    
+    // Hysteresis: a signal must persist for stable_checks consecutive checks
+    up_streak_ = (depth_high || latency_high) ? up_streak_ + 1 : 0;
+    down_streak_ = (depth_low && latency_low) ? down_streak_ + 1 : 0;
+    
+    int size = static_cast<int>(routees_.size());
+    int delta = 0;
+    if (cooldown_ > 0) {
+        --cooldown_;
+    } else if (up_streak_ >= config_.stable_checks && size < config_.max_routees) {
+        int step = std::max(1, static_cast<int>(std::ceil(size * config_.grow_ratio)));
+        delta = std::min(step, config_.max_routees - size);
+    } else if (down_streak_ >= config_.stable_checks && size > config_.min_routees) {
+        // Shrink one at a time so a short lull does not drain the pool
+        delta = -1;
+    }
+    
+    if (delta != 0) {
+        up_streak_ = 0;
+        down_streak_ = 0;
+        cooldown_ = config_.cooldown_checks;
+    }
+    return delta;
+}
+
+int ElasticRouterActorPool::Resize(int delta) {
+    std::vector<Routee> spawned;
+    if (delta > 0) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopped_) {
+                return 0;
+            }
+            delta = std::min(delta, config_.max_routees - static_cast<int>(routees_.size()));
+        }
+        // Spawn outside the lock; with an owner actor this runs on its mailbox
+        spawned = SpawnRoutees(delta);
+    }
+    
+    std::vector<std::shared_ptr<PID>> retired;
+    std::vector<std::shared_ptr<PID>> orphaned;
+    int size;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            for (auto& routee : spawned) {
+                orphaned.push_back(routee.pid);
+            }
+        } else {
+            std::size_t before = routees_.size();
+            if (delta > 0) {
+                std::move(spawned.begin(), spawned.end(), std::back_inserter(routees_));
+            } else if (delta < 0) {
+                int excess = static_cast<int>(routees_.size()) - config_.min_routees;
+                retired = Shrink(std::min(-delta, std::max(excess, 0)));
+            }
+            if (routees_.size() != before) {
+                PublishToRouters(Pids());
+            }
+        }
+        size = static_cast<int>(routees_.size());
+    }
+    
+    // Routers no longer see retired routees; poison lets them finish what is queued
+    for (auto& pid : retired) {
+        context_->Poison(pid);
+    }
+    for (auto& pid : orphaned) {
+        context_->Stop(pid);
+    }
+    return size;
+}
+
+void ElasticRouterActorPool::Stop() {
+    std::vector<std::shared_ptr<PID>> pids;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+        pids = Pids();
+        routees_.clear();
+    }
+    for (auto& pid : pids) {
+        if (pid && context_) {
+            context_->Stop(pid);
+        }
+    }
+}
+
+std::vector<ElasticRouterActorPool::Routee> ElasticRouterActorPool::SpawnRoutees(int count) {
+    std::vector<Routee> spawned;
+    auto system = context_->GetActorSystem();
+    auto registry = system ? system->GetProcessRegistry() : nullptr;
+    for (int i = 0; i < count; ++i) {
+        auto pid = context_->Spawn(props_);
+        if (!pid) {
+            continue;
+        }
+        Routee routee{pid, {}};
+        if (registry) {
+            auto [process, exists] = registry->Get(pid);
+            auto actor = exists ? std::dynamic_pointer_cast<ActorProcess>(process) : nullptr;
+            if (actor) {
+                routee.mailbox = actor->GetMailbox();
+            }
+        }
+        spawned.push_back(std::move(routee));
+    }
+    return spawned;
+}
+
+std::vector<std::shared_ptr<PID>> ElasticRouterActorPool::Shrink(int count) {
+    std::vector<std::shared_ptr<PID>> retired;
+    // Newest routees go first
+    while (count-- > 0 && !routees_.empty()) {
+        retired.push_back(routees_.back().pid);
+        routees_.pop_back();
+    }
+    return retired;
+}
+
+std::vector<std::shared_ptr<PID>> ElasticRouterActorPool::Pids() const {
+    std::vector<std::shared_ptr<PID>> pids;
+    pids.reserve(routees_.size());
+    for (auto& routee : routees_) {
+        pids.push_back(routee.pid);
+    }
+    return pids;
+}
+
+void ElasticRouterActorPool::PublishToRouters(const std::vector<std::shared_ptr<PID>>& pids) {
+    auto it = routers_.begin();
+    while (it != routers_.end()) {
+        if (auto router = it->lock()) {
+            router->SetRoutees(pids);
+            ++it;
+        } else {
+            it = routers_.erase(it);
+        }
+    }
+}
+
+void ElasticRouterActorPool::ScheduleCheck() {
+    auto system = context_->GetActorSystem();
+    auto wheel = system ? system->GetTimerWheel() : nullptr;
+    if (!wheel || config_.check_interval.count() <= 0) {
+        return;
+    }
+    std::weak_ptr<ElasticRouterActorPool> weak_self = shared_from_this();
+    wheel->ScheduleAt(wheel->CurrentTick() + wheel->TicksFor(config_.check_interval), [weak_self]() {
+        auto self = weak_self.lock();
+        if (!self) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(self->mutex_);
+            if (self->stopped_) {
+                return;
+            }
+        }
+        // Only sample on the wheel; spawning and poisoning belong to the owner
+        int delta = self->Decide();
+        if (delta != 0) {
+            self->PostResize(delta);
+        }
+        self->ScheduleCheck();
+    });
+}
+
+void ElasticRouterActorPool::PostResize(int delta) {
+    std::weak_ptr<ElasticRouterActorPool> weak_self = shared_from_this();
+    auto resize = [weak_self, delta]() {
+        if (auto self = weak_self.lock()) {
+            self->Resize(delta);
+        }
+    };
+    // An actor owner runs the resize from its mailbox, where its context may be used
+    if (auto owner = context_->Self()) {
+        auto continuation = std::make_shared<Continuation>(
+            [resize](std::shared_ptr<void>, std::error_code) { resize(); }, nullptr);
+        owner->SendSystemMessage(context_->GetActorSystem(), continuation);
+    } else {
+        dispatcher_->Schedule(resize);
+    }
+}
+
 } // namespace router
 } // namespace protoactor
@@ -0,0 +1,124 @@
+#include "internal/scheduler/timer_wheel.h"
+#include <exception>
+#include <iostream>
+
+namespace protoactor {
+namespace scheduler {
+
+TimerWheel::TimerWheel(std::chrono::milliseconds tick, std::size_t slots)
+    : tick_(tick.count() > 0 ? tick : std::chrono::milliseconds(1)),
+      slots_(slots > 0 ? slots : 1),
+      current_tick_(0),
+      pending_(0),
+      running_(false),
+      stopped_(false) {
+}
+
+TimerWheel::~TimerWheel() {
+    Stop();
+}
+
+std::uint64_t TimerWheel::TicksFor(std::chrono::milliseconds duration) const {
+    if (duration.count() <= 0) {
+        return 1;
+    }
+    return static_cast<std::uint64_t>((duration.count() + tick_.count() - 1) / tick_.count());
+}
+
+void TimerWheel::ScheduleAt(std::uint64_t tick, Callback callback) {
+    if (stopped_.load(std::memory_order_acquire)) {
+        return;
+    }
+    EnsureStarted();
+
+    while (true) {
+        auto current = CurrentTick();
+        if (tick <= current) {
+            tick = current + 1;
+        }
+        auto& slot = slots_[tick % slots_.size()];
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        // The wheel thread publishes a tick before draining its slot, so while we hold the
+        // slot lock a tick still ahead of the clock is guaranteed to be drained later.
+        if (tick > CurrentTick()) {
+            slot.entries.push_back(Entry{tick, std::move(callback)});
+            pending_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+void TimerWheel::Stop() {
+    stopped_.store(true, std::memory_order_release);
+    if (!running_.exchange(false) || !thread_.joinable()) {
+        return;
+    }
+    if (thread_.get_id() == std::this_thread::get_id()) {
+        // Stopped from a callback: the thread exits on its own after this tick
+        thread_.detach();
+        return;
+    }
+    thread_.join();
+}
+
+void TimerWheel::EnsureStarted() {
+    std::call_once(start_once_, [this]() {
+        auto self = shared_from_this();
+        thread_ = std::thread([self]() { self->Run(); });
+        running_.store(true, std::memory_order_release);
+    });
+}
+
+void TimerWheel::Run() {
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t tick = CurrentTick();
+    while (!stopped_.load(std::memory_order_acquire)) {
+        ++tick;
+        // Sleep against the absolute schedule so that slow callbacks do not accumulate drift
+        std::this_thread::sleep_until(start + tick_ * static_cast<std::int64_t>(tick));
+        current_tick_.store(tick, std::memory_order_release);
+        Advance(tick);
+    }
+}
+
+void TimerWheel::Advance(std::uint64_t tick) {
+    auto& slot = slots_[tick % slots_.size()];
+    std::vector<Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        entries.swap(slot.entries);
+    }
+    if (entries.empty()) {
+        return;
+    }
+
+    std::vector<Entry> pending;
+    for (auto& entry : entries) {
+        if (entry.tick > tick) {
+            // Due in a later revolution
+            pending.push_back(std::move(entry));
+            continue;
+        }
+        if (stopped_.load(std::memory_order_acquire)) {
+            return;
+        }
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        try {
+            entry.callback();
+        } catch (const std::exception& e) {
+            std::cerr << "Timer wheel callback exception: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "Timer wheel callback unknown exception" << std::endl;
+        }
+    }
+
+    if (!pending.empty()) {
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        slot.entries.insert(slot.entries.end(),
+                            std::make_move_iterator(pending.begin()),
+                            std::make_move_iterator(pending.end()));
+    }
+}
+
+} // namespace scheduler
+} // namespace protoactor
@@ -4,6 +4,8 @@
 #include "external/actor.h"
 #include "external/context.h"
 #include "external/actor_system.h"
+#include "external/messages.h"
+#include "external/pid.h"
 #include "external/props.h"
 #include "tests/test_common.h"
 #include <atomic>
@@ -75,6 +77,53 @@ static bool test_spawn_multiple_actors() {
     return true;
 }
 
+struct Unhandled : public protoactor::SystemMessage {};
+struct Urgent : public protoactor::PriorityMessage {};
+
+// Only receives system messages, so every message can be inspected as a SystemMessage
+class SystemLaneActor : public protoactor::Actor {
+public:
+    SystemLaneActor(std::atomic<int>* urgent, std::atomic<int>* other) : urgent_(urgent), other_(other) {}
+    void Receive(std::shared_ptr<protoactor::Context> ctx) override {
+        auto message = std::static_pointer_cast<protoactor::SystemMessage>(ctx->Message());
+        if (!message || std::dynamic_pointer_cast<protoactor::Started>(message)) {
+            return;
+        }
+        if (std::dynamic_pointer_cast<Urgent>(message)) {
+            urgent_->fetch_add(1, std::memory_order_relaxed);
+        } else {
+            other_->fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+private:
+    std::atomic<int>* urgent_;
+    std::atomic<int>* other_;
+};
+
+static bool test_only_priority_system_messages_reach_receive() {
+    std::atomic<int> urgent(0);
+    std::atomic<int> other(0);
+    auto system = ActorSystem::New();
+    auto root = system->GetRoot();
+    auto pid = root->Spawn(protoactor::Props::FromProducer([&urgent, &other]() -> std::shared_ptr<protoactor::Actor> {
+        return std::make_shared<SystemLaneActor>(&urgent, &other);
+    }));
+    ASSERT_TRUE(pid != nullptr);
+    // Unknown types and malformed system messages are dropped, not handed to Receive
+    pid->SendSystemMessage(system, std::make_shared<Unhandled>());
+    pid->SendSystemMessage(system, std::make_shared<protoactor::Watch>(nullptr));
+    pid->SendSystemMessage(system, std::make_shared<protoactor::Terminated>(nullptr, protoactor::Terminated::Reason::Stopped));
+    pid->SendSystemMessage(system, std::make_shared<Urgent>());
+    for (int i = 0; i < 100 && urgent.load(std::memory_order_relaxed) < 1; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    ASSERT_EQ(urgent.load(), 1);
+    ASSERT_EQ(other.load(), 0);
+
+    system->Shutdown();
+    return true;
+}
+
 static bool test_actor_system_new_and_shutdown() {
     auto system = ActorSystem::New();
     ASSERT_TRUE(system != nullptr);
@@ -92,6 +141,7 @@ int main() {
     RUN(test_actor_system_new_and_shutdown);
     RUN(test_spawn_and_send_one_message);
     RUN(test_spawn_multiple_actors);
+    RUN(test_only_priority_system_messages_reach_receive);
 #undef RUN
     std::fprintf(stdout, "\nTotal: %d failed\n", failed);
     return failed == 0 ? 0 : 1;
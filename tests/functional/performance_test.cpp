@@ -1,5 +1,6 @@
 /**
- * Performance tests: thread pool throughput, dispatcher throughput, actor message throughput.
+ * Performance tests: thread pool throughput, dispatcher throughput, actor message throughput,
+ * remoting round trip and throughput over the in-process transport.
  * Run in Release build for meaningful numbers. Output is human-readable report.
  */
 #include "internal/thread_pool.h"
@@ -8,6 +9,8 @@
 #include "external/context.h"
 #include "external/actor_system.h"
 #include "external/props.h"
+#include "external/remote/remote.h"
+#include "external/remote/binary_serializer.h"
 #include <atomic>
 #include <chrono>
 #include <cstdio>
@@ -105,6 +108,125 @@ static void bench_actor_message_throughput() {
                  num_messages, n, sec, throughput);
 }
 
+struct RemoteBenchMsg {
+    static constexpr uint64_t MAGIC = 0x5045524642000001ULL;
+    uint64_t magic = MAGIC;
+    int64_t seq = 0;
+    double value = 0;
+    PROTOACTOR_BINARY_RAW()
+};
+PROTOACTOR_REGISTER_BINARY_MESSAGE(RemoteBenchMsg, "perf.RemoteBenchMsg")
+
+// Two actor systems in this process, connected through the full remoting pipeline
+// (EndpointWriter -> serializer -> transport -> EndpointReader) without sockets
+struct RemotePair {
+    std::shared_ptr<ActorSystem> system_a;
+    std::shared_ptr<ActorSystem> system_b;
+    std::shared_ptr<remote::Remote> remote_a;
+    std::shared_ptr<remote::Remote> remote_b;
+
+    RemotePair() {
+        auto in_process = [](std::shared_ptr<remote::Config> config) {
+            config->transport = remote::TransportKind::InProcess;
+        };
+        system_a = ActorSystem::New();
+        system_b = ActorSystem::New();
+        remote_a = remote::Remote::Start(system_a, "127.0.0.1", 0, {in_process});
+        remote_b = remote::Remote::Start(system_b, "127.0.0.1", 0, {in_process});
+    }
+
+    ~RemotePair() {
+        remote_a->Shutdown();
+        remote_b->Shutdown();
+        system_a->Shutdown();
+        system_b->Shutdown();
+    }
+};
+
+static bool wait_for(const std::atomic<int>& counter, int target, int timeout_ms) {
+    for (int wait = 0; wait < timeout_ms && counter.load(std::memory_order_relaxed) < target; ++wait) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return counter.load(std::memory_order_relaxed) >= target;
+}
+
+static void bench_remote_ping_pong() {
+    const int warmup_rounds = 100;
+    const int rounds = 5000;
+    RemotePair pair;
+    auto serializer_id = remote::BinarySerializer::SerializerID();
+    auto remote_a = pair.remote_a;
+    auto remote_b = pair.remote_b;
+
+    // Remote messages are the only ones with a sender; each side answers on the same connection pair
+    auto ponger = pair.system_b->GetRoot()->Spawn(Props::FromFunc(
+        [remote_b, serializer_id](std::shared_ptr<Context> ctx) {
+            auto sender = ctx->Sender();
+            if (!sender) return;
+            remote_b->SendMessage(sender, nullptr, ctx->Message(), ctx->Self(), serializer_id);
+        }));
+    std::atomic<int> remaining(0);
+    std::atomic<int> finished(0);
+    auto pinger = pair.system_a->GetRoot()->Spawn(Props::FromFunc(
+        [remote_a, ponger, serializer_id, &remaining, &finished](std::shared_ptr<Context> ctx) {
+            if (!ctx->Sender()) return;
+            if (remaining.fetch_sub(1, std::memory_order_relaxed) > 1) {
+                auto ball = std::make_shared<RemoteBenchMsg>();
+                ball->seq = std::static_pointer_cast<RemoteBenchMsg>(ctx->Message())->seq + 1;
+                remote_a->SendMessage(ponger, nullptr, ball, ctx->Self(), serializer_id);
+            } else {
+                finished.fetch_add(1, std::memory_order_relaxed);
+            }
+        }));
+    auto play = [&](int count) {
+        remaining.store(count);
+        int target = finished.load() + 1;
+        remote_a->SendMessage(ponger, nullptr, std::make_shared<RemoteBenchMsg>(), pinger, serializer_id);
+        return wait_for(finished, target, 10000);
+    };
+
+    // The first round also connects the endpoint
+    bool ok = play(warmup_rounds);
+    double t0 = now_sec();
+    ok = ok && play(rounds);
+    double t1 = now_sec();
+    double sec = t1 - t0;
+    double rtt_us = (ok && rounds > 0) ? (sec * 1e6 / rounds) : 0;
+    std::fprintf(stdout, "[perf] Remote ping-pong (in-process): %d rounds%s, %.3f s => %.1f us/round trip\n",
+                 rounds, ok ? "" : " (timed out)", sec, rtt_us);
+}
+
+static void bench_remote_throughput() {
+    const int num_messages = 200000;
+    RemotePair pair;
+    auto serializer_id = remote::BinarySerializer::SerializerID();
+    std::atomic<int> received(0);
+    auto target = pair.system_b->GetRoot()->Spawn(Props::FromFunc([&received](std::shared_ptr<Context> ctx) {
+        if (ctx->Sender()) received.fetch_add(1, std::memory_order_relaxed);
+    }));
+    auto sender = pair.system_a->GetRoot()->Spawn(Props::FromFunc([](std::shared_ptr<Context>) {}));
+
+    // Connect before timing
+    pair.remote_a->SendMessage(target, nullptr, std::make_shared<RemoteBenchMsg>(), sender, serializer_id);
+    wait_for(received, 1, 10000);
+    received.store(0);
+
+    double t0 = now_sec();
+    for (int i = 0; i < num_messages; ++i) {
+        auto msg = std::make_shared<RemoteBenchMsg>();
+        msg->seq = i;
+        msg->value = i * 0.5;
+        pair.remote_a->SendMessage(target, nullptr, msg, sender, serializer_id);
+    }
+    wait_for(received, num_messages, 30000);
+    double t1 = now_sec();
+    int n = received.load();
+    double sec = t1 - t0;
+    double throughput = (sec > 0 && n > 0) ? (n / sec) : 0;
+    std::fprintf(stdout, "[perf] Remote messages (in-process): %d sent, %d received, %.3f s => %.0f msg/s\n",
+                 num_messages, n, sec, throughput);
+}
+
 int main() {
     std::fprintf(stdout, "=== ProtoActor C++ performance tests ===\n");
     std::fprintf(stdout, "Build: %s\n", (sizeof(void*) == 8 ? "64-bit" : "32-bit"));
@@ -113,6 +235,8 @@ int main() {
     bench_thread_pool_throughput();
     bench_dispatcher_throughput();
     bench_actor_message_throughput();
+    bench_remote_ping_pong();
+    bench_remote_throughput();
 
     std::fprintf(stdout, "\nDone.\n");
     return 0;
@@ -0,0 +1,206 @@
+/**
+ * Unit tests for Future and the C++20 coroutine layer: Future resolution and timeout,
+ * co_await on futures, RequestAsync chains inside actors, and reentrancy while suspended.
+ */
+#include "external/coroutine.h"
+#include "external/actor.h"
+#include "external/actor_system.h"
+#include "external/context.h"
+#include "external/future.h"
+#include "external/props.h"
+#include "tests/test_common.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+using namespace protoactor;
+using namespace protoactor::test;
+
+namespace {
+
+struct TestMsg {
+    static constexpr uint64_t MAGIC = 0x434F524F54455354ULL;
+    uint64_t magic = MAGIC;
+    int kind;
+    int value;
+    TestMsg(int k, int v) : kind(k), value(v) {}
+};
+
+enum Kind { kAdd = 1, kReply = 2, kStart = 3, kPing = 4 };
+
+const TestMsg* AsTestMsg(const std::shared_ptr<void>& msg) {
+    if (!msg) {
+        return nullptr;
+    }
+    auto m = static_cast<const TestMsg*>(msg.get());
+    return m->magic == TestMsg::MAGIC ? m : nullptr;
+}
+
+bool WaitFor(const std::atomic<int>& value, int expected) {
+    for (int i = 0; i < 200; ++i) {
+        if (value.load() >= expected) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+// Responds to kAdd with value + 1
+std::shared_ptr<Props> AdderProps() {
+    return Props::FromFunc([](std::shared_ptr<Context> ctx) {
+        auto msg = AsTestMsg(ctx->Message());
+        if (msg && msg->kind == kAdd) {
+            ctx->Respond(std::make_shared<TestMsg>(kReply, msg->value + 1));
+        }
+    });
+}
+
+struct ChainState {
+    std::atomic<int> result{0};
+    std::atomic<int> pings{0};
+    std::atomic<bool> sender_restored{false};
+};
+
+// Requester: on kStart runs two chained requests without blocking the mailbox
+class RequesterActor : public Actor {
+public:
+    RequesterActor(std::shared_ptr<PID> adder, ChainState* state) : adder_(adder), state_(state) {}
+
+    void Receive(std::shared_ptr<Context> ctx) override {
+        auto msg = AsTestMsg(ctx->Message());
+        if (!msg) {
+            return;
+        }
+        if (msg->kind == kStart) {
+            Chain(ctx, msg->value);
+        } else if (msg->kind == kPing) {
+            state_->pings.fetch_add(1);
+        }
+    }
+
+private:
+    coro::Task Chain(std::shared_ptr<Context> ctx, int start) {
+        auto original = ctx->Message();
+        auto [first, err1] = co_await coro::RequestAsync<TestMsg>(
+            ctx, adder_, std::make_shared<TestMsg>(kAdd, start), std::chrono::milliseconds(2000));
+        if (err1 || !first) {
+            co_return;
+        }
+        auto [second, err2] = co_await coro::RequestAsync<TestMsg>(
+            ctx, adder_, std::make_shared<TestMsg>(kAdd, first->value), std::chrono::milliseconds(2000));
+        // Resumed on the mailbox with the original message restored, like ReenterAfter
+        state_->sender_restored.store(ctx->Message() == original);
+        if (!err2 && second) {
+            state_->result.store(second->value);
+        }
+    }
+
+    std::shared_ptr<PID> adder_;
+    ChainState* state_;
+};
+
+} // namespace
+
+static bool test_future_resolves_with_response() {
+    auto system = ActorSystem::New();
+    auto adder = system->GetRoot()->Spawn(AdderProps());
+    auto future = system->GetRoot()->RequestFuture(
+        adder, std::make_shared<TestMsg>(kAdd, 41), std::chrono::milliseconds(2000));
+    auto [res, err] = future->Result();
+    ASSERT_TRUE(!err);
+    auto reply = AsTestMsg(res);
+    ASSERT_TRUE(reply != nullptr);
+    ASSERT_EQ(reply->value, 42);
+    system->Shutdown();
+    return true;
+}
+
+static bool test_future_times_out() {
+    auto system = ActorSystem::New();
+    auto future = NewFuture(system, std::chrono::milliseconds(20));
+    auto err = future->Wait();
+    ASSERT_TRUE(err == std::make_error_code(std::errc::timed_out));
+    system->Shutdown();
+    return true;
+}
+
+static bool test_co_await_future_outside_actor() {
+    auto system = ActorSystem::New();
+    auto adder = system->GetRoot()->Spawn(AdderProps());
+    std::atomic<int> value(0);
+    auto run = [&]() -> coro::Task {
+        auto future = system->GetRoot()->RequestFuture(
+            adder, std::make_shared<TestMsg>(kAdd, 9), std::chrono::milliseconds(2000));
+        auto [res, err] = co_await future;
+        if (!err && AsTestMsg(res)) {
+            value.store(AsTestMsg(res)->value);
+        }
+    };
+    run();
+    ASSERT_TRUE(WaitFor(value, 10));
+    ASSERT_EQ(value.load(), 10);
+    system->Shutdown();
+    return true;
+}
+
+static bool test_request_async_chain_in_actor() {
+    auto system = ActorSystem::New();
+    auto root = system->GetRoot();
+    auto adder = root->Spawn(AdderProps());
+    ChainState state;
+    auto requester = root->Spawn(Props::FromProducer([adder, &state]() -> std::shared_ptr<Actor> {
+        return std::make_shared<RequesterActor>(adder, &state);
+    }));
+    root->Send(requester, std::make_shared<TestMsg>(kStart, 1));
+    for (int i = 0; i < 5; ++i) {
+        root->Send(requester, std::make_shared<TestMsg>(kPing, i));
+    }
+    ASSERT_TRUE(WaitFor(state.result, 3));
+    ASSERT_EQ(state.result.load(), 3);
+    ASSERT_TRUE(state.sender_restored.load());
+    ASSERT_TRUE(WaitFor(state.pings, 5));
+    system->Shutdown();
+    return true;
+}
+
+static bool test_request_async_timeout_reports_error() {
+    auto system = ActorSystem::New();
+    auto root = system->GetRoot();
+    auto silent = root->Spawn(Props::FromFunc([](std::shared_ptr<Context>) {}));
+    std::atomic<int> timed_out(0);
+    auto caller = root->Spawn(Props::FromFunc([silent, &timed_out](std::shared_ptr<Context> ctx) {
+        auto msg = AsTestMsg(ctx->Message());
+        if (!msg || msg->kind != kStart) {
+            return;
+        }
+        [](std::shared_ptr<Context> c, std::shared_ptr<PID> target, std::atomic<int>* out) -> coro::Task {
+            auto [res, err] = co_await coro::RequestAsync(
+                c, target, std::make_shared<TestMsg>(kAdd, 0), std::chrono::milliseconds(20));
+            if (err == std::make_error_code(std::errc::timed_out) && !res) {
+                out->store(1);
+            }
+        }(ctx, silent, &timed_out);
+    }));
+    root->Send(caller, std::make_shared<TestMsg>(kStart, 0));
+    ASSERT_TRUE(WaitFor(timed_out, 1));
+    system->Shutdown();
+    return true;
+}
+
+int main() {
+    std::fprintf(stdout, "Coroutine unit tests (module:coroutine)\n");
+    int failed = 0;
+#define RUN(name) if (!run_test(#name, name)) ++failed
+    RUN(test_future_resolves_with_response);
+    RUN(test_future_times_out);
+    RUN(test_co_await_future_outside_actor);
+    RUN(test_request_async_chain_in_actor);
+    RUN(test_request_async_timeout_reports_error);
+#undef RUN
+    std::fprintf(stdout, "\nTotal: %d failed\n", failed);
+    return failed == 0 ? 0 : 1;
+}
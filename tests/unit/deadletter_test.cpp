@@ -0,0 +1,134 @@
+/**
+ * Unit tests for dead-letter handling: throttle sampling, per-target aggregation, window
+ * reset by the system timer and concurrent recording.
+ */
+#include "internal/actor/deadletter.h"
+#include "external/actor_system.h"
+#include "external/config.h"
+#include "tests/test_common.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace protoactor;
+using namespace protoactor::test;
+
+namespace {
+
+struct Ping {
+    int value = 0;
+};
+
+bool WaitForSampled(const DeadLetterThrottle& throttle, uint64_t expected, int max_ms = 2000) {
+    for (int i = 0; i < max_ms / 5 && throttle.Sampled() < expected; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return throttle.Sampled() >= expected;
+}
+
+} // namespace
+
+static bool test_throttle_samples_first_events_of_window() {
+    DeadLetterThrottle throttle(3);
+    auto target = NewPID("node1", "missing");
+    int sampled = 0;
+    int opened = 0;
+    for (int i = 0; i < 10; ++i) {
+        bool first = false;
+        sampled += throttle.Record(target, first) ? 1 : 0;
+        opened += first ? 1 : 0;
+    }
+    ASSERT_EQ(sampled, 3);
+    ASSERT_EQ(opened, 1);
+    ASSERT_EQ(throttle.Total(), static_cast<uint64_t>(10));
+    ASSERT_EQ(throttle.Suppressed(), static_cast<uint64_t>(7));
+    return true;
+}
+
+static bool test_throttle_summary_aggregates_per_target() {
+    DeadLetterThrottle throttle(1);
+    auto a = NewPID("node1", "a");
+    auto b = NewPID("node1", "b");
+    bool first = false;
+    for (int i = 0; i < 6; ++i) {
+        throttle.Record(a, first);
+    }
+    for (int i = 0; i < 2; ++i) {
+        throttle.Record(b, first);
+    }
+    auto summary = throttle.Flush(std::chrono::milliseconds(1000));
+    ASSERT_TRUE(summary.find("throttled 7 of 8") != std::string::npos);
+    ASSERT_TRUE(summary.find("node1/a=6") != std::string::npos);
+    ASSERT_TRUE(summary.find("node1/b=2") != std::string::npos);
+    ASSERT_TRUE(summary.find("node1/a") < summary.find("node1/b"));
+    
+    // Next window starts fresh; nothing suppressed means no summary
+    ASSERT_TRUE(throttle.Record(a, first));
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(throttle.Flush(std::chrono::milliseconds(1000)).empty());
+    return true;
+}
+
+static bool test_throttle_concurrent_record_counts_exactly() {
+    DeadLetterThrottle throttle(10);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&throttle, t]() {
+            auto target = NewPID("node1", "t" + std::to_string(t));
+            bool first = false;
+            for (int i = 0; i < 5000; ++i) {
+                throttle.Record(target, first);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    ASSERT_EQ(throttle.Total(), static_cast<uint64_t>(20000));
+    ASSERT_EQ(throttle.Sampled(), static_cast<uint64_t>(10));
+    ASSERT_EQ(throttle.Suppressed(), static_cast<uint64_t>(19990));
+    ASSERT_TRUE(throttle.Flush(std::chrono::milliseconds(1)).find("=5000") != std::string::npos);
+    return true;
+}
+
+static bool test_system_honors_throttle_config() {
+    auto config = Config::Default();
+    config->dead_letter_throttle_count = 2;
+    config->dead_letter_throttle_interval = std::chrono::milliseconds(50);
+    auto system = ActorSystem::New(config);
+    auto missing = system->NewLocalPID("missing");
+    for (int i = 0; i < 100; ++i) {
+        system->GetRoot()->Send(missing, std::make_shared<Ping>());
+    }
+    auto& throttle = system->GetDeadLetter()->Throttle();
+    ASSERT_EQ(throttle.Total(), static_cast<uint64_t>(100));
+    ASSERT_EQ(throttle.Sampled(), static_cast<uint64_t>(2));
+    
+    // After the interval the timer closes the window and sampling resumes
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    for (int i = 0; i < 10; ++i) {
+        system->GetRoot()->Send(missing, std::make_shared<Ping>());
+    }
+    ASSERT_TRUE(WaitForSampled(throttle, 4));
+    ASSERT_EQ(throttle.Sampled(), static_cast<uint64_t>(4));
+    system->Shutdown();
+    return true;
+}
+
+int main() {
+    std::fprintf(stdout, "Dead letter unit tests (module:deadletter)\n");
+    int failed = 0;
+#define RUN(name) if (!run_test(#name, name)) ++failed
+    RUN(test_throttle_samples_first_events_of_window);
+    RUN(test_throttle_summary_aggregates_per_target);
+    RUN(test_throttle_concurrent_record_counts_exactly);
+    RUN(test_system_honors_throttle_config);
+#undef RUN
+    std::fprintf(stdout, "\nTotal: %d failed\n", failed);
+    return failed == 0 ? 0 : 1;
+}
@@ -1,11 +1,16 @@
 /**
- * Unit tests for EventStream module: New, Subscribe, Publish, Unsubscribe, Length.
+ * Unit tests for EventStream module: New, Subscribe, Publish, Unsubscribe, Length,
+ * typed subscriptions, copy-on-write snapshots and asynchronous subscriptions.
  */
 #include "external/eventstream.h"
+#include "external/dispatcher.h"
 #include "tests/test_common.h"
 #include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <memory>
+#include <thread>
+#include <vector>
 
 using namespace protoactor;
 using namespace protoactor::test;
@@ -53,6 +58,151 @@ static bool test_eventstream_multiple_subscribers() {
     return true;
 }
 
+namespace {
+struct EventA { int value; };
+struct EventB { int value; };
+}
+
+static bool test_eventstream_typed_subscribe() {
+    auto es = EventStream::New();
+    std::atomic<int> a_sum(0), b_count(0), all(0);
+    es->Subscribe<EventA>([&a_sum](std::shared_ptr<EventA> evt) { a_sum.fetch_add(evt->value); });
+    es->Subscribe<EventB>([&b_count](std::shared_ptr<EventB>) { b_count.fetch_add(1); });
+    es->Subscribe([&all](std::shared_ptr<void>) { all.fetch_add(1); });
+    ASSERT_EQ(es->Length(), 3);
+    es->Publish(std::make_shared<EventA>(EventA{5}));
+    es->Publish(std::make_shared<EventA>(EventA{7}));
+    es->Publish(std::make_shared<EventB>(EventB{1}));
+    ASSERT_EQ(a_sum.load(), 12);
+    ASSERT_EQ(b_count.load(), 1);
+    ASSERT_EQ(all.load(), 3);
+    // Type-erased publish only reaches untyped subscribers
+    es->Publish(std::static_pointer_cast<void>(std::make_shared<EventA>(EventA{100})));
+    ASSERT_EQ(a_sum.load(), 12);
+    ASSERT_EQ(all.load(), 4);
+    return true;
+}
+
+static bool test_eventstream_unsubscribe_typed_and_ids_stay_unique() {
+    auto es = EventStream::New();
+    std::atomic<int> first(0), second(0);
+    auto s1 = es->Subscribe<EventA>([&first](std::shared_ptr<EventA>) { first.fetch_add(1); });
+    auto s2 = es->Subscribe<EventA>([&second](std::shared_ptr<EventA>) { second.fetch_add(1); });
+    es->Unsubscribe(s1);
+    auto s3 = es->Subscribe([](std::shared_ptr<void>) {});
+    es->Publish(std::make_shared<EventA>(EventA{1}));
+    ASSERT_EQ(first.load(), 0);
+    ASSERT_EQ(second.load(), 1);
+    // Unsubscribing the later subscription must not remove the one that reused a count
+    es->Unsubscribe(s3);
+    es->Publish(std::make_shared<EventA>(EventA{1}));
+    ASSERT_EQ(second.load(), 2);
+    ASSERT_EQ(es->Length(), 1);
+    return true;
+}
+
+static bool test_eventstream_concurrent_publish_and_subscribe() {
+    auto es = EventStream::New();
+    std::atomic<int> received(0);
+    std::atomic<bool> stop(false);
+    es->Subscribe<EventA>([&received](std::shared_ptr<EventA>) { received.fetch_add(1); });
+    std::vector<std::thread> publishers;
+    for (int t = 0; t < 4; ++t) {
+        publishers.emplace_back([&es, &stop]() {
+            while (!stop.load()) {
+                es->Publish(std::make_shared<EventA>(EventA{1}));
+            }
+        });
+    }
+    for (int i = 0; i < 200; ++i) {
+        auto sub = es->Subscribe<EventB>([](std::shared_ptr<EventB>) {});
+        es->Unsubscribe(sub);
+    }
+    while (received.load() == 0) {
+        std::this_thread::yield();
+    }
+    stop.store(true);
+    for (auto& t : publishers) {
+        t.join();
+    }
+    ASSERT_TRUE(received.load() > 0);
+    ASSERT_EQ(es->Length(), 1);
+    return true;
+}
+
+static bool WaitFor(const std::atomic<int>& value, int expected, int max_ms = 2000) {
+    for (int i = 0; i < max_ms / 5 && value.load() < expected; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return value.load() >= expected;
+}
+
+static bool test_eventstream_async_delivers_in_order() {
+    auto es = EventStream::New();
+    std::atomic<int> received(0);
+    std::atomic<bool> ordered(true);
+    auto sub = es->SubscribeAsync<EventA>([&](std::shared_ptr<EventA> evt) {
+        if (evt->value != received.load()) {
+            ordered.store(false);
+        }
+        received.fetch_add(1);
+    });
+    ASSERT_TRUE(sub->IsAsync());
+    for (int i = 0; i < 500; ++i) {
+        es->Publish(std::make_shared<EventA>(EventA{i}));
+    }
+    ASSERT_TRUE(WaitFor(received, 500));
+    ASSERT_TRUE(ordered.load());
+    ASSERT_EQ(sub->Dropped(), static_cast<uint64_t>(0));
+    es->Unsubscribe(sub);
+    return true;
+}
+
+static bool test_eventstream_async_drops_when_full() {
+    auto es = EventStream::New();
+    std::atomic<bool> release(false);
+    std::atomic<int> received(0);
+    // Capacity is rounded up to a power of two (4); the first event blocks the drain
+    auto sub = es->SubscribeAsync([&](std::shared_ptr<void>) {
+        while (!release.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        received.fetch_add(1);
+    }, NewDefaultDispatcher(300), 4);
+    es->Publish(std::make_shared<EventA>(EventA{0}));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    for (int i = 1; i <= 10; ++i) {
+        es->Publish(std::make_shared<EventA>(EventA{i}));
+    }
+    ASSERT_EQ(sub->Dropped(), static_cast<uint64_t>(6));
+    release.store(true);
+    ASSERT_TRUE(WaitFor(received, 5));
+    es->Unsubscribe(sub);
+    return true;
+}
+
+static bool test_eventstream_async_does_not_block_publisher() {
+    auto es = EventStream::New();
+    auto release = std::make_shared<std::atomic<bool>>(false);
+    std::atomic<int> sync_received(0);
+    auto slow = es->SubscribeAsync([release](std::shared_ptr<void>) {
+        while (!release->load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }, nullptr, 16);
+    es->Subscribe([&sync_received](std::shared_ptr<void>) { sync_received.fetch_add(1); });
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; ++i) {
+        es->Publish(std::make_shared<EventA>(EventA{i}));
+    }
+    ASSERT_TRUE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(1000));
+    ASSERT_EQ(sync_received.load(), 1000);
+    ASSERT_TRUE(slow->Dropped() > 0);
+    release->store(true);
+    es->Unsubscribe(slow);
+    return true;
+}
+
 int main() {
     std::fprintf(stdout, "EventStream unit tests (module:eventstream)\n");
     int failed = 0;
@@ -61,6 +211,12 @@ int main() {
     RUN(test_eventstream_subscribe_publish);
     RUN(test_eventstream_unsubscribe);
     RUN(test_eventstream_multiple_subscribers);
+    RUN(test_eventstream_typed_subscribe);
+    RUN(test_eventstream_unsubscribe_typed_and_ids_stay_unique);
+    RUN(test_eventstream_concurrent_publish_and_subscribe);
+    RUN(test_eventstream_async_delivers_in_order);
+    RUN(test_eventstream_async_drops_when_full);
+    RUN(test_eventstream_async_does_not_block_publisher);
 #undef RUN
     std::fprintf(stdout, "\nTotal: %d failed\n", failed);
     return failed == 0 ? 0 : 1;
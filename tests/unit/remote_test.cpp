@@ -5,13 +5,47 @@
  * Full integration tests require gRPC and should be run separately.
  */
 #include "external/remote/remote.h"
+#include "external/remote/binary_serializer.h"
+#include "internal/actor/deadletter.h"
 #include "internal/remote/blocklist.h"
+#include "internal/remote/connection_dictionary.h"
+#include "internal/remote/endpoint_manager.h"
+#include "internal/remote/endpoint_reader.h"
+#include "internal/remote/endpoint_writer.h"
+#include "internal/remote/inprocess_transport.h"
+#include "internal/remote/lz4.h"
+#include "internal/remote/serializer.h"
+#include "internal/remote/shm_transport.h"
+#include "internal/remote/tcp_transport.h"
+#include "internal/remote/transport_service.h"
+#include "internal/remote/wire.h"
+#include "external/actor_system.h"
+#include "external/context.h"
+#include "external/dispatcher.h"
+#include "external/eventstream.h"
 #include "external/pid.h"
 #include "external/props.h"
 #include "tests/test_common.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <cstring>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <random>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 using namespace protoactor;
 using namespace protoactor::test;
@@ -175,6 +209,1906 @@ static bool test_serialization_type_json() {
     return true;
 }
 
+struct Blob {
+    std::string payload;
+};
+
+// Implements only the vector-based API
+class VectorSerializer : public remote::Serializer {
+public:
+    std::vector<uint8_t> Serialize(std::shared_ptr<void> message) override {
+        auto& payload = std::static_pointer_cast<Blob>(message)->payload;
+        return std::vector<uint8_t>(payload.begin(), payload.end());
+    }
+    std::shared_ptr<void> Deserialize(const std::string&, const std::vector<uint8_t>& bytes) override {
+        auto blob = std::make_shared<Blob>();
+        blob->payload.assign(bytes.begin(), bytes.end());
+        return blob;
+    }
+    std::string GetTypeName(std::shared_ptr<void>) override { return "test.Blob"; }
+    int32_t GetSerializerID() const override { return id; }
+    int32_t id = -1;
+};
+
+// Implements the zero-copy API and counts fallbacks to the vector-based one
+class DirectSerializer : public VectorSerializer {
+public:
+    std::vector<uint8_t> Serialize(std::shared_ptr<void> message) override {
+        ++vector_calls;
+        return VectorSerializer::Serialize(message);
+    }
+    std::size_t SerializeTo(std::shared_ptr<void> message, std::string* out) override {
+        auto& payload = std::static_pointer_cast<Blob>(message)->payload;
+        out->append(payload);
+        return payload.size();
+    }
+    std::shared_ptr<void> DeserializeFrom(const std::string&, std::string_view bytes) override {
+        auto blob = std::make_shared<Blob>();
+        blob->payload.assign(bytes.data(), bytes.size());
+        return blob;
+    }
+    int vector_calls = 0;
+};
+
+static bool test_serializer_zero_copy_falls_back_to_vector_api() {
+    auto serializer = std::make_shared<VectorSerializer>();
+    serializer->id = remote::SerializerRegistry::RegisterSerializer(serializer);
+    auto blob = std::make_shared<Blob>();
+    blob->payload = "hello";
+
+    std::string buffer = "prefix:";
+    auto type_name = remote::SerializerRegistry::SerializeTo(blob, &buffer, serializer->id);
+    ASSERT_TRUE(type_name == "test.Blob");
+    ASSERT_TRUE(buffer == "prefix:hello");
+
+    auto decoded = std::static_pointer_cast<Blob>(remote::SerializerRegistry::DeserializeFrom(
+        std::string_view(buffer).substr(7), type_name, serializer->id));
+    ASSERT_TRUE(decoded->payload == "hello");
+    return true;
+}
+
+static bool test_serializer_zero_copy_writes_into_reused_buffer() {
+    auto serializer = std::make_shared<DirectSerializer>();
+    serializer->id = remote::SerializerRegistry::RegisterSerializer(serializer);
+    auto blob = std::make_shared<Blob>();
+    blob->payload.assign(64 * 1024, 'x');
+
+    std::string buffer;
+    buffer.reserve(blob->payload.size());
+    const char* storage = buffer.data();
+    for (int i = 0; i < 3; ++i) {
+        buffer.clear();
+        remote::SerializerRegistry::SerializeTo(blob, &buffer, serializer->id);
+        ASSERT_EQ(buffer.size(), blob->payload.size());
+    }
+    // Same storage every round and the vector path is never taken
+    ASSERT_TRUE(buffer.data() == storage);
+    ASSERT_EQ(serializer->vector_calls, 0);
+
+    auto decoded = std::static_pointer_cast<Blob>(
+        remote::SerializerRegistry::DeserializeFrom(buffer, "test.Blob", serializer->id));
+    ASSERT_TRUE(decoded->payload == blob->payload);
+    return true;
+}
+
+struct Quote {
+    static constexpr uint64_t MAGIC = 0x51554F5445000001ULL;
+    uint64_t magic = MAGIC;
+    int64_t time = 0;
+    double bid = 0;
+    double ask = 0;
+    PROTOACTOR_BINARY_RAW()
+};
+PROTOACTOR_REGISTER_BINARY_MESSAGE(Quote, "test.Quote")
+
+struct Order {
+    static constexpr uint64_t MAGIC = 0x4F52444552000001ULL;
+    uint64_t magic = MAGIC;
+    int32_t qty = 0;
+    std::string symbol;
+    std::vector<double> prices;
+    std::vector<std::string> tags;
+    PROTOACTOR_BINARY_FIELDS(qty, symbol, prices, tags)
+};
+PROTOACTOR_REGISTER_BINARY_MESSAGE(Order, "test.Order")
+
+enum class Side : uint8_t { Buy = 1, Sell = 2 };
+
+struct Fill {
+    static constexpr uint64_t MAGIC = 0x46494C4C00000001ULL;
+    uint64_t magic = MAGIC;
+    bool partial = false;
+    Side side = Side::Buy;
+    std::vector<bool> flags;
+    PROTOACTOR_BINARY_FIELDS(partial, side, flags)
+};
+PROTOACTOR_REGISTER_BINARY_MESSAGE(Fill, "test.Fill")
+
+static bool test_serializer_registry_lookups_during_registration() {
+    auto id = remote::BinarySerializer::SerializerID();
+    auto quote = std::make_shared<Quote>();
+    quote->time = 7;
+
+    // The type name comes from the codec table, not a copy per message
+    std::string buffer;
+    const std::string& first = remote::SerializerRegistry::SerializeNamed(quote, &buffer, id);
+    const std::string& second = remote::SerializerRegistry::SerializeNamed(quote, &buffer, id);
+    ASSERT_TRUE(first == "test.Quote");
+    ASSERT_TRUE(&first == &second);
+
+    // Readers never block on, or miss entries because of, concurrent registration
+    std::atomic<bool> done(false);
+    std::atomic<int> failures(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&, id]() {
+            std::string out;
+            while (!done.load()) {
+                out.clear();
+                try {
+                    if (remote::SerializerRegistry::SerializeNamed(quote, &out, id) != "test.Quote" ||
+                        std::static_pointer_cast<Quote>(remote::SerializerRegistry::DeserializeFrom(
+                            out, "test.Quote", id))->time != 7) {
+                        failures.fetch_add(1);
+                    }
+                } catch (const std::exception&) {
+                    failures.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 50; ++i) {
+        auto serializer = std::make_shared<DirectSerializer>();
+        serializer->id = remote::SerializerRegistry::RegisterSerializer(serializer);
+        ASSERT_TRUE(remote::SerializerRegistry::GetSerializer(serializer->id) == serializer);
+    }
+    done.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    ASSERT_EQ(failures.load(), 0);
+    ASSERT_TRUE(remote::SerializerRegistry::GetSerializer(-1) == nullptr);
+    return true;
+}
+
+static bool test_binary_serializer_pod_round_trip() {
+    auto id = remote::BinarySerializer::SerializerID();
+    ASSERT_EQ(remote::BinarySerializer::SerializerID(), id);
+    auto quote = std::make_shared<Quote>();
+    quote->time = 42;
+    quote->bid = 1.25;
+    quote->ask = 1.5;
+
+    std::string buffer;
+    auto type_name = remote::SerializerRegistry::SerializeTo(quote, &buffer, id);
+    ASSERT_EQ(type_name, std::string("test.Quote"));
+    // No framing overhead for trivially copyable messages
+    ASSERT_EQ(buffer.size(), sizeof(Quote));
+    auto decoded = std::static_pointer_cast<Quote>(
+        remote::SerializerRegistry::DeserializeFrom(buffer, type_name, id));
+    ASSERT_EQ(decoded->time, static_cast<int64_t>(42));
+    ASSERT_EQ(decoded->bid, 1.25);
+    ASSERT_EQ(decoded->ask, 1.5);
+    return true;
+}
+
+static bool test_binary_serializer_reflected_round_trip() {
+    auto serializer = remote::BinarySerializer::Instance();
+    auto order = std::make_shared<Order>();
+    order->qty = -7;
+    order->symbol = "ACME";
+    order->prices = {1.0, 2.5, 4.0};
+    order->tags = {"limit", "", "day"};
+
+    auto bytes = serializer->Serialize(order);
+    // magic + qty + (1 + 4) + (1 + 24) + (1 + 6 + 1 + 4)
+    ASSERT_EQ(bytes.size(), static_cast<size_t>(8 + 4 + 5 + 25 + 12));
+    ASSERT_EQ(serializer->GetTypeName(order), std::string("test.Order"));
+    auto decoded = std::static_pointer_cast<Order>(serializer->Deserialize("test.Order", bytes));
+    ASSERT_EQ(decoded->qty, -7);
+    ASSERT_EQ(decoded->symbol, std::string("ACME"));
+    ASSERT_TRUE(decoded->prices == order->prices);
+    ASSERT_TRUE(decoded->tags == order->tags);
+    return true;
+}
+
+static bool test_binary_serializer_bool_and_enum_fields() {
+    auto serializer = remote::BinarySerializer::Instance();
+    auto fill = std::make_shared<Fill>();
+    fill->partial = true;
+    fill->side = Side::Sell;
+    fill->flags = {true, false, true};
+    std::string buffer;
+    serializer->SerializeTo(fill, &buffer);
+    // magic, then one byte per bool and enum, then the flags
+    ASSERT_EQ(buffer.size(), sizeof(uint64_t) + 1 + 1 + 1 + 3);
+
+    auto decoded = std::static_pointer_cast<Fill>(serializer->DeserializeFrom("test.Fill", buffer));
+    ASSERT_TRUE(decoded->partial);
+    ASSERT_TRUE(decoded->side == Side::Sell);
+    ASSERT_TRUE(decoded->flags == fill->flags);
+
+    // A bool byte other than 0 or 1 is refused instead of landing in a bool
+    std::string corrupt = buffer;
+    corrupt[sizeof(uint64_t)] = 7;
+    bool refused = false;
+    try {
+        serializer->DeserializeFrom("test.Fill", corrupt);
+    } catch (const std::runtime_error&) {
+        refused = true;
+    }
+    ASSERT_TRUE(refused);
+    return true;
+}
+
+static bool test_binary_serializer_rejects_malformed_input() {
+    auto serializer = remote::BinarySerializer::Instance();
+    auto order = std::make_shared<Order>();
+    order->symbol = "ACME";
+    order->prices = {1.0, 2.0};
+    std::string buffer;
+    serializer->SerializeTo(order, &buffer);
+
+    auto throws = [&serializer](const std::string& type_name, std::string_view bytes) {
+        try {
+            serializer->DeserializeFrom(type_name, bytes);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    ASSERT_TRUE(throws("test.Order", std::string_view(buffer).substr(0, buffer.size() - 1)));
+    ASSERT_TRUE(throws("test.Order", buffer + "x"));
+    ASSERT_TRUE(throws("test.Quote", buffer));
+    ASSERT_TRUE(throws("test.Unknown", buffer));
+
+    // Unregistered message types are refused rather than sent as garbage
+    struct Unregistered {
+        uint64_t magic = 0x554E524547000001ULL;
+    };
+    auto unregistered = std::make_shared<Unregistered>();
+    ASSERT_TRUE(!serializer->IsRegistered(unregistered));
+    ASSERT_TRUE(serializer->IsRegistered(order));
+    bool refused = false;
+    try {
+        serializer->Serialize(unregistered);
+    } catch (const std::runtime_error&) {
+        refused = true;
+    }
+    ASSERT_TRUE(refused);
+    return true;
+}
+
+// ============================================================================
+// Endpoint Writer Flush Policy Tests
+// ============================================================================
+
+static bool test_flush_policy_triggers() {
+    using Reason = remote::AdaptiveFlushPolicy::Reason;
+    remote::AdaptiveFlushPolicy policy(1000, 4096, 16);
+    // Light traffic: flush as soon as the mailbox drains
+    ASSERT_TRUE(policy.OnEnqueue(1, true) == Reason::Drained);
+    ASSERT_TRUE(policy.OnEnqueue(1, false) == Reason::None);
+    // Under load: flush at the batch limit
+    ASSERT_TRUE(policy.OnEnqueue(16, false) == Reason::BatchFull);
+    // Byte threshold once message sizes are known (1 KiB each)
+    policy.OnFlushed(4, 4096, false);
+    ASSERT_EQ(policy.AverageMessageBytes(), static_cast<size_t>(1024));
+    ASSERT_TRUE(policy.OnEnqueue(3, false) == Reason::None);
+    ASSERT_TRUE(policy.OnEnqueue(4, false) == Reason::Bytes);
+    return true;
+}
+
+static bool test_flush_policy_adapts_batch_size() {
+    remote::AdaptiveFlushPolicy policy(100, 0, 10);
+    ASSERT_EQ(policy.BatchLimit(), static_cast<size_t>(10));
+    // Backlog behind each flush: grow up to the configured maximum
+    for (int i = 0; i < 10; ++i) {
+        policy.OnFlushed(policy.BatchLimit(), 0, true);
+    }
+    ASSERT_EQ(policy.BatchLimit(), static_cast<size_t>(100));
+    // Small batches without backlog: shrink back to the minimum
+    for (int i = 0; i < 10; ++i) {
+        policy.OnFlushed(1, 0, false);
+    }
+    ASSERT_EQ(policy.BatchLimit(), static_cast<size_t>(10));
+    // Batches near the limit keep it stable
+    policy.OnFlushed(8, 0, false);
+    ASSERT_EQ(policy.BatchLimit(), static_cast<size_t>(10));
+    return true;
+}
+
+// ============================================================================
+// Endpoint Queue Tests
+// ============================================================================
+
+static bool test_endpoint_queue_bounds_depth() {
+    remote::EndpointQueue queue("peer:8090", 3);
+    ASSERT_TRUE(queue.TryAcquire());
+    ASSERT_TRUE(queue.TryAcquire());
+    ASSERT_TRUE(queue.TryAcquire());
+    ASSERT_TRUE(!queue.TryAcquire());
+    ASSERT_EQ(queue.Depth(), 3);
+    ASSERT_EQ(queue.Rejected(), static_cast<uint64_t>(1));
+    queue.Release(2);
+    ASSERT_EQ(queue.Depth(), 1);
+    ASSERT_TRUE(queue.TryAcquire());
+
+    remote::EndpointQueue unbounded("peer:8091", 0);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(unbounded.TryAcquire());
+    }
+    ASSERT_EQ(unbounded.Depth(), 1000);
+    return true;
+}
+
+static bool test_endpoint_queue_backpressure_hysteresis() {
+    remote::EndpointQueue queue("peer:8090", 4);
+    std::vector<bool> signals;
+    queue.OnBackpressure([&signals](bool active, int) { signals.push_back(active); });
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.TryAcquire());
+    }
+    ASSERT_TRUE(!queue.TryAcquire());
+    ASSERT_TRUE(!queue.TryAcquire());
+    ASSERT_TRUE(queue.Backpressured());
+    ASSERT_EQ(signals.size(), static_cast<size_t>(1));
+    // Still above half: stays backpressured
+    queue.Release(1);
+    ASSERT_TRUE(queue.Backpressured());
+    queue.Release(1);
+    ASSERT_TRUE(!queue.Backpressured());
+    ASSERT_EQ(signals.size(), static_cast<size_t>(2));
+    ASSERT_TRUE(signals[0] && !signals[1]);
+    return true;
+}
+
+// ============================================================================
+// Endpoint Reader Tests
+// ============================================================================
+
+// Polymorphic like real wire messages: the reader probes for system messages with dynamic_cast
+struct Sequenced {
+    virtual ~Sequenced() = default;
+    int32_t target = 0;
+    int32_t seq = 0;
+};
+
+class SequencedSerializer : public remote::Serializer {
+public:
+    std::vector<uint8_t> Serialize(std::shared_ptr<void> message) override {
+        auto msg = std::static_pointer_cast<Sequenced>(message);
+        std::vector<uint8_t> bytes(8);
+        std::memcpy(bytes.data(), &msg->target, 4);
+        std::memcpy(bytes.data() + 4, &msg->seq, 4);
+        return bytes;
+    }
+    std::shared_ptr<void> Deserialize(const std::string& type_name, const std::vector<uint8_t>& bytes) override {
+        return DeserializeFrom(type_name, std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+    }
+    std::shared_ptr<void> DeserializeFrom(const std::string&, std::string_view bytes) override {
+        auto msg = std::make_shared<Sequenced>();
+        std::memcpy(&msg->target, bytes.data(), 4);
+        std::memcpy(&msg->seq, bytes.data() + 4, 4);
+        return msg;
+    }
+    std::string GetTypeName(std::shared_ptr<void>) override { return "test.Sequenced"; }
+    int32_t GetSerializerID() const override { return id; }
+    int32_t id = -1;
+};
+
+static bool test_endpoint_reader_preserves_per_target_order() {
+    const int targets = 8;
+    const int per_target = 200;
+    auto serializer = std::make_shared<SequencedSerializer>();
+    serializer->id = remote::SerializerRegistry::RegisterSerializer(serializer);
+
+    auto system = ActorSystem::New();
+    auto remote_instance = remote::Remote::Start(system, "localhost", 0);
+    std::atomic<int> received(0);
+    std::atomic<int> out_of_order(0);
+    std::vector<std::shared_ptr<PID>> pids;
+    for (int t = 0; t < targets; ++t) {
+        auto last = std::make_shared<int>(-1);
+        pids.push_back(system->GetRoot()->Spawn(Props::FromFunc(
+            [last, &received, &out_of_order](std::shared_ptr<Context> ctx) {
+                // Only the delivered messages carry the remote sender
+                if (!ctx->Sender()) {
+                    return;
+                }
+                auto seq = std::static_pointer_cast<Sequenced>(ctx->Message())->seq;
+                if (seq != *last + 1) {
+                    out_of_order.fetch_add(1);
+                }
+                *last = seq;
+                received.fetch_add(1);
+            })));
+    }
+
+    auto reader = std::make_shared<remote::EndpointReader>(remote_instance, 4);
+    ASSERT_EQ(reader->Partitions(), static_cast<size_t>(4));
+    auto sender = NewPID("peer:8090", "client");
+    // Several wire batches, targets interleaved within each
+    for (int b = 0; b < 4; ++b) {
+        auto bytes = std::make_shared<std::string>();
+        auto batch = std::make_shared<remote::InboundBatch>();
+        for (int i = 0; i < per_target / 4; ++i) {
+            for (int t = 0; t < targets; ++t) {
+                Sequenced msg;
+                msg.target = t;
+                msg.seq = b * (per_target / 4) + i;
+                remote::SerializerRegistry::SerializeTo(
+                    std::shared_ptr<void>(&msg, [](void*) {}), bytes.get(), serializer->id);
+            }
+        }
+        std::size_t offset = 0;
+        for (int i = 0; i < per_target / 4; ++i) {
+            for (int t = 0; t < targets; ++t) {
+                remote::InboundEnvelope envelope;
+                envelope.data = std::string_view(*bytes).substr(offset, 8);
+                envelope.type_name = "test.Sequenced";
+                envelope.serializer_id = serializer->id;
+                envelope.target = pids[t];
+                envelope.sender = sender;
+                batch->envelopes.push_back(envelope);
+                offset += 8;
+            }
+        }
+        batch->owner = bytes;
+        reader->OnMessageBatch(batch);
+    }
+
+    for (int i = 0; i < 400 && received.load() < targets * per_target; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(received.load(), targets * per_target);
+    ASSERT_EQ(out_of_order.load(), 0);
+    ASSERT_EQ(reader->Pending(), static_cast<size_t>(0));
+    remote_instance->Shutdown();
+    system->Shutdown();
+    return true;
+}
+
+// Holds scheduled drains until the test runs them
+class ManualDispatcher : public Dispatcher {
+public:
+    void Schedule(std::function<void()> fn) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(fn));
+    }
+
+    int Throughput() const override { return 300; }
+
+    void RunAll() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (tasks_.empty()) {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::deque<std::function<void()>> tasks_;
+};
+
+static bool test_endpoint_reader_pauses_above_high_water() {
+    auto system = ActorSystem::New();
+    auto remote_instance = remote::Remote::Start(system, "localhost", 0, {[](std::shared_ptr<remote::Config> config) {
+        config->endpoint_reader_high_water = 100;
+    }});
+    auto dispatcher = std::make_shared<ManualDispatcher>();
+    auto reader = std::make_shared<remote::EndpointReader>(remote_instance, 2, dispatcher);
+    std::vector<bool> reported;
+    reader->SetFlowControl([&reported](bool paused) { reported.push_back(paused); });
+
+    auto serializer = std::make_shared<SequencedSerializer>();
+    serializer->id = remote::SerializerRegistry::RegisterSerializer(serializer);
+    auto target = system->GetRoot()->Spawn(Props::FromFunc([](std::shared_ptr<Context>) {}));
+    auto bytes = std::make_shared<std::string>(8, '\0');
+    auto push = [&](int count) {
+        auto batch = std::make_shared<remote::InboundBatch>();
+        batch->owner = bytes;
+        for (int i = 0; i < count; ++i) {
+            remote::InboundEnvelope envelope;
+            envelope.data = *bytes;
+            envelope.type_name = "test.Sequenced";
+            envelope.serializer_id = serializer->id;
+            envelope.target = target;
+            batch->envelopes.push_back(envelope);
+        }
+        reader->OnMessageBatch(batch);
+    };
+    push(60);
+    ASSERT_TRUE(!reader->Paused());
+    push(60);
+    ASSERT_TRUE(reader->Paused());
+    ASSERT_EQ(reader->Pending(), static_cast<size_t>(120));
+    // Batches that arrive while paused are still queued, and reported once
+    push(10);
+    ASSERT_EQ(reader->Pending(), static_cast<size_t>(130));
+    ASSERT_EQ(reported.size(), static_cast<size_t>(1));
+    ASSERT_TRUE(!reader->WaitWhilePaused(std::chrono::milliseconds(1)));
+
+    dispatcher->RunAll();
+    ASSERT_EQ(reader->Pending(), static_cast<size_t>(0));
+    ASSERT_TRUE(!reader->Paused());
+    ASSERT_TRUE(reader->WaitWhilePaused(std::chrono::milliseconds(1)));
+    ASSERT_EQ(reported.size(), static_cast<size_t>(2));
+    ASSERT_TRUE(reported[0] && !reported[1]);
+    remote_instance->Shutdown();
+    system->Shutdown();
+    return true;
+}
+
+// ============================================================================
+// Connection Dictionary Tests
+// ============================================================================
+
+static bool test_connection_dictionary_sends_entries_once() {
+    remote::ConnectionDictionaryEncoder encoder(1024);
+    remote::ConnectionDictionaryDecoder decoder("local:8090", 1024);
+    bool added;
+
+    // First batch introduces the entries
+    ASSERT_TRUE(!encoder.BeginBatch());
+    ASSERT_EQ(encoder.TypeName("test.Ping", &added), 0);
+    ASSERT_TRUE(added);
+    decoder.AddTypeName("test.Ping");
+    ASSERT_EQ(encoder.Target("worker", &added), 0);
+    ASSERT_TRUE(added);
+    decoder.AddTarget("worker");
+    // Equal PIDs in different objects share an id
+    auto sender_a = NewPID("peer:8090", "client");
+    auto sender_b = NewPID("peer:8090", "client");
+    ASSERT_EQ(encoder.Sender(*sender_a, &added), 1);
+    ASSERT_TRUE(added);
+    decoder.AddSender("peer:8090", "client");
+    ASSERT_EQ(encoder.Sender(*sender_b, &added), 1);
+    ASSERT_TRUE(!added);
+
+    // Later batches reference them without resending
+    ASSERT_TRUE(!encoder.BeginBatch());
+    ASSERT_EQ(encoder.TypeName("test.Ping", &added), 0);
+    ASSERT_TRUE(!added);
+    ASSERT_EQ(encoder.Target("worker", &added), 0);
+    ASSERT_TRUE(!added);
+    ASSERT_EQ(encoder.TypeName("test.Pong", &added), 1);
+    ASSERT_TRUE(added);
+    decoder.AddTypeName("test.Pong");
+
+    ASSERT_EQ(*decoder.TypeName(1), std::string("test.Pong"));
+    auto target = decoder.Target(0, 0);
+    ASSERT_EQ(target->address, std::string("local:8090"));
+    ASSERT_EQ(target->id, std::string("worker"));
+    // Entries are shared; a request id gets its own PID
+    ASSERT_TRUE(decoder.Target(0, 0) == target);
+    auto request = decoder.Sender(1, 7);
+    ASSERT_EQ(request->id, std::string("client"));
+    ASSERT_EQ(request->request_id, static_cast<uint32_t>(7));
+    ASSERT_EQ(decoder.Sender(1, 0)->request_id, static_cast<uint32_t>(0));
+    ASSERT_TRUE(decoder.Sender(0, 0) == nullptr);
+    ASSERT_TRUE(decoder.Sender(2, 0) == nullptr);
+    ASSERT_TRUE(decoder.TypeName(5) == nullptr);
+    return true;
+}
+
+static bool test_connection_dictionary_resets_when_full() {
+    remote::ConnectionDictionaryEncoder encoder(4);
+    bool added;
+    for (int i = 0; i < 4; ++i) {
+        encoder.Target("future$" + std::to_string(i), &added);
+    }
+    ASSERT_EQ(encoder.Size(), static_cast<size_t>(4));
+    ASSERT_TRUE(encoder.BeginBatch());
+    ASSERT_EQ(encoder.Size(), static_cast<size_t>(0));
+    // Ids restart after a reset
+    ASSERT_EQ(encoder.Target("future$9", &added), 0);
+    ASSERT_TRUE(added);
+    ASSERT_TRUE(!encoder.BeginBatch());
+    return true;
+}
+
+// Inbound connection that only records whether the service closed it
+class RecordingConnection : public remote::TransportConnection {
+public:
+    std::error_code Send(std::string) override { return std::error_code(); }
+    void Close() override { closed_.store(true); }
+    bool Closed() const override { return closed_.load(); }
+    void PauseReading(bool) override {}
+
+private:
+    std::atomic<bool> closed_{false};
+};
+
+static bool test_connection_dictionary_bounds_the_receiver() {
+    remote::ConnectionDictionaryDecoder decoder("local:8090", 2);
+    // A batch cannot add more entries than its envelopes reference
+    ASSERT_TRUE(decoder.Admit(3, 1));
+    ASSERT_TRUE(!decoder.Admit(4, 1));
+    for (int i = 0; i < 4; ++i) {
+        decoder.AddTarget("future$" + std::to_string(i));
+    }
+    ASSERT_TRUE(!decoder.Admit(1, 1));
+    decoder.Reset();
+    ASSERT_TRUE(decoder.Admit(1, 1));
+
+    auto system = ActorSystem::New();
+    auto remote_instance = remote::Remote::Start(system, "127.0.0.1", 0, {[](std::shared_ptr<remote::Config> config) {
+        config->transport = remote::TransportKind::InProcess;
+        config->endpoint_dictionary_size = 2;
+    }});
+    auto service = std::make_shared<remote::TransportService>(remote_instance);
+    auto handler = service->Handler();
+    auto connection = std::make_shared<RecordingConnection>();
+
+    remote::wire::ConnectRequest request;
+    request.member_id = "peer";
+    request.connection_dictionary = true;
+    auto frame = std::make_shared<std::string>();
+    remote::wire::EncodeConnectRequest(request, frame.get());
+    handler.on_frame(connection, frame);
+
+    // A peer that never resets is cut off once its dictionary passes twice the bound
+    auto send = [&](int i) {
+        auto batch = std::make_shared<std::string>();
+        remote::wire::BatchEncoder encoder(batch.get());
+        if (i == 0) {
+            encoder.TypeName("");
+        }
+        encoder.Target("future$" + std::to_string(i));
+        encoder.BeginEnvelope();
+        remote::wire::Envelope fields;
+        fields.target = i;
+        encoder.EndEnvelope(fields);
+        encoder.Finish();
+        handler.on_frame(connection, batch);
+    };
+    for (int i = 0; i < 3; ++i) {
+        send(i);
+        ASSERT_TRUE(!connection->Closed());
+    }
+    send(3);
+    ASSERT_TRUE(connection->Closed());
+    remote_instance->Shutdown();
+    system->Shutdown();
+    return true;
+}
+
+// ============================================================================
+// Transport Tests
+// ============================================================================
+
+static bool test_wire_codec_round_trip() {
+    remote::wire::ConnectRequest request;
+    request.member_id = "member-1";
+    request.address = "10.0.0.1:8090";
+    request.block_list = {"member-2", "member-3"};
+    request.connection_dictionary = true;
+    std::string frame;
+    remote::wire::EncodeConnectRequest(request, &frame);
+    remote::wire::RemoteMessage message;
+    ASSERT_TRUE(remote::wire::Decode(frame, &message));
+    ASSERT_TRUE(message.type == remote::wire::RemoteMessage::Type::ConnectRequest);
+    ASSERT_TRUE(message.connect_request.server_connection);
+    ASSERT_EQ(message.connect_request.member_id, request.member_id);
+    ASSERT_EQ(message.connect_request.address, request.address);
+    ASSERT_TRUE(message.connect_request.block_list == request.block_list);
+    ASSERT_TRUE(message.connect_request.connection_dictionary);
+
+    // Payload large enough to keep the padded length prefix
+    std::string big(5000, 'x');
+    frame.clear();
+    remote::wire::BatchEncoder encoder(&frame);
+    encoder.DictionaryReset();
+    encoder.BeginEnvelope()->append("ping");
+    remote::wire::Envelope fields;
+    fields.type_id = 0;
+    fields.target = 0;
+    fields.sender = 1;
+    fields.serializer_id = -1;
+    fields.sender_request_id = 7;
+    ASSERT_EQ(encoder.EndEnvelope(fields), static_cast<size_t>(4));
+    encoder.TypeName("test.Ping");
+    encoder.Target("worker");
+    encoder.Sender("peer:8090", "client");
+    encoder.BeginEnvelope()->append("dropped");
+    encoder.AbortEnvelope();
+    encoder.BeginEnvelope()->append(big);
+    fields = remote::wire::Envelope();
+    fields.serializer_id = 3;
+    fields.target_request_id = 9;
+    ASSERT_EQ(encoder.EndEnvelope(fields), big.size());
+    encoder.Finish();
+    ASSERT_EQ(encoder.Envelopes(), static_cast<size_t>(2));
+
+    ASSERT_TRUE(remote::wire::Decode(frame, &message));
+    ASSERT_TRUE(message.type == remote::wire::RemoteMessage::Type::MessageBatch);
+    const auto& batch = message.message_batch;
+    ASSERT_TRUE(batch.dictionary_reset);
+    ASSERT_EQ(batch.type_names.size(), static_cast<size_t>(1));
+    ASSERT_TRUE(batch.type_names[0] == "test.Ping");
+    ASSERT_TRUE(batch.targets[0] == "worker");
+    ASSERT_TRUE(batch.senders[0].address == "peer:8090");
+    ASSERT_TRUE(batch.senders[0].id == "client");
+    ASSERT_EQ(batch.envelopes.size(), static_cast<size_t>(2));
+    ASSERT_TRUE(batch.envelopes[0].message_data == "ping");
+    ASSERT_EQ(batch.envelopes[0].sender, 1);
+    ASSERT_EQ(batch.envelopes[0].serializer_id, -1);
+    ASSERT_EQ(batch.envelopes[0].sender_request_id, static_cast<uint32_t>(7));
+    ASSERT_TRUE(batch.envelopes[1].message_data == big);
+    ASSERT_EQ(batch.envelopes[1].serializer_id, 3);
+    ASSERT_EQ(batch.envelopes[1].target_request_id, static_cast<uint32_t>(9));
+
+    // Truncated input is rejected
+    ASSERT_TRUE(!remote::wire::Decode(std::string_view(frame).substr(0, frame.size() - 1), &message));
+    return true;
+}
+
+static bool test_lz4_round_trip() {
+    std::string text;
+    for (int i = 0; i < 2000; ++i) {
+        text += "quote:" + std::to_string(i % 97) + ";bid=" + std::to_string(i % 13) + ";";
+    }
+    std::string random(70000, '\0');
+    std::mt19937 gen(42);
+    for (auto& c : random) {
+        c = static_cast<char>(gen());
+    }
+    // Runs (overlapping matches), a window-sized gap, input below the match limit
+    std::vector<std::string> inputs{text, random, std::string(100000, 'a'), random + random, "", "short", "abcdabcdabcda"};
+    for (const auto& input : inputs) {
+        std::string compressed;
+        remote::lz4::Compress(input, &compressed);
+        std::string output = "prefix";
+        ASSERT_TRUE(remote::lz4::Decompress(compressed, input.size(), &output));
+        ASSERT_TRUE(output == "prefix" + input);
+    }
+
+    std::string compressed;
+    remote::lz4::Compress(text, &compressed);
+    ASSERT_TRUE(compressed.size() * 2 < text.size());
+
+    // Truncated blocks and wrong sizes are rejected and leave the output unchanged
+    std::string output = "kept";
+    ASSERT_TRUE(!remote::lz4::Decompress(std::string_view(compressed).substr(0, compressed.size() - 1), text.size(), &output));
+    ASSERT_TRUE(!remote::lz4::Decompress(compressed, text.size() - 1, &output));
+    ASSERT_TRUE(!remote::lz4::Decompress(compressed, text.size() + 1, &output));
+    // A match reaching before the start of the output
+    ASSERT_TRUE(!remote::lz4::Decompress(std::string("\x10" "a" "\x05\x00", 4), 5, &output));
+    ASSERT_TRUE(output == "kept");
+    return true;
+}
+
+static bool test_wire_batch_compression_round_trip() {
+    // Negotiation fields, and the fallback for codecs a peer does not know
+    remote::wire::ConnectRequest request;
+    request.compression = remote::wire::kCompressionLz4;
+    std::string frame;
+    remote::wire::EncodeConnectRequest(request, &frame);
+    remote::wire::RemoteMessage message;
+    ASSERT_TRUE(remote::wire::Decode(frame, &message));
+    ASSERT_EQ(message.connect_request.compression, remote::wire::kCompressionLz4);
+    remote::wire::ConnectResponse response;
+    response.compression = remote::wire::NegotiateCompression(message.connect_request.compression);
+    frame.clear();
+    remote::wire::EncodeConnectResponse(response, &frame);
+    ASSERT_TRUE(remote::wire::Decode(frame, &message));
+    ASSERT_EQ(message.connect_response.compression, remote::wire::kCompressionLz4);
+    ASSERT_EQ(remote::wire::NegotiateCompression(7), remote::wire::kCompressionNone);
+
+    frame.clear();
+    remote::wire::BatchEncoder encoder(&frame);
+    for (int i = 0; i < 50; ++i) {
+        encoder.BeginEnvelope()->append("{\"symbol\":\"ACME\",\"seq\":" + std::to_string(i) + ",\"side\":\"buy\"}");
+        remote::wire::Envelope fields;
+        fields.serializer_id = 1;
+        encoder.EndEnvelope(fields);
+    }
+    encoder.TypeName("test.Json");
+    encoder.Target("worker");
+    encoder.Finish();
+
+    std::string compressed;
+    ASSERT_TRUE(!remote::wire::CompressBatch(frame, remote::wire::kCompressionNone, &compressed));
+    ASSERT_TRUE(remote::wire::CompressBatch(frame, remote::wire::kCompressionLz4, &compressed));
+    ASSERT_TRUE(compressed.size() * 2 < frame.size());
+    ASSERT_TRUE(remote::wire::Decode(compressed, &message));
+    ASSERT_TRUE(message.type == remote::wire::RemoteMessage::Type::MessageBatch);
+    ASSERT_EQ(message.message_batch.compression, remote::wire::kCompressionLz4);
+    ASSERT_TRUE(message.message_batch.envelopes.empty());
+
+    std::string body;
+    remote::wire::MessageBatch batch;
+    ASSERT_TRUE(remote::wire::DecompressBatch(message.message_batch, &body, &batch));
+    ASSERT_EQ(batch.envelopes.size(), static_cast<size_t>(50));
+    ASSERT_TRUE(batch.envelopes[49].message_data == "{\"symbol\":\"ACME\",\"seq\":49,\"side\":\"buy\"}");
+    ASSERT_EQ(batch.envelopes[49].serializer_id, 1);
+    ASSERT_TRUE(batch.type_names[0] == "test.Json");
+    ASSERT_TRUE(batch.targets[0] == "worker");
+
+    // A size claim the block cannot hold is rejected before decompressing
+    auto inflated = message.message_batch;
+    inflated.uncompressed_size = inflated.compressed.size() * 1000;
+    ASSERT_TRUE(!remote::wire::DecompressBatch(inflated, &body, &batch));
+
+    // Incompressible batches stay as they are
+    std::string noise(4096, '\0');
+    std::mt19937 gen(7);
+    for (auto& c : noise) {
+        c = static_cast<char>(gen());
+    }
+    frame.clear();
+    remote::wire::BatchEncoder raw(&frame);
+    raw.BeginEnvelope()->append(noise);
+    raw.EndEnvelope(remote::wire::Envelope());
+    raw.Finish();
+    compressed = "unchanged";
+    ASSERT_TRUE(!remote::wire::CompressBatch(frame, remote::wire::kCompressionLz4, &compressed));
+    ASSERT_TRUE(compressed == "unchanged");
+    return true;
+}
+
+static bool test_tcp_transport_frames_round_trip() {
+    auto server = std::make_shared<remote::TcpTransport>(2);
+    remote::TransportHandler echo;
+    echo.on_frame = [](const std::shared_ptr<remote::TransportConnection>& connection,
+                       std::shared_ptr<std::string> frame) {
+        connection->Send(*frame);
+    };
+    ASSERT_TRUE(!server->Listen("127.0.0.1:0", echo));
+    auto address = server->ListenAddress();
+    ASSERT_TRUE(address.find("127.0.0.1:") == 0);
+    ASSERT_TRUE(address != "127.0.0.1:0");
+
+    std::mutex mutex;
+    std::vector<std::string> received;
+    std::atomic<bool> closed(false);
+    remote::TransportHandler collect;
+    collect.on_frame = [&](const std::shared_ptr<remote::TransportConnection>&, std::shared_ptr<std::string> frame) {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.push_back(std::move(*frame));
+    };
+    collect.on_close = [&](const std::shared_ptr<remote::TransportConnection>&) {
+        closed.store(true);
+    };
+    auto client = std::make_shared<remote::TcpTransport>(1);
+    auto connected = client->Connect(address, collect);
+    ASSERT_TRUE(!connected.second);
+
+    // Small frames, an empty one, and one larger than the read buffer, all in order
+    std::vector<std::string> sent;
+    for (int i = 0; i < 500; ++i) {
+        sent.push_back("frame-" + std::to_string(i));
+    }
+    sent.push_back("");
+    sent.push_back(std::string(300 * 1024, 'z'));
+    sent.push_back("last");
+    for (const auto& frame : sent) {
+        ASSERT_TRUE(!connected.first->Send(frame));
+    }
+    for (int i = 0; i < 400; ++i) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (received.size() == sent.size()) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ASSERT_TRUE(received == sent);
+    }
+
+    server->Stop();
+    for (int i = 0; i < 400 && !closed.load(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_TRUE(closed.load());
+    ASSERT_TRUE(connected.first->Closed());
+    ASSERT_TRUE(connected.first->Send("after close") == std::make_error_code(std::errc::not_connected));
+    client->Stop();
+    return true;
+}
+
+static bool test_tcp_transport_connect_failure_closes() {
+    // A port nobody listens on any more
+    auto probe = std::make_shared<remote::TcpTransport>(1);
+    ASSERT_TRUE(!probe->Listen("127.0.0.1:0", remote::TransportHandler()));
+    auto address = probe->ListenAddress();
+    probe->Stop();
+
+    std::atomic<bool> closed(false);
+    remote::TransportHandler handler;
+    handler.on_close = [&closed](const std::shared_ptr<remote::TransportConnection>&) {
+        closed.store(true);
+    };
+    auto client = std::make_shared<remote::TcpTransport>(1);
+    auto start = std::chrono::steady_clock::now();
+    auto connected = client->Connect(address, handler);
+    ASSERT_TRUE(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+    if (!connected.second) {
+        // Refused after Connect returned: reported through on_close
+        ASSERT_TRUE(!connected.first->Send("queued while connecting"));
+        for (int i = 0; i < 400 && !closed.load(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        ASSERT_TRUE(closed.load());
+        ASSERT_TRUE(connected.first->Closed());
+    }
+    client->Stop();
+    return true;
+}
+
+static bool test_tcp_transport_pause_reading() {
+    // The server pauses on the first frame; the rest waits in the socket until resumed
+    std::shared_ptr<remote::TransportConnection> accepted;
+    std::mutex mutex;
+    std::vector<std::string> received;
+    auto server = std::make_shared<remote::TcpTransport>(1);
+    remote::TransportHandler collect;
+    collect.on_frame = [&](const std::shared_ptr<remote::TransportConnection>& connection,
+                           std::shared_ptr<std::string> frame) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!accepted) {
+            accepted = connection;
+            connection->PauseReading(true);
+        }
+        received.push_back(std::move(*frame));
+    };
+    ASSERT_TRUE(!server->Listen("127.0.0.1:0", collect));
+    auto client = std::make_shared<remote::TcpTransport>(1);
+    auto connected = client->Connect(server->ListenAddress(), remote::TransportHandler());
+    ASSERT_TRUE(!connected.second);
+
+    const std::size_t frames = 200;
+    for (std::size_t i = 0; i < frames; ++i) {
+        ASSERT_TRUE(!connected.first->Send(std::to_string(i) + std::string(32 * 1024, 'p')));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::size_t while_paused;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Only what was already read in the chunk holding the first frame
+        while_paused = received.size();
+        ASSERT_TRUE(while_paused >= 1 && while_paused < 10);
+        accepted->PauseReading(false);
+    }
+    for (int i = 0; i < 400; ++i) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (received.size() == frames) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ASSERT_EQ(received.size(), frames);
+        for (std::size_t i = 0; i < frames; ++i) {
+            ASSERT_TRUE(received[i].compare(0, std::to_string(i).size(), std::to_string(i)) == 0);
+        }
+    }
+    client->Stop();
+    server->Stop();
+    return true;
+}
+
+static bool test_shm_transport_frames_round_trip() {
+    // Rendezvous is keyed by port only; keep concurrent test runs apart
+    auto address = "127.0.0.1:" + std::to_string(20000 + getpid() % 40000);
+    auto server = std::make_shared<remote::ShmTransport>(16 * 1024);
+    remote::TransportHandler echo;
+    echo.on_frame = [](const std::shared_ptr<remote::TransportConnection>& connection,
+                       std::shared_ptr<std::string> frame) {
+        connection->Send(*frame);
+    };
+    ASSERT_TRUE(!server->Listen(address, echo));
+    ASSERT_TRUE(remote::ShmTransport::IsLocalAddress(address));
+    ASSERT_TRUE(remote::ShmTransport::IsLocalAddress("localhost:8090"));
+    ASSERT_TRUE(!remote::ShmTransport::IsLocalAddress("192.0.2.1:8090"));
+
+    std::mutex mutex;
+    std::vector<std::string> received;
+    std::atomic<bool> closed(false);
+    remote::TransportHandler collect;
+    collect.on_frame = [&](const std::shared_ptr<remote::TransportConnection>&, std::shared_ptr<std::string> frame) {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.push_back(std::move(*frame));
+    };
+    collect.on_close = [&](const std::shared_ptr<remote::TransportConnection>&) {
+        closed.store(true);
+    };
+    auto client = std::make_shared<remote::ShmTransport>(16 * 1024);
+    ASSERT_TRUE(client->Connect("127.0.0.1:1", collect).second == std::make_error_code(std::errc::connection_refused));
+    ASSERT_TRUE(client->Connect("192.0.2.1:8090", collect).second == std::make_error_code(std::errc::host_unreachable));
+    auto connected = client->Connect(address, collect);
+    ASSERT_TRUE(!connected.second);
+
+    // Many times the ring size in flight: exercises wrap-around, fragmentation and waiting for space
+    std::vector<std::string> sent;
+    for (int i = 0; i < 2000; ++i) {
+        sent.push_back("frame-" + std::to_string(i));
+    }
+    sent.push_back("");
+    sent.push_back(std::string(300 * 1024, 'z'));
+    sent.push_back("last");
+    for (const auto& frame : sent) {
+        ASSERT_TRUE(!connected.first->Send(frame));
+    }
+    for (int i = 0; i < 400; ++i) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (received.size() == sent.size()) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ASSERT_TRUE(received == sent);
+    }
+    ASSERT_EQ(server->Connections(), static_cast<size_t>(1));
+
+    server->Stop();
+    for (int i = 0; i < 400 && !closed.load(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_TRUE(closed.load());
+    ASSERT_EQ(client->Connections(), static_cast<size_t>(0));
+    ASSERT_TRUE(connected.first->Send("after close") == std::make_error_code(std::errc::not_connected));
+    client->Stop();
+    return true;
+}
+
+// Connects to the rendezvous socket of a shared-memory listener without sending a hello
+static int connect_shm_rendezvous(int port) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::string name = "protoactor-shm:" + std::to_string(port);
+    std::memcpy(addr.sun_path + 1, name.data(), name.size());
+    auto length = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1 + name.size());
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), length) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Whether the peer closed the socket within timeout_ms
+static bool peer_closed(int fd, int timeout_ms) {
+    pollfd waiter{fd, POLLIN, 0};
+    char byte;
+    return ::poll(&waiter, 1, timeout_ms) == 1 && ::recv(fd, &byte, 1, MSG_DONTWAIT) == 0;
+}
+
+static int open_fds() {
+    int count = 0;
+    if (DIR* dir = ::opendir("/proc/self/fd")) {
+        while (::readdir(dir)) {
+            ++count;
+        }
+        ::closedir(dir);
+    }
+    return count;
+}
+
+static bool test_shm_transport_accept_does_not_wait_for_hello() {
+    int port = 20000 + (getpid() + 1) % 40000;
+    auto address = "127.0.0.1:" + std::to_string(port);
+    auto server = std::make_shared<remote::ShmTransport>(16 * 1024);
+    remote::TransportHandler echo;
+    echo.on_frame = [](const std::shared_ptr<remote::TransportConnection>& connection,
+                       std::shared_ptr<std::string> frame) {
+        connection->Send(*frame);
+    };
+    ASSERT_TRUE(!server->Listen(address, echo));
+
+    // A hello carrying more descriptors than expected is rejected, and all of them are closed
+    int before = open_fds();
+    int noisy = connect_shm_rendezvous(port);
+    ASSERT_TRUE(noisy >= 0);
+    int extra[7];
+    for (auto& fd : extra) {
+        fd = eventfd(0, EFD_CLOEXEC);
+    }
+    char hello[16] = {0};
+    iovec iov{hello, sizeof(hello)};
+    std::vector<char> control(CMSG_SPACE(sizeof(extra)));
+    msghdr message{};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control.data();
+    message.msg_controllen = control.size();
+    auto* cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(extra));
+    std::memcpy(CMSG_DATA(cmsg), extra, sizeof(extra));
+    ASSERT_EQ(::sendmsg(noisy, &message, MSG_NOSIGNAL), static_cast<ssize_t>(sizeof(hello)));
+    for (auto fd : extra) {
+        ::close(fd);
+    }
+    ASSERT_TRUE(peer_closed(noisy, 2000));
+    ::close(noisy);
+    ASSERT_EQ(open_fds(), before);
+
+    // A client that stays silent does not hold up the next one
+    int silent = connect_shm_rendezvous(port);
+    ASSERT_TRUE(silent >= 0);
+    std::atomic<int> echoed(0);
+    remote::TransportHandler collect;
+    collect.on_frame = [&](const std::shared_ptr<remote::TransportConnection>&, std::shared_ptr<std::string>) {
+        echoed.fetch_add(1);
+    };
+    auto client = std::make_shared<remote::ShmTransport>(16 * 1024);
+    auto start = std::chrono::steady_clock::now();
+    auto connected = client->Connect(address, collect);
+    ASSERT_TRUE(!connected.second);
+    ASSERT_TRUE(!connected.first->Send("ping"));
+    for (int i = 0; i < 400 && echoed.load() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(echoed.load(), 1);
+    ASSERT_TRUE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(500));
+    ASSERT_EQ(server->Connections(), static_cast<size_t>(1));
+
+    // ...and is dropped once the hello timeout passes
+    ASSERT_TRUE(peer_closed(silent, 3000));
+    ::close(silent);
+    client->Stop();
+    server->Stop();
+    return true;
+}
+
+// Sends quotes from one system to an actor of another; reports whether shared memory carried them
+static bool deliver_between_systems(remote::TransportKind kind, bool shared_memory, bool* used_shared_memory,
+                                    remote::BatchCompression compression = remote::BatchCompression::None) {
+    auto use_transport = [kind, shared_memory, compression](std::shared_ptr<remote::Config> config) {
+        config->transport = kind;
+        config->shared_memory_transport = shared_memory;
+        config->endpoint_compression = compression;
+        config->endpoint_compression_threshold = 256;
+    };
+    auto system_a = ActorSystem::New();
+    auto system_b = ActorSystem::New();
+    auto remote_a = remote::Remote::Start(system_a, "127.0.0.1", 0, {use_transport});
+    auto remote_b = remote::Remote::Start(system_b, "127.0.0.1", 0, {use_transport});
+    ASSERT_TRUE(remote_a->GetTransport() != nullptr);
+    ASSERT_TRUE(remote_b->GetConfig()->port != 0);
+    ASSERT_EQ(system_b->Address(), remote_b->GetConfig()->Address());
+
+    const int count = 1000;
+    std::atomic<int> received(0);
+    std::atomic<int> out_of_order(0);
+    std::atomic<bool> sender_ok(true);
+    auto last = std::make_shared<int64_t>(-1);
+    auto sender_address = system_a->Address();
+    auto target = system_b->GetRoot()->Spawn(Props::FromFunc(
+        [&, last](std::shared_ptr<Context> ctx) {
+            // Only the remote messages carry a sender
+            auto sender = ctx->Sender();
+            if (!sender) {
+                return;
+            }
+            if (sender->address != sender_address) {
+                sender_ok.store(false);
+            }
+            auto quote = std::static_pointer_cast<Quote>(ctx->Message());
+            if (quote->time != *last + 1 || quote->bid != quote->time * 0.5) {
+                out_of_order.fetch_add(1);
+            }
+            *last = quote->time;
+            received.fetch_add(1);
+        }));
+    ASSERT_EQ(target->address, system_b->Address());
+
+    auto sender = system_a->GetRoot()->Spawn(Props::FromFunc([](std::shared_ptr<Context>) {}));
+    for (int i = 0; i < count; ++i) {
+        auto quote = std::make_shared<Quote>();
+        quote->time = i;
+        quote->bid = i * 0.5;
+        ASSERT_TRUE(!remote_a->SendMessage(target, nullptr, quote, sender, remote::BinarySerializer::SerializerID()));
+    }
+    for (int i = 0; i < 1000 && received.load() < count; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(received.load(), count);
+    ASSERT_EQ(out_of_order.load(), 0);
+    ASSERT_TRUE(sender_ok.load());
+    auto shm = std::static_pointer_cast<remote::ShmTransport>(remote_a->GetSharedMemoryTransport());
+    *used_shared_memory = shm && shm->Connections() > 0;
+
+    remote_a->Shutdown();
+    remote_b->Shutdown();
+    system_a->Shutdown();
+    system_b->Shutdown();
+    return true;
+}
+
+static bool test_tcp_remote_delivers_between_systems() {
+    bool used_shared_memory = true;
+    ASSERT_TRUE(deliver_between_systems(remote::TransportKind::Tcp, false, &used_shared_memory));
+    ASSERT_TRUE(!used_shared_memory);
+    return true;
+}
+
+static bool test_shm_remote_selected_for_same_host_peer() {
+    bool used_shared_memory = false;
+    ASSERT_TRUE(deliver_between_systems(remote::TransportKind::Tcp, true, &used_shared_memory));
+    ASSERT_TRUE(used_shared_memory);
+    return true;
+}
+
+static bool test_inprocess_remote_delivers_between_systems() {
+    // Shared memory only applies to Tcp; the in-process listener takes a synthetic port
+    bool used_shared_memory = true;
+    ASSERT_TRUE(deliver_between_systems(remote::TransportKind::InProcess, true, &used_shared_memory));
+    ASSERT_TRUE(!used_shared_memory);
+    return true;
+}
+
+static bool test_compressed_batches_deliver_between_systems() {
+    bool used_shared_memory = false;
+    ASSERT_TRUE(deliver_between_systems(remote::TransportKind::InProcess, false, &used_shared_memory,
+                                        remote::BatchCompression::Lz4));
+    ASSERT_TRUE(deliver_between_systems(remote::TransportKind::Tcp, false, &used_shared_memory,
+                                        remote::BatchCompression::Lz4));
+    return true;
+}
+
+static bool test_endpoint_writer_for_target_is_stable() {
+    remote::Endpoint endpoint;
+    ASSERT_TRUE(endpoint.WriterFor(*NewPID("host:1", "a")) == nullptr);
+    for (int i = 0; i < 4; ++i) {
+        endpoint.writers.push_back(NewPID("local", "writer-" + std::to_string(i)));
+    }
+    std::vector<int> used(4, 0);
+    for (int i = 0; i < 64; ++i) {
+        auto target = NewPID("host:1", "actor-" + std::to_string(i));
+        auto writer = endpoint.WriterFor(*target);
+        ASSERT_TRUE(writer != nullptr);
+        ASSERT_TRUE(endpoint.WriterFor(*NewPID("host:1", target->id)) == writer);
+        used[std::stoi(writer->id.substr(7))]++;
+    }
+    for (int count : used) {
+        ASSERT_TRUE(count > 0);
+    }
+    return true;
+}
+
+static bool test_striped_endpoint_keeps_per_target_order() {
+    auto striped = [](std::shared_ptr<remote::Config> config) {
+        config->transport = remote::TransportKind::InProcess;
+        config->endpoint_writer_stripes = 4;
+    };
+    auto system_a = ActorSystem::New();
+    auto system_b = ActorSystem::New();
+    auto remote_a = remote::Remote::Start(system_a, "127.0.0.1", 0, {striped});
+    auto remote_b = remote::Remote::Start(system_b, "127.0.0.1", 0, {striped});
+
+    const int targets = 8;
+    const int per_target = 250;
+    std::atomic<int> received(0);
+    std::atomic<int> out_of_order(0);
+    std::vector<std::shared_ptr<PID>> pids;
+    for (int t = 0; t < targets; ++t) {
+        auto last = std::make_shared<int64_t>(-1);
+        pids.push_back(system_b->GetRoot()->Spawn(Props::FromFunc(
+            [&received, &out_of_order, last](std::shared_ptr<Context> ctx) {
+                if (!ctx->Sender()) {
+                    return;
+                }
+                auto quote = std::static_pointer_cast<Quote>(ctx->Message());
+                if (quote->time != *last + 1) {
+                    out_of_order.fetch_add(1);
+                }
+                *last = quote->time;
+                received.fetch_add(1);
+            })));
+    }
+    auto sender = system_a->GetRoot()->Spawn(Props::FromFunc([](std::shared_ptr<Context>) {}));
+    for (int i = 0; i < per_target; ++i) {
+        for (const auto& target : pids) {
+            auto quote = std::make_shared<Quote>();
+            quote->time = i;
+            ASSERT_TRUE(!remote_a->SendMessage(target, nullptr, quote, sender, remote::BinarySerializer::SerializerID()));
+        }
+    }
+    for (int i = 0; i < 1000 && received.load() < targets * per_target; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(received.load(), targets * per_target);
+    ASSERT_EQ(out_of_order.load(), 0);
+    // One accepted connection per stripe
+    auto accepted = std::static_pointer_cast<remote::InProcessTransport>(remote_b->GetTransport());
+    ASSERT_EQ(accepted->Connections(), static_cast<size_t>(4));
+
+    remote_a->Shutdown();
+    remote_b->Shutdown();
+    system_a->Shutdown();
+    system_b->Shutdown();
+    return true;
+}
+
+static bool test_striped_endpoint_reconnects_after_stripe_drop() {
+    auto striped = [](std::shared_ptr<remote::Config> config) {
+        config->transport = remote::TransportKind::InProcess;
+        config->endpoint_writer_stripes = 2;
+    };
+    auto system_a = ActorSystem::New();
+    auto system_b = ActorSystem::New();
+    auto remote_a = remote::Remote::Start(system_a, "127.0.0.1", 0, {striped});
+    auto remote_b = remote::Remote::Start(system_b, "127.0.0.1", 0, {striped});
+    auto accepted = std::static_pointer_cast<remote::InProcessTransport>(remote_b->GetTransport());
+
+    std::atomic<int> received(0);
+    auto target = system_b->GetRoot()->Spawn(Props::FromFunc([&received](std::shared_ptr<Context> ctx) {
+        if (ctx->Sender()) {
+            received.fetch_add(1);
+        }
+    }));
+    auto sender = system_a->GetRoot()->Spawn(Props::FromFunc([](std::shared_ptr<Context>) {}));
+    auto send_and_wait = [&]() {
+        int expected = received.load() + 1;
+        if (remote_a->SendMessage(target, nullptr, std::make_shared<Quote>(), sender,
+                                  remote::BinarySerializer::SerializerID())) {
+            return false;
+        }
+        for (int i = 0; i < 400 && received.load() < expected; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return received.load() == expected;
+    };
+    ASSERT_TRUE(send_and_wait());
+    for (int i = 0; i < 400 && accepted->Connections() < 2; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(accepted->Connections(), static_cast<size_t>(2));
+
+    auto manager = remote_a->GetEndpointManager();
+    auto first = manager->EnsureConnected(target->address);
+    ASSERT_EQ(first->writers.size(), static_cast<size_t>(2));
+    auto dropped = first->writers[0];
+    auto closed = first->writers[1];
+    std::atomic<int> closed_events(0);
+    auto sub = system_a->GetEventStream()->Subscribe<remote::EndpointTerminatedEvent>(
+        [&closed_events, closed](std::shared_ptr<remote::EndpointTerminatedEvent> event) {
+            if (event->Writer && event->Writer->id == closed->id) {
+                closed_events.fetch_add(1);
+            }
+        });
+
+    // A stripe that closes its own connection (as it does when stopping) does not report it
+    // as lost, so nothing tears the endpoint down
+    system_a->GetRoot()->Send(closed, std::make_shared<Stopping>());
+    for (int i = 0; i < 400 && accepted->Connections() > 1; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(accepted->Connections(), static_cast<size_t>(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(closed_events.load(), 0);
+    ASSERT_TRUE(manager->EnsureConnected(target->address) == first);
+
+    // The other stripe loses its connection and takes its endpoint down (what the writer does
+    // on EndpointTerminatedEvent); the next send builds a new endpoint
+    manager->RemoveEndpoint(target->address, dropped);
+    ASSERT_TRUE(send_and_wait());
+    auto second = manager->EnsureConnected(target->address);
+    ASSERT_TRUE(second != first);
+    // A late report from a stripe of the replaced endpoint leaves the new one alone
+    manager->RemoveEndpoint(target->address, closed);
+    ASSERT_TRUE(manager->EnsureConnected(target->address) == second);
+    ASSERT_TRUE(send_and_wait());
+
+    system_a->GetEventStream()->Unsubscribe(sub);
+    remote_a->Shutdown();
+    remote_b->Shutdown();
+    system_a->Shutdown();
+    system_b->Shutdown();
+    return true;
+}
+
+static bool test_reconnect_backoff_doubles_with_jitter() {
+    remote::ReconnectBackoff backoff(std::chrono::milliseconds(100), std::chrono::milliseconds(1000));
+    ASSERT_EQ(backoff.Delay(1, 0.0).count(), 50);
+    ASSERT_EQ(backoff.Delay(1, 1.0).count(), 100);
+    ASSERT_EQ(backoff.Delay(2, 0.0).count(), 100);
+    ASSERT_EQ(backoff.Delay(3, 0.5).count(), 300);
+    // Capped at the maximum, also for retry counts that would overflow
+    ASSERT_EQ(backoff.Delay(5, 0.0).count(), 500);
+    ASSERT_EQ(backoff.Delay(5, 1.0).count(), 1000);
+    ASSERT_EQ(backoff.Delay(1000, 1.0).count(), 1000);
+    return true;
+}
+
+static bool test_unreachable_endpoint_gives_up_without_blocking() {
+    auto fast_retry = [](std::shared_ptr<remote::Config> config) {
+        config->transport = remote::TransportKind::InProcess;
+        config->max_retry_count = 4;
+        config->endpoint_connect_backoff = std::chrono::milliseconds(10);
+        config->endpoint_connect_backoff_max = std::chrono::milliseconds(20);
+    };
+    auto system = ActorSystem::New();
+    auto remote_a = remote::Remote::Start(system, "127.0.0.1", 0, {fast_retry});
+    const std::string nowhere = "127.0.0.1:65001";
+
+    std::atomic<int> terminated(0);
+    std::atomic<int> dead_letters(0);
+    auto events = system->GetEventStream();
+    auto terminated_sub = events->Subscribe<remote::EndpointTerminatedEvent>(
+        [&terminated, nowhere](std::shared_ptr<remote::EndpointTerminatedEvent> event) {
+            if (event->Address == nowhere) {
+                terminated.fetch_add(1);
+            }
+        });
+    auto dead_letter_sub = events->Subscribe<DeadLetterEvent>(
+        [&dead_letters, nowhere](std::shared_ptr<DeadLetterEvent> event) {
+            if (event->pid && event->pid->address == nowhere) {
+                dead_letters.fetch_add(1);
+            }
+        });
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; ++i) {
+        auto quote = std::make_shared<Quote>();
+        quote->time = i;
+        remote_a->SendMessage(NewPID(nowhere, "target"), nullptr, quote, nullptr, remote::BinarySerializer::SerializerID());
+    }
+    // Local actors keep running while the writer waits between attempts
+    std::atomic<int> pongs(0);
+    auto ping = std::make_shared<Quote>();
+    auto local = system->GetRoot()->Spawn(Props::FromFunc([&pongs, ping](std::shared_ptr<Context> ctx) {
+        if (ctx->Message() == ping) {
+            pongs.fetch_add(1);
+        }
+    }));
+    system->GetRoot()->Send(local, ping);
+    for (int i = 0; i < 400 && (terminated.load() == 0 || dead_letters.load() < 10); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_EQ(terminated.load(), 1);
+    ASSERT_EQ(dead_letters.load(), 10);
+    ASSERT_EQ(pongs.load(), 1);
+    // Three backoffs of at most 20 ms each, rather than seconds of sleeping
+    ASSERT_TRUE(elapsed < std::chrono::seconds(1));
+    ASSERT_EQ(remote_a->GetEndpointManager()->QueueDepth(nowhere), 0);
+
+    events->Unsubscribe(terminated_sub);
+    events->Unsubscribe(dead_letter_sub);
+    remote_a->Shutdown();
+    system->Shutdown();
+    return true;
+}
+
+static bool test_endpoint_buffers_until_peer_listens() {
+    auto patient = [](std::shared_ptr<remote::Config> config) {
+        config->transport = remote::TransportKind::InProcess;
+        config->max_retry_count = 100;
+        config->endpoint_connect_backoff = std::chrono::milliseconds(5);
+        config->endpoint_connect_backoff_max = std::chrono::milliseconds(20);
+    };
+    auto system_a = ActorSystem::New();
+    auto system_b = ActorSystem::New();
+    auto remote_a = remote::Remote::Start(system_a, "127.0.0.1", 0, {patient});
+    const std::string late_address = "127.0.0.1:65002";
+
+    auto sender = system_a->GetRoot()->Spawn(Props::FromFunc([](std::shared_ptr<Context>) {}));
+    auto target = NewPID(late_address, "late-target");
+    for (int i = 0; i < 20; ++i) {
+        auto quote = std::make_shared<Quote>();
+        quote->time = i;
+        ASSERT_TRUE(!remote_a->SendMessage(target, nullptr, quote, sender, remote::BinarySerializer::SerializerID()));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(remote_a->GetEndpointManager()->QueueDepth(late_address), 20);
+
+    std::atomic<int> received(0);
+    std::atomic<int> out_of_order(0);
+    auto last = std::make_shared<int64_t>(-1);
+    auto remote_b = remote::Remote::Start(system_b, "127.0.0.1", 65002, {patient});
+    auto spawned = system_b->GetRoot()->SpawnNamed(Props::FromFunc(
+        [&received, &out_of_order, last](std::shared_ptr<Context> ctx) {
+            if (!ctx->Sender()) {
+                return;
+            }
+            auto quote = std::static_pointer_cast<Quote>(ctx->Message());
+            if (quote->time != *last + 1) {
+                out_of_order.fetch_add(1);
+            }
+            *last = quote->time;
+            received.fetch_add(1);
+        }), "late-target");
+    ASSERT_TRUE(!spawned.second);
+    for (int i = 0; i < 400 && received.load() < 20; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(received.load(), 20);
+    ASSERT_EQ(out_of_order.load(), 0);
+
+    remote_a->Shutdown();
+    remote_b->Shutdown();
+    system_a->Shutdown();
+    system_b->Shutdown();
+    return true;
+}
+
+// Transport whose single connection answers the handshake only when told to and records
+// every data frame the writer sends
+class ScriptedConnection : public remote::TransportConnection,
+                           public std::enable_shared_from_this<ScriptedConnection> {
+public:
+    explicit ScriptedConnection(remote::TransportHandler handler) : handler_(std::move(handler)) {}
+
+    std::error_code Send(std::string frame) override {
+        remote::wire::RemoteMessage message;
+        if (remote::wire::Decode(frame, &message) && message.type == remote::wire::RemoteMessage::Type::MessageBatch) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            frames_.push_back(std::move(frame));
+            released_.wait(lock, [this]() { return !held_; });
+        }
+        return std::error_code();
+    }
+
+    void Close() override {
+        if (!closed_.exchange(true) && handler_.on_close) {
+            handler_.on_close(shared_from_this());
+        }
+    }
+
+    bool Closed() const override { return closed_.load(); }
+
+    void PauseReading(bool) override {}
+
+    void AcceptHandshake(uint32_t compression = remote::wire::kCompressionNone) {
+        remote::wire::ConnectResponse response;
+        response.member_id = "scripted";
+        response.compression = compression;
+        auto frame = std::make_shared<std::string>();
+        remote::wire::EncodeConnectResponse(response, frame.get());
+        handler_.on_frame(shared_from_this(), frame);
+    }
+
+    std::vector<std::string> Frames() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return frames_;
+    }
+
+    // While held, Send blocks after recording its frame, stalling the writer's thread
+    void Hold(bool held) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            held_ = held;
+        }
+        released_.notify_all();
+    }
+
+private:
+    remote::TransportHandler handler_;
+    std::atomic<bool> closed_{false};
+    std::mutex mutex_;
+    std::condition_variable released_;
+    bool held_ = false;
+    std::vector<std::string> frames_;
+};
+
+class ScriptedTransport : public remote::Transport {
+public:
+    std::error_code Listen(const std::string&, remote::TransportHandler) override { return std::error_code(); }
+    std::string ListenAddress() const override { return std::string(); }
+    std::pair<std::shared_ptr<remote::TransportConnection>, std::error_code> Connect(
+        const std::string&, remote::TransportHandler handler) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        connection = std::make_shared<ScriptedConnection>(std::move(handler));
+        return {connection, std::error_code()};
+    }
+    void Stop() override {}
+
+    std::mutex mutex;
+    std::shared_ptr<ScriptedConnection> connection;
+};
+
+static bool test_system_messages_overtake_queued_user_messages() {
+    auto system = ActorSystem::New();
+    auto remote_a = remote::Remote::Start(system, "127.0.0.1", 0, {[](std::shared_ptr<remote::Config> config) {
+        config->transport = remote::TransportKind::InProcess;
+    }});
+    auto transport = std::make_shared<ScriptedTransport>();
+    auto config = remote_a->GetConfig();
+    std::vector<std::shared_ptr<remote::Transport>> transports{transport};
+    auto writer = system->GetRoot()->Spawn(Props::FromProducer([remote_a, config, transports]() {
+        return std::make_shared<remote::EndpointWriter>(remote_a, "peer:1", config, nullptr, transports);
+    }));
+
+    // Queued while the handshake is pending: user traffic first, then one system message
+    auto deliver = [&](const std::string& target, bool system_message) {
+        auto message = std::make_shared<remote::RemoteDeliver>();
+        message->target = NewPID("peer:1", target);
+        message->message = std::make_shared<Quote>();
+        message->serializer_id = remote::BinarySerializer::SerializerID();
+        message->system = system_message;
+        system->GetRoot()->Send(writer, message);
+    };
+    for (int i = 0; i < 100; ++i) {
+        deliver("user-target", false);
+    }
+    deliver("system-target", true);
+    std::shared_ptr<ScriptedConnection> connection;
+    for (int i = 0; i < 400 && !connection; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        std::lock_guard<std::mutex> lock(transport->mutex);
+        connection = transport->connection;
+    }
+    ASSERT_TRUE(connection != nullptr);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_TRUE(connection->Frames().empty());
+    connection->AcceptHandshake();
+
+    std::vector<std::string> frames;
+    size_t envelopes = 0;
+    for (int i = 0; i < 400 && envelopes < 101; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        frames = connection->Frames();
+        envelopes = 0;
+        for (const auto& frame : frames) {
+            remote::wire::RemoteMessage message;
+            ASSERT_TRUE(remote::wire::Decode(frame, &message));
+            envelopes += message.message_batch.envelopes.size();
+        }
+    }
+    ASSERT_EQ(envelopes, static_cast<size_t>(101));
+    // The system message went out first, in a frame of its own
+    remote::wire::RemoteMessage first;
+    ASSERT_TRUE(remote::wire::Decode(frames.front(), &first));
+    ASSERT_EQ(first.message_batch.envelopes.size(), static_cast<size_t>(1));
+    ASSERT_EQ(first.message_batch.targets.size(), static_cast<size_t>(1));
+    ASSERT_TRUE(first.message_batch.targets[0] == "system-target");
+    for (size_t i = 1; i < frames.size(); ++i) {
+        remote::wire::RemoteMessage rest;
+        ASSERT_TRUE(remote::wire::Decode(frames[i], &rest));
+        for (const auto& target : rest.message_batch.targets) {
+            ASSERT_TRUE(target == "user-target");
+        }
+    }
+
+    system->GetRoot()->Stop(writer);
+    remote_a->Shutdown();
+    system->Shutdown();
+    return true;
+}
+
+static bool test_system_messages_skip_full_writer_mailbox() {
+    auto system = ActorSystem::New();
+    auto remote_a = remote::Remote::Start(system, "127.0.0.1", 0, {[](std::shared_ptr<remote::Config> config) {
+        config->transport = remote::TransportKind::InProcess;
+    }});
+    auto transport = std::make_shared<ScriptedTransport>();
+    auto config = remote_a->GetConfig();
+    std::vector<std::shared_ptr<remote::Transport>> transports{transport};
+    auto writer = system->GetRoot()->Spawn(Props::FromProducer([remote_a, config, transports]() {
+        return std::make_shared<remote::EndpointWriter>(remote_a, "peer:1", config, nullptr, transports);
+    }));
+    std::shared_ptr<ScriptedConnection> connection;
+    for (int i = 0; i < 400 && !connection; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        std::lock_guard<std::mutex> lock(transport->mutex);
+        connection = transport->connection;
+    }
+    ASSERT_TRUE(connection != nullptr);
+    connection->AcceptHandshake();
+
+    auto user_deliver = [&]() {
+        auto message = std::make_shared<remote::RemoteDeliver>();
+        message->target = NewPID("peer:1", "user-target");
+        message->message = std::make_shared<Quote>();
+        message->serializer_id = remote::BinarySerializer::SerializerID();
+        system->GetRoot()->Send(writer, message);
+    };
+    // Stall the connected writer inside its first send, then back its mailbox up
+    connection->Hold(true);
+    user_deliver();
+    for (int i = 0; i < 400 && connection->Frames().empty(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(connection->Frames().size(), static_cast<size_t>(1));
+    for (int i = 0; i < 1000; ++i) {
+        user_deliver();
+    }
+    // Posted the way EndpointManager::RemoteDeliverSystem posts it, with a payload every
+    // test binary can serialize
+    auto urgent = std::make_shared<remote::RemoteDeliver>();
+    urgent->target = NewPID("peer:1", "system-target");
+    urgent->message = std::make_shared<Quote>();
+    urgent->serializer_id = remote::BinarySerializer::SerializerID();
+    urgent->system = true;
+    writer->SendSystemMessage(system, urgent);
+    connection->Hold(false);
+
+    std::vector<std::string> frames;
+    size_t envelopes = 0;
+    for (int i = 0; i < 400 && envelopes < 1002; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        frames = connection->Frames();
+        envelopes = 0;
+        for (const auto& frame : frames) {
+            remote::wire::RemoteMessage message;
+            ASSERT_TRUE(remote::wire::Decode(frame, &message));
+            envelopes += message.message_batch.envelopes.size();
+        }
+    }
+    ASSERT_EQ(envelopes, static_cast<size_t>(1002));
+    // The system message went out right after the stalled send, ahead of the whole backlog
+    ASSERT_GE(frames.size(), static_cast<size_t>(3));
+    remote::wire::RemoteMessage next;
+    ASSERT_TRUE(remote::wire::Decode(frames[1], &next));
+    ASSERT_EQ(next.message_batch.targets.size(), static_cast<size_t>(1));
+    ASSERT_TRUE(next.message_batch.targets[0] == "system-target");
+
+    system->GetRoot()->Stop(writer);
+    remote_a->Shutdown();
+    system->Shutdown();
+    return true;
+}
+
+// Sends count quotes through a writer whose peer answers the handshake with the given codec;
+// returns the batch frames it wrote
+static bool write_quotes_to_scripted_peer(uint32_t answered, int count, std::vector<std::string>* frames) {
+    auto system = ActorSystem::New();
+    auto remote_a = remote::Remote::Start(system, "127.0.0.1", 0, {[](std::shared_ptr<remote::Config> config) {
+        config->transport = remote::TransportKind::InProcess;
+        config->endpoint_compression = remote::BatchCompression::Lz4;
+        config->endpoint_compression_threshold = 1024;
+    }});
+    auto transport = std::make_shared<ScriptedTransport>();
+    auto config = remote_a->GetConfig();
+    std::vector<std::shared_ptr<remote::Transport>> transports{transport};
+    auto writer = system->GetRoot()->Spawn(Props::FromProducer([remote_a, config, transports]() {
+        return std::make_shared<remote::EndpointWriter>(remote_a, "peer:1", config, nullptr, transports);
+    }));
+    // Queued during the handshake, so they go out as large batches
+    for (int i = 0; i < count; ++i) {
+        auto message = std::make_shared<remote::RemoteDeliver>();
+        message->target = NewPID("peer:1", "worker");
+        auto quote = std::make_shared<Quote>();
+        quote->time = i;
+        message->message = quote;
+        message->serializer_id = remote::BinarySerializer::SerializerID();
+        system->GetRoot()->Send(writer, message);
+    }
+    std::shared_ptr<ScriptedConnection> connection;
+    for (int i = 0; i < 400 && !connection; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        std::lock_guard<std::mutex> lock(transport->mutex);
+        connection = transport->connection;
+    }
+    ASSERT_TRUE(connection != nullptr);
+    connection->AcceptHandshake(answered);
+
+    size_t envelopes = 0;
+    for (int i = 0; i < 400 && envelopes < static_cast<size_t>(count); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        *frames = connection->Frames();
+        envelopes = 0;
+        for (const auto& frame : *frames) {
+            remote::wire::RemoteMessage message;
+            ASSERT_TRUE(remote::wire::Decode(frame, &message));
+            std::string body;
+            remote::wire::MessageBatch batch;
+            if (message.message_batch.compression != remote::wire::kCompressionNone) {
+                ASSERT_TRUE(remote::wire::DecompressBatch(message.message_batch, &body, &batch));
+                envelopes += batch.envelopes.size();
+            } else {
+                envelopes += message.message_batch.envelopes.size();
+            }
+        }
+    }
+    ASSERT_EQ(envelopes, static_cast<size_t>(count));
+
+    system->GetRoot()->Stop(writer);
+    remote_a->Shutdown();
+    system->Shutdown();
+    return true;
+}
+
+static bool test_large_batches_compressed_when_peer_agrees() {
+    auto compressed = [](const std::string& frame) {
+        remote::wire::RemoteMessage message;
+        return remote::wire::Decode(frame, &message) &&
+               message.message_batch.compression == remote::wire::kCompressionLz4;
+    };
+
+    std::vector<std::string> frames;
+    ASSERT_TRUE(write_quotes_to_scripted_peer(remote::wire::kCompressionLz4, 500, &frames));
+    size_t compressed_frames = 0;
+    for (const auto& frame : frames) {
+        if (compressed(frame)) {
+            ++compressed_frames;
+        } else {
+            // Only batches below the threshold go out as they are
+            ASSERT_TRUE(frame.size() < 1024);
+        }
+    }
+    ASSERT_TRUE(compressed_frames > 0);
+
+    // A peer that answers without a codec gets plain batches
+    frames.clear();
+    ASSERT_TRUE(write_quotes_to_scripted_peer(remote::wire::kCompressionNone, 500, &frames));
+    for (const auto& frame : frames) {
+        ASSERT_TRUE(!compressed(frame));
+    }
+    return true;
+}
+
+static bool test_inprocess_transport_close_reaches_both_ends() {
+    auto server = std::make_shared<remote::InProcessTransport>();
+    auto client = std::make_shared<remote::InProcessTransport>();
+    std::atomic<int> frames(0);
+    std::atomic<int> closes(0);
+    remote::TransportHandler echo;
+    echo.on_frame = [&frames](const std::shared_ptr<remote::TransportConnection>& connection,
+                              std::shared_ptr<std::string> frame) {
+        frames.fetch_add(1);
+        connection->Send(*frame);
+    };
+    echo.on_close = [&closes](const std::shared_ptr<remote::TransportConnection>&) { closes.fetch_add(1); };
+    ASSERT_TRUE(!server->Listen("local:0", echo));
+    auto address = server->ListenAddress();
+    ASSERT_TRUE(address != "local:0");
+    ASSERT_TRUE(client->Connect("nowhere:1", echo).second == std::make_error_code(std::errc::connection_refused));
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::string> replies;
+    remote::TransportHandler collect;
+    collect.on_frame = [&](const std::shared_ptr<remote::TransportConnection>&, std::shared_ptr<std::string> frame) {
+        std::lock_guard<std::mutex> lock(mutex);
+        replies.push_back(*frame);
+        cv.notify_all();
+    };
+    collect.on_close = [&closes](const std::shared_ptr<remote::TransportConnection>&) { closes.fetch_add(1); };
+    auto connected = client->Connect(address, collect);
+    ASSERT_TRUE(!connected.second);
+    ASSERT_EQ(server->Connections(), static_cast<size_t>(1));
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(!connected.first->Send(std::to_string(i)));
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait_for(lock, std::chrono::seconds(5), [&replies]() { return replies.size() == 100; });
+        ASSERT_EQ(replies.size(), static_cast<size_t>(100));
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_EQ(replies[i], std::to_string(i));
+        }
+    }
+
+    connected.first->Close();
+    ASSERT_TRUE(connected.first->Send("late") == std::make_error_code(std::errc::not_connected));
+    for (int i = 0; i < 200 && closes.load() < 2; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(closes.load(), 2);
+    ASSERT_EQ(server->Connections(), static_cast<size_t>(0));
+    ASSERT_EQ(frames.load(), 100);
+
+    // The address is released on Stop
+    server->Stop();
+    ASSERT_TRUE(client->Connect(address, collect).second == std::make_error_code(std::errc::connection_refused));
+    client->Stop();
+    return true;
+}
+
 // ============================================================================
 // Message Envelope Tests (for remote)
 // ============================================================================
@@ -266,6 +2200,54 @@ int main() {
     // Serialization tests
     RUN(test_serialization_type_protobuf);
     RUN(test_serialization_type_json);
+    RUN(test_serializer_zero_copy_falls_back_to_vector_api);
+    RUN(test_serializer_zero_copy_writes_into_reused_buffer);
+    RUN(test_serializer_registry_lookups_during_registration);
+    RUN(test_binary_serializer_pod_round_trip);
+    RUN(test_binary_serializer_reflected_round_trip);
+    RUN(test_binary_serializer_bool_and_enum_fields);
+    RUN(test_binary_serializer_rejects_malformed_input);
+
+    // Endpoint writer flush policy tests
+    RUN(test_flush_policy_triggers);
+    RUN(test_flush_policy_adapts_batch_size);
+
+    // Endpoint queue tests
+    RUN(test_endpoint_queue_bounds_depth);
+    RUN(test_endpoint_queue_backpressure_hysteresis);
+
+    // Endpoint reader tests
+    RUN(test_endpoint_reader_preserves_per_target_order);
+    RUN(test_endpoint_reader_pauses_above_high_water);
+
+    // Connection dictionary tests
+    RUN(test_connection_dictionary_sends_entries_once);
+    RUN(test_connection_dictionary_resets_when_full);
+    RUN(test_connection_dictionary_bounds_the_receiver);
+
+    // Transport tests
+    RUN(test_wire_codec_round_trip);
+    RUN(test_lz4_round_trip);
+    RUN(test_wire_batch_compression_round_trip);
+    RUN(test_tcp_transport_frames_round_trip);
+    RUN(test_tcp_transport_pause_reading);
+    RUN(test_tcp_transport_connect_failure_closes);
+    RUN(test_shm_transport_frames_round_trip);
+    RUN(test_shm_transport_accept_does_not_wait_for_hello);
+    RUN(test_tcp_remote_delivers_between_systems);
+    RUN(test_shm_remote_selected_for_same_host_peer);
+    RUN(test_inprocess_remote_delivers_between_systems);
+    RUN(test_compressed_batches_deliver_between_systems);
+    RUN(test_inprocess_transport_close_reaches_both_ends);
+    RUN(test_endpoint_writer_for_target_is_stable);
+    RUN(test_striped_endpoint_keeps_per_target_order);
+    RUN(test_striped_endpoint_reconnects_after_stripe_drop);
+    RUN(test_reconnect_backoff_doubles_with_jitter);
+    RUN(test_unreachable_endpoint_gives_up_without_blocking);
+    RUN(test_endpoint_buffers_until_peer_listens);
+    RUN(test_system_messages_overtake_queued_user_messages);
+    RUN(test_system_messages_skip_full_writer_mailbox);
+    RUN(test_large_batches_compressed_when_peer_agrees);
 
     // Message envelope tests
     RUN(test_message_envelope_with_sender);
@@ -1,12 +1,25 @@
 /**
  * Unit tests for Router module: BroadcastRouter, RoundRobinRouter,
- * RandomRouter, and ConsistentHashRouter.
+ * RandomRouter, ConsistentHashRouter, LeastLoadedRouter, SmallestMailboxRouter,
+ * FanoutBroadcastRouter and ScatterGatherFirstCompletedRouter.
  */
 #include "external/router/router.h"
+#include "external/actor_system.h"
+#include "external/dispatcher.h"
 #include "external/pid.h"
+#include "external/props.h"
+#include "external/scatter_gather.h"
+#include "internal/router/router_group.h"
+#include "internal/thread_pool.h"
 #include "tests/test_common.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <cstdio>
+#include <map>
 #include <memory>
+#include <string>
+#include <thread>
 #include <vector>
 
 using namespace protoactor;
@@ -152,6 +165,516 @@ static bool test_consistent_hash_router_empty_routees() {
     return true;
 }
 
+struct Keyed {
+    uint64_t key;
+};
+
+static router::ConsistentHashRouter keyed_router() {
+    return router::ConsistentHashRouter([](const std::shared_ptr<void>& msg) {
+        return static_cast<const Keyed*>(msg.get())->key;
+    });
+}
+
+static bool test_consistent_hash_router_key_affinity() {
+    auto router = keyed_router();
+    router.SetRoutees(create_test_routees(8));
+
+    std::map<std::string, int> load;
+    for (uint64_t k = 0; k < 8000; ++k) {
+        auto first = router.RouteeFor(std::make_shared<Keyed>(Keyed{k}));
+        auto again = router.RouteeFor(std::make_shared<Keyed>(Keyed{k}));
+        ASSERT_TRUE(first != nullptr);
+        ASSERT_TRUE(first->id == again->id);
+        load[first->id]++;
+    }
+    // Every routee gets a share; virtual nodes keep the spread within 2x of the mean
+    ASSERT_EQ(load.size(), static_cast<size_t>(8));
+    for (auto& entry : load) {
+        ASSERT_TRUE(entry.second > 500 && entry.second < 2000);
+    }
+    return true;
+}
+
+static bool test_consistent_hash_router_resize_remaps_few_keys() {
+    auto router = keyed_router();
+    router.SetRoutees(create_test_routees(10));
+    std::vector<std::string> before;
+    for (uint64_t k = 0; k < 10000; ++k) {
+        before.push_back(router.RouteeFor(std::make_shared<Keyed>(Keyed{k}))->id);
+    }
+
+    router.SetRoutees(create_test_routees(11));
+    int moved = 0;
+    for (uint64_t k = 0; k < 10000; ++k) {
+        auto id = router.RouteeFor(std::make_shared<Keyed>(Keyed{k}))->id;
+        if (id != before[k]) {
+            ASSERT_TRUE(id == "routee-10");  // Keys only move to the new routee
+            ++moved;
+        }
+    }
+    // About 1/11 of the keys move; modulo hashing would move about 10/11
+    ASSERT_TRUE(moved > 300 && moved < 2000);
+    return true;
+}
+
+static bool test_consistent_hash_router_concurrent_update() {
+    auto router = keyed_router();
+    router.SetRoutees(create_test_routees(4));
+    std::atomic<bool> stop(false);
+    std::atomic<int> misses(0);
+    std::thread reader([&]() {
+        uint64_t k = 0;
+        while (!stop.load()) {
+            if (!router.RouteeFor(std::make_shared<Keyed>(Keyed{k++}))) {
+                misses.fetch_add(1);
+            }
+        }
+    });
+    for (int i = 0; i < 200; ++i) {
+        router.SetRoutees(create_test_routees(2 + i % 5));
+    }
+    stop.store(true);
+    reader.join();
+    ASSERT_EQ(misses.load(), 0);
+    return true;
+}
+
+static bool test_published_reader_keeps_its_snapshot() {
+    router::RouteeSet set;
+    set.Store(create_test_routees(2));
+    {
+        auto held = set.Load();
+        for (int i = 3; i < 10; ++i) {
+            set.Store(create_test_routees(i));
+        }
+        // Values replaced while a reader is inside stay readable until it leaves
+        ASSERT_EQ(held->size(), static_cast<size_t>(2));
+        ASSERT_TRUE((*held)[1] != nullptr);
+        ASSERT_EQ(set.Load()->size(), static_cast<size_t>(9));
+    }
+    set.Store(create_test_routees(1));
+    ASSERT_EQ(set.Load()->size(), static_cast<size_t>(1));
+    return true;
+}
+
+// ============================================================================
+// Load-aware Router Tests
+// ============================================================================
+
+struct Job {
+    static constexpr uint64_t MAGIC = 0x524F5554454A4F42ULL;
+    uint64_t magic = MAGIC;
+    int value = 0;
+};
+
+static std::shared_ptr<Job> make_job(int value) {
+    auto job = std::make_shared<Job>();
+    job->value = value;
+    return job;
+}
+
+static bool is_job(const std::shared_ptr<void>& msg) {
+    return msg && static_cast<const Job*>(msg.get())->magic == Job::MAGIC;
+}
+
+struct LoadFixture {
+    std::shared_ptr<ActorSystem> system = ActorSystem::New();
+    // Slow routees block their thread; keep them off the default pool
+    std::shared_ptr<ThreadPool> slow_pool = NewThreadPool(4);
+    std::atomic<bool> release{false};
+    std::atomic<int> slow_count{0};
+    std::atomic<int> fast_count{0};
+
+    // Blocks until released, so its mailbox keeps growing
+    std::shared_ptr<PID> SpawnSlow() {
+        return system->GetRoot()->Spawn(Props::FromFunc([this](std::shared_ptr<Context> ctx) {
+            if (!is_job(ctx->Message())) {
+                return;
+            }
+            slow_count.fetch_add(1);
+            while (!release.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        })->WithDispatcher(NewDefaultDispatcher(300, slow_pool)));
+    }
+
+    std::shared_ptr<PID> SpawnFast() {
+        return system->GetRoot()->Spawn(Props::FromFunc([this](std::shared_ptr<Context> ctx) {
+            if (is_job(ctx->Message())) {
+                fast_count.fetch_add(1);
+            }
+        }));
+    }
+
+    ~LoadFixture() {
+        release.store(true);
+        system->Shutdown();
+        slow_pool->Shutdown();
+    }
+};
+
+static bool test_least_loaded_router_prefers_short_mailbox() {
+    LoadFixture fx;
+    auto slow = fx.SpawnSlow();
+    auto fast = fx.SpawnFast();
+    // Deeper than the fast routee can get even if it does not run while we route
+    for (int i = 0; i < 200; ++i) {
+        fx.system->GetRoot()->Send(slow, make_job(i));
+    }
+    router::LeastLoadedRouter router;
+    router.SetSender(fx.system->GetRoot());
+    router.SetRoutees({slow, fast});
+    ASSERT_EQ(router.GetRoutees().size(), static_cast<size_t>(2));
+    for (int i = 0; i < 50; ++i) {
+        router.RouteMessage(make_job(i));
+    }
+    for (int i = 0; i < 200 && fx.fast_count.load() < 50; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    // With two routees both are always sampled, so every job avoids the backed-up one
+    ASSERT_EQ(fx.fast_count.load(), 50);
+    return true;
+}
+
+static bool test_smallest_mailbox_router_scans_all() {
+    LoadFixture fx;
+    std::vector<std::shared_ptr<PID>> routees = {fx.SpawnSlow(), fx.SpawnSlow(), fx.SpawnFast(), fx.SpawnSlow()};
+    for (int r : {0, 1, 3}) {
+        for (int i = 0; i < 100; ++i) {
+            fx.system->GetRoot()->Send(routees[r], make_job(i));
+        }
+    }
+    router::SmallestMailboxRouter router;
+    router.SetRoutees(routees);
+    router.SetSender(fx.system->GetRoot());  // Mailboxes resolve once a sender is known
+    for (int i = 0; i < 30; ++i) {
+        router.RouteMessage(make_job(i));
+    }
+    for (int i = 0; i < 200 && fx.fast_count.load() < 30; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(fx.fast_count.load(), 30);
+    return true;
+}
+
+// ============================================================================
+// FanoutBroadcastRouter Tests
+// ============================================================================
+
+class CountingDispatcher : public Dispatcher {
+public:
+    std::atomic<int> scheduled{0};
+    std::shared_ptr<Dispatcher> inner = NewDefaultDispatcher(300);
+
+    void Schedule(std::function<void()> fn) override {
+        scheduled.fetch_add(1);
+        inner->Schedule(std::move(fn));
+    }
+
+    int Throughput() const override {
+        return inner->Throughput();
+    }
+};
+
+static bool test_fanout_broadcast_router_batches_schedules() {
+    auto system = ActorSystem::New();
+    auto dispatcher = std::make_shared<CountingDispatcher>();
+    std::atomic<int> received(0);
+    std::vector<std::shared_ptr<void>> seen(256);
+    std::vector<std::shared_ptr<PID>> routees;
+    for (int i = 0; i < 256; ++i) {
+        routees.push_back(system->GetRoot()->Spawn(Props::FromFunc([&received, &seen, i](std::shared_ptr<Context> ctx) {
+            if (is_job(ctx->Message())) {
+                seen[i] = ctx->Message();
+                received.fetch_add(1);
+            }
+        })->WithDispatcher(dispatcher)));
+    }
+    // A routee without a local mailbox takes the regular send path
+    routees.push_back(system->NewLocalPID("missing"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));  // Let Started drain
+
+    router::FanoutBroadcastRouter router;
+    router.SetSender(system->GetRoot());
+    router.SetRoutees(routees);
+    dispatcher->scheduled.store(0);
+    auto job = make_job(7);
+    router.RouteMessage(job);
+    for (int i = 0; i < 400 && received.load() < 256; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(received.load(), 256);
+    // One Schedule per batch of idle mailboxes instead of one per routee
+    ASSERT_TRUE(dispatcher->scheduled.load() <= 256 / static_cast<int>(router::FanoutBroadcastRouter::FANOUT_BATCH) + 1);
+    // Every routee saw the same message instance
+    for (auto& msg : seen) {
+        ASSERT_TRUE(msg.get() == job.get());
+    }
+    system->Shutdown();
+    return true;
+}
+
+// ============================================================================
+// ScatterGatherFirstCompletedRouter Tests
+// ============================================================================
+
+struct GatherFixture {
+    std::shared_ptr<ActorSystem> system = ActorSystem::New();
+    std::atomic<int> received{0};
+
+    // Counts requests, answers only when `respond` is set
+    std::shared_ptr<PID> Spawn(bool respond) {
+        return system->GetRoot()->Spawn(Props::FromFunc([this, respond](std::shared_ptr<Context> ctx) {
+            if (!is_job(ctx->Message())) {
+                return;
+            }
+            received.fetch_add(1);
+            if (respond) {
+                ctx->Respond(make_job(42));
+            }
+        }));
+    }
+
+    ~GatherFixture() {
+        system->Shutdown();
+    }
+};
+
+static std::shared_ptr<void> first_response(const std::shared_ptr<void>& res) {
+    for (auto& r : std::static_pointer_cast<ScatterGatherResult>(res)->responses) {
+        if (r) {
+            return r;
+        }
+    }
+    return nullptr;
+}
+
+static bool test_first_completed_router_takes_first_response() {
+    GatherFixture fx;
+    router::ScatterGatherFirstCompletedRouter router(3);
+    router.SetSender(fx.system->GetRoot());
+    router.SetRoutees({fx.Spawn(false), fx.Spawn(true), fx.Spawn(false)});
+
+    auto future = router.Request(make_job(1));
+    auto [res, err] = future->Result();
+    ASSERT_TRUE(!err);
+    auto reply = first_response(res);
+    ASSERT_TRUE(is_job(reply));
+    ASSERT_EQ(std::static_pointer_cast<Job>(reply)->value, 42);
+    for (int i = 0; i < 200 && fx.received.load() < 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(fx.received.load(), 3);
+    ASSERT_EQ(router.Outstanding(), static_cast<size_t>(0));
+    return true;
+}
+
+static bool test_first_completed_router_hedges_after_delay() {
+    GatherFixture fx;
+    router::ScatterGatherFirstCompletedRouter router(
+        2, std::chrono::milliseconds(2000), true, std::chrono::milliseconds(50));
+    router.SetSender(fx.system->GetRoot());
+
+    // Fast first routee: the hedge is never sent
+    router.SetRoutees({fx.Spawn(true), fx.Spawn(true)});
+    auto [res, err] = router.Request(make_job(1))->Result();
+    ASSERT_TRUE(!err);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    ASSERT_EQ(fx.received.load(), 1);
+
+    // Silent first routee: the second copy goes out after the delay and wins
+    // (fresh router: the starting routee rotates between requests)
+    fx.received.store(0);
+    router::ScatterGatherFirstCompletedRouter hedged(
+        2, std::chrono::milliseconds(2000), true, std::chrono::milliseconds(50));
+    hedged.SetSender(fx.system->GetRoot());
+    hedged.SetRoutees({fx.Spawn(false), fx.Spawn(true)});
+    auto start = std::chrono::steady_clock::now();
+    auto [res2, err2] = hedged.Request(make_job(2))->Result();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_TRUE(!err2);
+    ASSERT_TRUE(is_job(first_response(res2)));
+    ASSERT_EQ(fx.received.load(), 2);
+    ASSERT_TRUE(elapsed >= std::chrono::milliseconds(40));
+    return true;
+}
+
+static bool test_first_completed_router_cancel_outstanding() {
+    GatherFixture fx;
+    router::ScatterGatherFirstCompletedRouter router(2, std::chrono::milliseconds(5000));
+    router.SetSender(fx.system->GetRoot());
+    router.SetRoutees({fx.Spawn(false), fx.Spawn(false)});
+
+    auto future = router.Request(make_job(1));
+    ASSERT_EQ(router.Outstanding(), static_cast<size_t>(1));
+    ASSERT_EQ(router.CancelOutstanding(), static_cast<size_t>(1));
+    auto [res, err] = future->Result();
+    ASSERT_TRUE(err == std::make_error_code(std::errc::operation_canceled));
+    ASSERT_EQ(router.Outstanding(), static_cast<size_t>(0));
+    return true;
+}
+
+static bool test_first_completed_router_destroyed_while_responses_arrive() {
+    GatherFixture fx;
+    std::vector<std::shared_ptr<PID>> routees;
+    for (int i = 0; i < 4; ++i) {
+        routees.push_back(fx.Spawn(true));
+    }
+
+    // Completion callbacks run on the responders' threads after the router is gone
+    std::vector<std::shared_ptr<Future>> futures;
+    for (int round = 0; round < 200; ++round) {
+        auto router = std::make_unique<router::ScatterGatherFirstCompletedRouter>(3);
+        router->SetSender(fx.system->GetRoot());
+        router->SetRoutees(routees);
+        for (int i = 0; i < 4; ++i) {
+            futures.push_back(router->Request(make_job(i)));
+        }
+        // Vary the gap so the destructor lands before, during and after the first replies
+        std::this_thread::sleep_for(std::chrono::microseconds((round % 10) * 20));
+        router.reset();
+    }
+    for (auto& future : futures) {
+        auto [res, err] = future->Result();
+        ASSERT_TRUE(!err || err == std::make_error_code(std::errc::operation_canceled));
+    }
+    return true;
+}
+
+// ============================================================================
+// Elastic Pool Tests
+// ============================================================================
+
+static router::ElasticPoolConfig manual_config() {
+    router::ElasticPoolConfig config;
+    config.min_routees = 1;
+    config.max_routees = 3;
+    config.scale_up_depth = 10.0;
+    config.scale_down_depth = 1.0;
+    config.stable_checks = 2;
+    config.cooldown_checks = 0;
+    config.grow_ratio = 1.0;
+    config.check_interval = std::chrono::milliseconds(0);  // Evaluate() driven by the test
+    return config;
+}
+
+static bool test_elastic_pool_grows_on_backlog_and_shrinks_when_idle() {
+    LoadFixture fx;
+    auto props = Props::FromFunc([&fx](std::shared_ptr<Context> ctx) {
+        if (!is_job(ctx->Message())) {
+            return;
+        }
+        while (!fx.release.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    })->WithDispatcher(NewDefaultDispatcher(300, fx.slow_pool));
+    auto pool = router::ElasticRouterActorPool::New(fx.system->GetRoot(), props, manual_config());
+    auto router = std::make_shared<router::RoundRobinRouter>();
+    pool->AttachRouter(router);
+    ASSERT_EQ(router->GetRoutees().size(), static_cast<size_t>(1));
+
+    auto first = pool->GetRoutees()[0];
+    for (int i = 0; i < 50; ++i) {
+        fx.system->GetRoot()->Send(first, make_job(i));
+    }
+    ASSERT_GE(pool->AverageDepth(), 10.0);
+    // One high reading is not enough
+    ASSERT_EQ(pool->Evaluate(), 1);
+    ASSERT_EQ(pool->Evaluate(), 2);
+    ASSERT_EQ(router->GetRoutees().size(), static_cast<size_t>(2));
+
+    fx.release.store(true);
+    for (int i = 0; i < 400 && pool->AverageDepth() > 0.0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(pool->Evaluate(), 2);
+    ASSERT_EQ(pool->Evaluate(), 1);
+    ASSERT_EQ(router->GetRoutees().size(), static_cast<size_t>(1));
+    // Never below the minimum
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(pool->Evaluate(), 1);
+    }
+    pool->Stop();
+    ASSERT_EQ(pool->GetRoutees().size(), static_cast<size_t>(0));
+    return true;
+}
+
+static bool test_elastic_pool_grows_on_latency() {
+    LoadFixture fx;
+    std::atomic<int> processed(0);
+    auto props = Props::FromFunc([&processed](std::shared_ptr<Context> ctx) {
+        if (is_job(ctx->Message())) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            processed.fetch_add(1);
+        }
+    })->WithDispatcher(NewDefaultDispatcher(300, fx.slow_pool));
+    auto config = manual_config();
+    config.scale_up_depth = 0.0;
+    config.scale_up_latency = std::chrono::milliseconds(2);
+    config.scale_down_latency = std::chrono::microseconds(500);
+    config.stable_checks = 1;
+    auto pool = router::ElasticRouterActorPool::New(fx.system->GetRoot(), props, config);
+
+    for (int i = 0; i < 4; ++i) {
+        fx.system->GetRoot()->Send(pool->GetRoutees()[0], make_job(i));
+    }
+    for (int i = 0; i < 400 && processed.load() < 4; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(pool->Evaluate(), 2);
+    ASSERT_GE(pool->MeanLatency().count(), 2000);
+    pool->Stop();
+    return true;
+}
+
+static bool test_elastic_pool_resizes_on_owner_actor() {
+    LoadFixture fx;
+    auto routee_props = Props::FromFunc([&fx](std::shared_ptr<Context> ctx) {
+        if (!is_job(ctx->Message())) {
+            return;
+        }
+        while (!fx.release.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    })->WithDispatcher(NewDefaultDispatcher(300, fx.slow_pool));
+    auto config = manual_config();
+    config.max_routees = 2;
+    config.stable_checks = 1;
+    config.check_interval = std::chrono::milliseconds(10);
+
+    // The owner creates the pool; periodic resizes come back to it as system messages
+    std::shared_ptr<router::ElasticRouterActorPool> pool;
+    std::atomic<bool> created{false};
+    auto owner = fx.system->GetRoot()->Spawn(Props::FromFunc([&](std::shared_ptr<Context> ctx) {
+        if (!pool) {
+            pool = router::ElasticRouterActorPool::New(ctx, routee_props, config);
+            created.store(true);
+        } else if (is_job(ctx->Message())) {
+            ctx->Respond(make_job(static_cast<int>(ctx->Children().size())));
+        }
+    }));
+    for (int i = 0; i < 400 && !created.load(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_TRUE(created.load());
+
+    auto first = pool->GetRoutees()[0];
+    for (int i = 0; i < 50; ++i) {
+        fx.system->GetRoot()->Send(first, make_job(i));
+    }
+    for (int i = 0; i < 400 && pool->GetRoutees().size() < 2; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(pool->GetRoutees().size(), static_cast<size_t>(2));
+
+    // Both routees were spawned as children of the owner
+    auto [res, err] = fx.system->GetRoot()->RequestFuture(owner, make_job(0), std::chrono::milliseconds(2000))->Result();
+    ASSERT_TRUE(!err);
+    ASSERT_EQ(std::static_pointer_cast<Job>(res)->value, 2);
+    pool->Stop();
+    return true;
+}
+
 // ============================================================================
 // Common Router Interface Tests
 // ============================================================================
@@ -248,6 +771,28 @@ int main() {
     // ConsistentHashRouter tests
     RUN(test_consistent_hash_router_set_routees);
     RUN(test_consistent_hash_router_empty_routees);
+    RUN(test_consistent_hash_router_key_affinity);
+    RUN(test_consistent_hash_router_resize_remaps_few_keys);
+    RUN(test_consistent_hash_router_concurrent_update);
+    RUN(test_published_reader_keeps_its_snapshot);
+
+    // Load-aware router tests
+    RUN(test_least_loaded_router_prefers_short_mailbox);
+    RUN(test_smallest_mailbox_router_scans_all);
+
+    // Fan-out broadcast router tests
+    RUN(test_fanout_broadcast_router_batches_schedules);
+
+    // Scatter-gather-first-completed router tests
+    RUN(test_first_completed_router_takes_first_response);
+    RUN(test_first_completed_router_hedges_after_delay);
+    RUN(test_first_completed_router_cancel_outstanding);
+    RUN(test_first_completed_router_destroyed_while_responses_arrive);
+
+    // Elastic pool tests
+    RUN(test_elastic_pool_grows_on_backlog_and_shrinks_when_idle);
+    RUN(test_elastic_pool_grows_on_latency);
+    RUN(test_elastic_pool_resizes_on_owner_actor);
 
     // Common interface tests
     RUN(test_router_interface_broadcast);
@@ -0,0 +1,193 @@
+/**
+ * Unit tests for scatter-gather requests: all / first / quorum completion, partial results
+ * on timeout, unreachable targets and use from inside an actor.
+ */
+#include "external/actor_system.h"
+#include "external/context.h"
+#include "external/future.h"
+#include "external/props.h"
+#include "external/scatter_gather.h"
+#include "internal/actor/root_context.h"
+#include "tests/test_common.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace protoactor;
+using namespace protoactor::test;
+
+namespace {
+
+struct Query {
+    static constexpr uint64_t MAGIC = 0x5343415454455251ULL;
+    uint64_t magic = MAGIC;
+    int value;
+    explicit Query(int v) : value(v) {}
+};
+
+const Query* AsQuery(const std::shared_ptr<void>& msg) {
+    if (!msg) {
+        return nullptr;
+    }
+    auto q = static_cast<const Query*>(msg.get());
+    return q->magic == Query::MAGIC ? q : nullptr;
+}
+
+// Replies with value * factor
+std::shared_ptr<Props> ShardProps(int factor) {
+    return Props::FromFunc([factor](std::shared_ptr<Context> ctx) {
+        auto q = AsQuery(ctx->Message());
+        if (q) {
+            ctx->Respond(std::make_shared<Query>(q->value * factor));
+        }
+    });
+}
+
+std::shared_ptr<Props> SilentProps() {
+    return Props::FromFunc([](std::shared_ptr<Context>) {});
+}
+
+} // namespace
+
+static bool test_gather_all_correlates_responses() {
+    auto system = ActorSystem::New();
+    auto root = system->GetRoot();
+    std::vector<std::shared_ptr<PID>> shards;
+    for (int i = 1; i <= 50; ++i) {
+        shards.push_back(root->Spawn(ShardProps(i)));
+    }
+    auto future = root->RequestScatterGather(
+        shards, std::make_shared<Query>(2), std::chrono::milliseconds(2000), GatherMode::All, 0);
+    auto [res, err] = future->Result();
+    ASSERT_TRUE(!err);
+    auto result = std::static_pointer_cast<ScatterGatherResult>(res);
+    ASSERT_EQ(result->received, static_cast<size_t>(50));
+    ASSERT_EQ(result->responses.size(), static_cast<size_t>(50));
+    for (int i = 0; i < 50; ++i) {
+        auto reply = AsQuery(result->responses[i]);
+        ASSERT_TRUE(reply != nullptr);
+        ASSERT_EQ(reply->value, 2 * (i + 1));
+    }
+    system->Shutdown();
+    return true;
+}
+
+static bool test_gather_first_completes_on_one_response() {
+    auto system = ActorSystem::New();
+    auto root = system->GetRoot();
+    std::vector<std::shared_ptr<PID>> targets = {
+        root->Spawn(SilentProps()), root->Spawn(ShardProps(3)), root->Spawn(SilentProps())};
+    auto future = root->RequestScatterGather(
+        targets, std::make_shared<Query>(5), std::chrono::milliseconds(2000), GatherMode::First, 0);
+    auto [res, err] = future->Result();
+    ASSERT_TRUE(!err);
+    auto result = std::static_pointer_cast<ScatterGatherResult>(res);
+    ASSERT_EQ(result->received, static_cast<size_t>(1));
+    ASSERT_TRUE(AsQuery(result->responses[1]) != nullptr);
+    ASSERT_EQ(AsQuery(result->responses[1])->value, 15);
+    system->Shutdown();
+    return true;
+}
+
+static bool test_gather_quorum() {
+    auto system = ActorSystem::New();
+    auto root = system->GetRoot();
+    std::vector<std::shared_ptr<PID>> targets = {
+        root->Spawn(ShardProps(1)), root->Spawn(ShardProps(1)), root->Spawn(SilentProps())};
+    auto future = root->RequestScatterGather(
+        targets, std::make_shared<Query>(1), std::chrono::milliseconds(2000), GatherMode::Quorum, 2);
+    auto [res, err] = future->Result();
+    ASSERT_TRUE(!err);
+    auto result = std::static_pointer_cast<ScatterGatherResult>(res);
+    ASSERT_EQ(result->received, static_cast<size_t>(2));
+    ASSERT_TRUE(result->responses[2] == nullptr);
+    system->Shutdown();
+    return true;
+}
+
+static bool test_gather_timeout_returns_partial_result() {
+    auto system = ActorSystem::New();
+    auto root = system->GetRoot();
+    std::vector<std::shared_ptr<PID>> targets = {root->Spawn(ShardProps(1)), root->Spawn(SilentProps())};
+    auto future = root->RequestScatterGather(
+        targets, std::make_shared<Query>(7), std::chrono::milliseconds(50), GatherMode::All, 0);
+    auto [res, err] = future->Result();
+    ASSERT_TRUE(err == std::make_error_code(std::errc::timed_out));
+    auto result = std::static_pointer_cast<ScatterGatherResult>(res);
+    ASSERT_TRUE(result != nullptr);
+    ASSERT_EQ(result->received, static_cast<size_t>(1));
+    ASSERT_TRUE(AsQuery(result->responses[0]) != nullptr);
+    system->Shutdown();
+    return true;
+}
+
+static bool test_gather_unreachable_targets_fail_fast() {
+    auto system = ActorSystem::New();
+    auto root = system->GetRoot();
+    std::vector<std::shared_ptr<PID>> targets = {
+        root->Spawn(SilentProps()), system->NewLocalPID("missing-1"), system->NewLocalPID("missing-2")};
+    auto start = std::chrono::steady_clock::now();
+    auto future = root->RequestScatterGather(
+        targets, std::make_shared<Query>(1), std::chrono::milliseconds(5000), GatherMode::Quorum, 2);
+    auto [res, err] = future->Result();
+    ASSERT_TRUE(err == std::make_error_code(std::errc::no_such_process));
+    ASSERT_TRUE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(1000));
+    auto result = std::static_pointer_cast<ScatterGatherResult>(res);
+    ASSERT_EQ(result->unreachable, static_cast<size_t>(2));
+    system->Shutdown();
+    return true;
+}
+
+static bool test_gather_from_actor_with_reenter() {
+    auto system = ActorSystem::New();
+    auto root = system->GetRoot();
+    std::vector<std::shared_ptr<PID>> shards;
+    for (int i = 0; i < 8; ++i) {
+        shards.push_back(root->Spawn(ShardProps(1)));
+    }
+    std::atomic<int> sum(-1);
+    auto coordinator = root->Spawn(Props::FromFunc([shards, &sum](std::shared_ptr<Context> ctx) {
+        auto q = AsQuery(ctx->Message());
+        if (!q) {
+            return;
+        }
+        auto future = ctx->RequestScatterGather(
+            shards, std::make_shared<Query>(q->value), std::chrono::milliseconds(2000), GatherMode::All, 0);
+        ctx->ReenterAfter(future, [&sum](std::shared_ptr<void> res, std::error_code err) {
+            if (err) {
+                return;
+            }
+            int total = 0;
+            for (auto& r : std::static_pointer_cast<ScatterGatherResult>(res)->responses) {
+                total += AsQuery(r) ? AsQuery(r)->value : 0;
+            }
+            sum.store(total);
+        });
+    }));
+    root->Send(coordinator, std::make_shared<Query>(3));
+    for (int i = 0; i < 200 && sum.load() < 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(sum.load(), 24);
+    system->Shutdown();
+    return true;
+}
+
+int main() {
+    std::fprintf(stdout, "Scatter-gather unit tests (module:scatter_gather)\n");
+    int failed = 0;
+#define RUN(name) if (!run_test(#name, name)) ++failed
+    RUN(test_gather_all_correlates_responses);
+    RUN(test_gather_first_completes_on_one_response);
+    RUN(test_gather_quorum);
+    RUN(test_gather_timeout_returns_partial_result);
+    RUN(test_gather_unreachable_targets_fail_fast);
+    RUN(test_gather_from_actor_with_reenter);
+#undef RUN
+    std::fprintf(stdout, "\nTotal: %d failed\n", failed);
+    return failed == 0 ? 0 : 1;
+}
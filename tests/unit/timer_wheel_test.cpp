@@ -0,0 +1,196 @@
+/**
+ * Unit tests for the shared timer wheel and wheel-based actor receive timeouts.
+ */
+#include "internal/scheduler/timer_wheel.h"
+#include "external/actor_system.h"
+#include "external/context.h"
+#include "external/messages.h"
+#include "external/props.h"
+#include "tests/test_common.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+using namespace protoactor;
+using namespace protoactor::test;
+
+namespace {
+
+struct Tick {
+    static constexpr uint64_t MAGIC = 0x5449434B4D534731ULL;
+    uint64_t magic = MAGIC;
+};
+
+bool IsTick(const std::shared_ptr<void>& msg) {
+    return msg && static_cast<const Tick*>(msg.get())->magic == Tick::MAGIC;
+}
+
+bool WaitFor(const std::atomic<int>& value, int expected, int max_ms = 2000) {
+    for (int i = 0; i < max_ms / 5; ++i) {
+        if (value.load() >= expected) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return value.load() >= expected;
+}
+
+struct TimeoutState {
+    std::atomic<int> timeouts{0};
+    std::atomic<int> ticks{0};
+};
+
+// Sets a receive timeout on start and counts ReceiveTimeout deliveries
+std::shared_ptr<Props> TimeoutProps(TimeoutState* state, std::chrono::milliseconds timeout) {
+    return Props::FromFunc([state, timeout](std::shared_ptr<Context> ctx) {
+        auto msg = ctx->Message();
+        if (IsTick(msg)) {
+            state->ticks.fetch_add(1);
+            return;
+        }
+        auto sys = std::static_pointer_cast<SystemMessage>(msg);
+        if (std::dynamic_pointer_cast<Started>(sys)) {
+            ctx->SetReceiveTimeout(timeout);
+        } else if (std::dynamic_pointer_cast<ReceiveTimeout>(sys)) {
+            state->timeouts.fetch_add(1);
+        }
+    });
+}
+
+} // namespace
+
+static bool test_wheel_fires_callbacks_in_order() {
+    auto wheel = std::make_shared<scheduler::TimerWheel>(std::chrono::milliseconds(5), 8);
+    std::atomic<int> first(0);
+    std::atomic<int> second(0);
+    auto now = wheel->CurrentTick();
+    wheel->ScheduleAt(now + 4, [&]() { second.store(first.load() + 1); });
+    wheel->ScheduleAt(now + 2, [&]() { first.store(1); });
+    ASSERT_TRUE(WaitFor(second, 1));
+    ASSERT_EQ(second.load(), 2);
+    wheel->Stop();
+    return true;
+}
+
+static bool test_wheel_handles_deadlines_beyond_one_revolution() {
+    auto wheel = std::make_shared<scheduler::TimerWheel>(std::chrono::milliseconds(2), 4);
+    std::atomic<int> fired(0);
+    std::atomic<uint64_t> fired_at(0);
+    auto target = wheel->CurrentTick() + 20;
+    wheel->ScheduleAt(target, [&]() {
+        fired_at.store(wheel->CurrentTick());
+        fired.store(1);
+    });
+    ASSERT_TRUE(WaitFor(fired, 1));
+    ASSERT_GE(fired_at.load(), target);
+    wheel->Stop();
+    return true;
+}
+
+static bool test_wheel_ticks_for_rounds_up() {
+    auto wheel = std::make_shared<scheduler::TimerWheel>(std::chrono::milliseconds(10), 16);
+    ASSERT_EQ(wheel->TicksFor(std::chrono::milliseconds(1)), static_cast<uint64_t>(1));
+    ASSERT_EQ(wheel->TicksFor(std::chrono::milliseconds(10)), static_cast<uint64_t>(1));
+    ASSERT_EQ(wheel->TicksFor(std::chrono::milliseconds(11)), static_cast<uint64_t>(2));
+    return true;
+}
+
+static bool test_receive_timeout_fires_when_idle() {
+    auto system = ActorSystem::New();
+    TimeoutState state;
+    system->GetRoot()->Spawn(TimeoutProps(&state, std::chrono::milliseconds(50)));
+    ASSERT_TRUE(WaitFor(state.timeouts, 1));
+    // Fires once per idle period, not repeatedly
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    ASSERT_EQ(state.timeouts.load(), 1);
+    system->Shutdown();
+    return true;
+}
+
+static bool test_receive_timeout_is_pushed_out_by_messages() {
+    auto system = ActorSystem::New();
+    TimeoutState state;
+    auto pid = system->GetRoot()->Spawn(TimeoutProps(&state, std::chrono::milliseconds(150)));
+    for (int i = 0; i < 20; ++i) {
+        system->GetRoot()->Send(pid, std::make_shared<Tick>());
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    ASSERT_EQ(state.ticks.load(), 20);
+    ASSERT_EQ(state.timeouts.load(), 0);
+    ASSERT_TRUE(WaitFor(state.timeouts, 1));
+    system->Shutdown();
+    return true;
+}
+
+static bool test_cancel_receive_timeout() {
+    auto system = ActorSystem::New();
+    std::atomic<int> timeouts(0);
+    auto pid = system->GetRoot()->Spawn(Props::FromFunc([&timeouts](std::shared_ptr<Context> ctx) {
+        auto msg = ctx->Message();
+        if (IsTick(msg)) {
+            ctx->CancelReceiveTimeout();
+            return;
+        }
+        auto sys = std::static_pointer_cast<SystemMessage>(msg);
+        if (std::dynamic_pointer_cast<Started>(sys)) {
+            ctx->SetReceiveTimeout(std::chrono::milliseconds(60));
+        } else if (std::dynamic_pointer_cast<ReceiveTimeout>(sys)) {
+            timeouts.fetch_add(1);
+        }
+    }));
+    system->GetRoot()->Send(pid, std::make_shared<Tick>());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    ASSERT_EQ(timeouts.load(), 0);
+    system->Shutdown();
+    return true;
+}
+
+static bool test_changing_receive_timeout_reuses_wheel_entry() {
+    auto system = ActorSystem::New();
+    std::atomic<int> ticks(0);
+    std::atomic<int> timeouts(0);
+    // Switches between two timeouts on every message
+    auto pid = system->GetRoot()->Spawn(Props::FromFunc([&](std::shared_ptr<Context> ctx) {
+        auto msg = ctx->Message();
+        if (IsTick(msg)) {
+            int n = ticks.fetch_add(1);
+            ctx->SetReceiveTimeout(std::chrono::milliseconds(n % 2 == 0 ? 300 : 200));
+            return;
+        }
+        if (std::dynamic_pointer_cast<ReceiveTimeout>(std::static_pointer_cast<SystemMessage>(msg))) {
+            timeouts.fetch_add(1);
+        }
+    }));
+    auto wheel = system->GetTimerWheel();
+    auto before = wheel->Pending();
+    for (int i = 0; i < 2000; ++i) {
+        system->GetRoot()->Send(pid, std::make_shared<Tick>());
+    }
+    ASSERT_TRUE(WaitFor(ticks, 2000));
+    // One entry follows the deadline instead of one per change
+    ASSERT_TRUE(wheel->Pending() < before + 10);
+    ASSERT_TRUE(WaitFor(timeouts, 1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    ASSERT_EQ(timeouts.load(), 1);
+    system->Shutdown();
+    return true;
+}
+
+int main() {
+    std::fprintf(stdout, "Timer wheel unit tests (module:scheduler)\n");
+    int failed = 0;
+#define RUN(name) if (!run_test(#name, name)) ++failed
+    RUN(test_wheel_fires_callbacks_in_order);
+    RUN(test_wheel_handles_deadlines_beyond_one_revolution);
+    RUN(test_wheel_ticks_for_rounds_up);
+    RUN(test_receive_timeout_fires_when_idle);
+    RUN(test_receive_timeout_is_pushed_out_by_messages);
+    RUN(test_cancel_receive_timeout);
+    RUN(test_changing_receive_timeout_reuses_wheel_entry);
+#undef RUN
+    std::fprintf(stdout, "\nTotal: %d failed\n", failed);
+    return failed == 0 ? 0 : 1;
+}